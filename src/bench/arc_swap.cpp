@@ -0,0 +1,77 @@
+// Reader throughput of `ArcSwap` against `Mutex<Arc<T>>` while a writer keeps replacing the value
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <rstd/prelude.hpp>
+#include "bench.hpp"
+
+using namespace rstd;
+
+
+static const size_t LOADS_PER_THREAD = 1000000;
+
+struct Config {
+    uint64_t version;
+    uint64_t limits[7];
+};
+
+static Config make_config(uint64_t version) {
+    Config c;
+    c.version = version;
+    for (uint64_t &l : c.limits) {
+        l = version;
+    }
+    return c;
+}
+
+// Runs `readers` threads that load the value and one writer that replaces it every 100 us.
+// Returns the reader throughput in millions of loads per second.
+template <typename L, typename S>
+static double run(size_t readers, L load, S store) {
+    std::atomic<size_t> finished(0);
+    std::atomic<uint64_t> sink(0);
+    double t = bench::run_threads(readers + 1, [&](size_t i) {
+        if (i == readers) {
+            for (uint64_t v = 1; finished.load() < readers; ++v) {
+                store(v);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            return;
+        }
+        uint64_t acc = 0;
+        for (size_t j = 0; j < LOADS_PER_THREAD; ++j) {
+            acc += load();
+        }
+        sink += acc;
+        finished += 1;
+    });
+    return double(readers * LOADS_PER_THREAD) / t * 1e-6;
+}
+
+void bench::arc_swap() {
+    for (size_t readers : {1, 4, 16, 64}) {
+        ArcSwap<Config> swap(make_config(0));
+        double lock_free = run(readers,
+            [&]() { return swap.load()->version; },
+            [&](uint64_t v) { swap.store(make_config(v)); }
+        );
+
+        Mutex<Arc<Config>> locked(Arc<Config>(make_config(0)));
+        double mutex = run(readers,
+            [&]() {
+                Arc<Config> c = *locked.lock();
+                return c->version;
+            },
+            [&](uint64_t v) {
+                Arc<Config> c(make_config(v));
+                std::swap(*locked.lock(), c);
+            }
+        );
+        println_(
+            "{} readers + 1 writer: ArcSwap {} Mloads/s, Mutex<Arc> {} Mloads/s",
+            readers, lock_free, mutex
+        );
+    }
+}
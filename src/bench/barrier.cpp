@@ -0,0 +1,27 @@
+// Round-trip latency of `Barrier`: time for all threads to pass it once
+
+#include <atomic>
+#include <cstdint>
+#include <rstd/prelude.hpp>
+#include "bench.hpp"
+
+using namespace rstd;
+
+
+static const size_t ROUNDS = 2000;
+
+void bench::barrier() {
+    for (size_t threads : {8, 32, 64}) {
+        Barrier phase((uint32_t)threads);
+        std::atomic<size_t> leaders(0);
+        double t = bench::run_threads(threads, [&](size_t) {
+            for (size_t r = 0; r < ROUNDS; ++r) {
+                if (phase.wait().is_leader()) {
+                    leaders += 1;
+                }
+            }
+        });
+        assert_eq_(leaders.load(), ROUNDS);
+        println_("{} threads: {} us/round", threads, t / double(ROUNDS) * 1e6);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Helpers shared by the benchmark suites of `rstd_bench`
+
+#include <cstddef>
+#include <vector>
+#include <rstd/prelude.hpp>
+
+
+namespace bench {
+
+inline double secs_since(rstd::time::Instant start) {
+    rstd::time::Duration d = rstd::time::Instant::now() - start;
+    return double(d.as_nanos()) * 1e-9;
+}
+
+// Runs `f(i)` on `n` threads released at the same moment. Returns the wall time of the run in seconds.
+template <typename F>
+double run_threads(size_t n, F f) {
+    rstd::Barrier start(uint32_t(n + 1));
+    std::vector<rstd::JoinHandle<>> workers;
+    for (size_t i = 0; i < n; ++i) {
+        workers.push_back(rstd::thread::spawn([&start, &f, i]() {
+            start.wait();
+            f(i);
+        }));
+    }
+    start.wait();
+    rstd::time::Instant begin = rstd::time::Instant::now();
+    for (auto &w : workers) {
+        w.join().unwrap();
+    }
+    return secs_since(begin);
+}
+
+void hash();
+void concurrent_hash_map();
+void arc_swap();
+void barrier();
+void executor();
+
+} // namespace bench
@@ -0,0 +1,93 @@
+// Scaling of `ConcurrentHashMap` against a single `Mutex` around `std::unordered_map`
+// on a zipfian workload of 90% reads and 10% upserts
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <rstd/prelude.hpp>
+#include "bench.hpp"
+
+using namespace rstd;
+
+
+static const uint64_t KEYS = uint64_t(1) << 16;
+static const size_t SAMPLES = size_t(1) << 20;
+static const size_t OPS_PER_THREAD = 200000;
+
+// Keys drawn from the zipfian distribution with exponent 0.99, so a few keys are very hot
+static std::vector<uint64_t> zipf_samples() {
+    std::vector<double> cdf(KEYS);
+    double sum = 0.0;
+    for (uint64_t k = 0; k < KEYS; ++k) {
+        sum += 1.0 / std::pow(double(k + 1), 0.99);
+        cdf[k] = sum;
+    }
+    std::vector<uint64_t> samples(SAMPLES);
+    uint64_t x = 0x9e3779b97f4a7c15;
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        // xorshift64
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        double u = double(x >> 11) * 0x1.0p-53 * sum;
+        size_t lo = 0, hi = KEYS - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        // Scatter hot keys over the shards
+        samples[i] = lo * 0x9e3779b97f4a7c15;
+    }
+    return samples;
+}
+
+// Runs the workload and returns the throughput in millions of operations per second
+template <typename G, typename U>
+static double run(size_t threads, const std::vector<uint64_t> &samples, G get, U upsert) {
+    std::atomic<uint64_t> sink(0);
+    double t = bench::run_threads(threads, [&](size_t i) {
+        uint64_t acc = 0;
+        size_t pos = i * 7919;
+        for (size_t j = 0; j < OPS_PER_THREAD; ++j) {
+            uint64_t key = samples[(pos + j) & (SAMPLES - 1)];
+            if (j % 10 == 0) {
+                upsert(key);
+            } else {
+                acc += get(key);
+            }
+        }
+        sink += acc;
+    });
+    return double(threads * OPS_PER_THREAD) / t * 1e-6;
+}
+
+void bench::concurrent_hash_map() {
+    std::vector<uint64_t> samples = zipf_samples();
+    for (size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+        ConcurrentHashMap<uint64_t, uint64_t> map;
+        Mutex<std::unordered_map<uint64_t, uint64_t>> locked;
+        for (uint64_t k = 0; k < KEYS; ++k) {
+            map.insert(k * 0x9e3779b97f4a7c15, k);
+            (*locked.lock())[k * 0x9e3779b97f4a7c15] = k;
+        }
+
+        double sharded = run(threads, samples,
+            [&](uint64_t key) { return *map.get(key).unwrap(); },
+            [&](uint64_t key) { *map.entry(key).or_insert(0) += 1; }
+        );
+        double single = run(threads, samples,
+            [&](uint64_t key) { return locked.lock()->find(key)->second; },
+            [&](uint64_t key) { (*locked.lock())[key] += 1; }
+        );
+        println_(
+            "{} threads: ConcurrentHashMap {} Mops/s, Mutex<unordered_map> {} Mops/s",
+            threads, sharded, single
+        );
+    }
+}
@@ -0,0 +1,110 @@
+// Cost of spawning and switching executor tasks against OS threads spawned with `thread::spawn`
+
+#include <cstdint>
+#include <vector>
+#include <rstd/prelude.hpp>
+#include <rstd/future/executor.hpp>
+#include "bench.hpp"
+
+using namespace rstd;
+using namespace rstd::time;
+using bench::secs_since;
+
+
+// Yields to the executor `n` times before completing
+class Yields final : public Future<size_t, Yields> {
+private:
+    size_t left;
+public:
+    explicit Yields(size_t n) : left(n) {}
+    Poll<size_t> poll(Context &cx) {
+        if (left == 0) {
+            return Poll<size_t>::Ready(size_t(0));
+        }
+        left -= 1;
+        cx.waker().wake();
+        return rstd::Pending();
+    }
+};
+
+static void report(const char *name, double secs, size_t n) {
+    println_("{}: {} ns", name, secs / double(n) * 1e9);
+}
+
+static void spawn_cost() {
+    const size_t threads = 2000, tasks = 200000;
+
+    Instant start = Instant::now();
+    for (size_t i = 0; i < threads; ++i) {
+        thread::spawn([]() {}).join().unwrap();
+    }
+    report("thread::spawn + join", secs_since(start), threads);
+
+    start = Instant::now();
+    {
+        executor::LocalPool pool;
+        std::vector<executor::JoinHandle<size_t>> handles;
+        handles.reserve(tasks);
+        for (size_t i = 0; i < tasks; ++i) {
+            handles.push_back(pool.spawn(future::ready(size_t(i))));
+        }
+        pool.run();
+        for (auto &h : handles) {
+            h.join().unwrap();
+        }
+    }
+    report("LocalPool spawn + join", secs_since(start), tasks);
+
+    executor::ThreadPool pool(4);
+    start = Instant::now();
+    std::vector<executor::JoinHandle<size_t>> handles;
+    handles.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) {
+        handles.push_back(pool.spawn(future::ready(size_t(i))));
+    }
+    for (auto &h : handles) {
+        h.join().unwrap();
+    }
+    report("ThreadPool(4) spawn + join", secs_since(start), tasks);
+}
+
+static void switch_cost() {
+    const size_t switches = 1000000, round_trips = 20000;
+
+    Instant start = Instant::now();
+    {
+        executor::LocalPool pool;
+        auto handle = pool.spawn(Yields(switches));
+        pool.run();
+        handle.join().unwrap();
+    }
+    report("LocalPool task yield", secs_since(start), switches);
+
+    start = Instant::now();
+    {
+        executor::ThreadPool pool(4);
+        pool.spawn(Yields(switches)).join().unwrap();
+    }
+    report("ThreadPool(4) task yield", secs_since(start), switches);
+
+    // Two threads hand control to each other
+    Semaphore ping(0), pong(0);
+    start = Instant::now();
+    auto peer = thread::spawn([&]() {
+        for (size_t i = 0; i < round_trips; ++i) {
+            ping.acquire();
+            pong.release();
+        }
+    });
+    for (size_t i = 0; i < round_trips; ++i) {
+        ping.release();
+        pong.acquire();
+    }
+    peer.join().unwrap();
+    report("thread switch", secs_since(start), 2 * round_trips);
+}
+
+void bench::executor() {
+    spawn_cost();
+    switch_cost();
+}
@@ -0,0 +1,75 @@
+// Throughput of the hashers for words, byte strings and hash map keys
+
+#include <cstdint>
+#include <vector>
+#include <rstd/prelude.hpp>
+#include "bench.hpp"
+
+using namespace rstd;
+using namespace rstd::time;
+using bench::secs_since;
+
+
+// Each key depends on the previous hash, so this is the latency of a single hash
+template <typename H>
+static void bench_words(const char *name) {
+    const uint64_t n = 50000000;
+    uint64_t acc = 0;
+    Instant start = Instant::now();
+    for (uint64_t i = 0; i < n; ++i) {
+        H h;
+        h.write_u64(i ^ acc);
+        acc += h.finish();
+    }
+    double t = secs_since(start);
+    println_("{} u64: {} ns/hash ({})", name, t / double(n) * 1e9, acc & 1);
+}
+
+template <typename H>
+static void bench_bytes(const char *name, size_t len) {
+    std::vector<uint8_t> buf(len, 7);
+    size_t reps = (size_t(1) << 30) / len;
+    uint64_t acc = 0;
+    Instant start = Instant::now();
+    for (size_t r = 0; r < reps; ++r) {
+        buf[0] = uint8_t(acc);
+        H h;
+        h.write(buf.data(), len);
+        acc += h.finish();
+    }
+    double t = secs_since(start);
+    println_("{} {} B: {} GB/s ({})", name, len, double(reps * len) / t * 1e-9, acc & 1);
+}
+
+// Keys differ only in high bits, which is bad for weak hashes
+template <typename H>
+static void bench_map(const char *name) {
+    const uint64_t n = uint64_t(1) << 20;
+    Instant start = Instant::now();
+    HashMap<uint64_t, uint64_t, H> map;
+    for (uint64_t i = 0; i < n; ++i) {
+        map.insert(i << 12, i);
+    }
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        sum += *map.get(i << 12).unwrap();
+    }
+    double t = secs_since(start);
+    println_("{} HashMap insert+get: {} ns/key ({})", name, t / double(n) * 1e9, sum & 1);
+}
+
+template <typename H>
+static void bench_all(const char *name) {
+    bench_words<H>(name);
+    for (size_t len : {size_t(8), size_t(64), size_t(4096)}) {
+        bench_bytes<H>(name, len);
+    }
+    bench_map<H>(name);
+}
+
+void bench::hash() {
+    bench_all<FxHasher>("FxHasher");
+    bench_all<FoldHasher>("FoldHasher");
+    bench_all<WyHasher>("WyHasher");
+    bench_all<SipHasher13>("SipHasher13");
+}
@@ -0,0 +1,49 @@
+// Benchmarks built as `rstd_bench` with optimizations.
+// Runs the suites named in the arguments, or all of them if there are none.
+
+#include <cstring>
+#include <rstd/prelude.hpp>
+#include "bench.hpp"
+
+
+struct Suite {
+    const char *name;
+    void (*run)();
+};
+
+static const Suite SUITES[] = {
+    {"hash", bench::hash},
+    {"concurrent_hash_map", bench::concurrent_hash_map},
+    {"arc_swap", bench::arc_swap},
+    {"barrier", bench::barrier},
+    {"executor", bench::executor},
+};
+
+static bool selected(int argc, char **argv, const char *name) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return argc <= 1;
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        bool known = false;
+        for (const Suite &s : SUITES) {
+            known = known || strcmp(argv[i], s.name) == 0;
+        }
+        if (!known) {
+            eprintln_("Unknown benchmark suite: {}", argv[i]);
+            return 1;
+        }
+    }
+    for (const Suite &s : SUITES) {
+        if (selected(argc, argv, s.name)) {
+            println_("# {}", s.name);
+            s.run();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "clock.hpp"
+
+#include <time.h>
+#if defined(__i386__) || defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+
+using namespace rcore;
+
+// Time to measure the counter frequency
+static const uint64_t CALIBRATION_NS = 10000000;
+
+uint64_t clock::monotonic_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+// Checks that the counter ticks at constant rate regardless of CPU frequency and sleep states
+static bool counter_is_stable() {
+#if defined(__i386__) || defined(__x86_64__)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    // Invariant TSC
+    return (edx & (1 << 8)) != 0;
+#elif defined(__aarch64__)
+    // Generic timer always has constant frequency
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Reads the counter and monotonic time as close to each other as possible
+static void read_pair(uint64_t &counter, uint64_t &ns) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 8; ++i) {
+        uint64_t c0 = clock::read_counter();
+        uint64_t t = clock::monotonic_ns();
+        uint64_t c1 = clock::read_counter();
+        if (c1 - c0 < best) {
+            best = c1 - c0;
+            counter = c0 + (c1 - c0) / 2;
+            ns = t;
+        }
+    }
+}
+
+static clock::Calibration calibrate() {
+    clock::Calibration c;
+    if (!counter_is_stable()) {
+        return c;
+    }
+    uint64_t c0 = 0, t0 = 0, c1 = 0, t1 = 0;
+    read_pair(c0, t0);
+    timespec ts{0, long(CALIBRATION_NS)};
+    nanosleep(&ts, nullptr);
+    read_pair(c1, t1);
+    if (c1 <= c0 || t1 <= t0) {
+        return c;
+    }
+    c.hardware = true;
+    c.base_counter = c1;
+    c.base_ns = t1;
+    c.mult = uint64_t(double(t1 - t0) * 4294967296.0 / double(c1 - c0));
+    return c;
+}
+
+const clock::Calibration &clock::calibration() {
+    static const Calibration c = calibrate();
+    return c;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+
+namespace rcore {
+
+// Cheap timestamps from the hardware cycle counter calibrated against `CLOCK_MONOTONIC`.
+namespace clock {
+
+// Reads the raw hardware counter. Returns zero if there is no supported counter.
+inline uint64_t read_counter() {
+#if defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+struct Calibration {
+    // `false` if the counter is missing or doesn't tick at constant rate,
+    // in that case `CLOCK_MONOTONIC` is used instead
+    bool hardware = false;
+    uint64_t base_counter = 0;
+    uint64_t base_ns = 0;
+    // Nanoseconds per counter tick in 32.32 fixed point
+    uint64_t mult = 0;
+};
+
+// Calibrates the counter on the first call, it takes a few milliseconds
+const Calibration &calibration();
+
+uint64_t monotonic_ns();
+
+// Nanoseconds on the `CLOCK_MONOTONIC` scale.
+// The counter may be read before the calibration base, so the delta is signed.
+inline uint64_t counter_to_ns(const Calibration &c, uint64_t counter) {
+    int64_t delta = int64_t(counter - c.base_counter);
+#ifdef __SIZEOF_INT128__
+    int64_t offset = int64_t(((__int128)delta * (__int128)c.mult) >> 32);
+#else
+    int64_t offset = int64_t(double(delta) * double(c.mult) / 4294967296.0);
+#endif
+    return c.base_ns + uint64_t(offset);
+}
+
+inline uint64_t now_ns() {
+    const Calibration &c = calibration();
+    if (c.hardware) {
+        return counter_to_ns(c, read_counter());
+    } else {
+        return monotonic_ns();
+    }
+}
+
+} // namespace clock
+
+} // namespace rcore
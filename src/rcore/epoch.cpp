@@ -0,0 +1,192 @@
+#include "epoch.hpp"
+
+#include <pthread.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "thread.hpp"
+
+
+using namespace rcore;
+using namespace rcore::epoch;
+
+// Amount of pins after which the thread tries to collect garbage
+static const size_t PINS_BETWEEN_COLLECT = 128;
+// Maximum amount of deferred items in thread-local bag before collection
+static const size_t MAX_BAG_SIZE = 64;
+
+namespace {
+
+struct Deferred {
+    void (*func)(void *);
+    void *data;
+    uint64_t epoch;
+
+    void call() {
+        func(data);
+    }
+};
+
+struct Global {
+    std::atomic<uint64_t> epoch{0};
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    std::vector<Local *> locals;
+    // Garbage left by exited threads
+    std::vector<Deferred> orphans;
+};
+
+// Never destroyed because threads may outlive static destructors
+Global &global() {
+    static Global *g = new Global();
+    return *g;
+}
+
+// Moves all items that are safe to release at `epoch` from `bag` to `out`
+void extract_expired(std::vector<Deferred> &bag, uint64_t epoch, std::vector<Deferred> &out) {
+    auto it = std::partition(bag.begin(), bag.end(), [epoch](const Deferred &d) {
+        return d.epoch + 2 > epoch;
+    });
+    out.insert(out.end(), it, bag.end());
+    bag.erase(it, bag.end());
+}
+
+} // namespace
+
+class rcore::epoch::Local {
+public:
+    // Pinned epoch shifted left by one, lowest bit is set when pinned
+    std::atomic<uint64_t> state{0};
+    size_t guard_count = 0;
+    size_t pin_count = 0;
+    std::vector<Deferred> bag;
+
+    uint64_t epoch() const {
+        return state.load(std::memory_order_relaxed) >> 1;
+    }
+
+    void collect();
+};
+
+// Advances the global epoch if all pinned threads have observed the current one.
+// Returns the resulting global epoch.
+static uint64_t try_advance() {
+    Global &g = global();
+    uint64_t e = g.epoch.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pthread_mutex_trylock(&g.lock) != 0) {
+        return e;
+    }
+    for (Local *l : g.locals) {
+        uint64_t s = l->state.load(std::memory_order_relaxed);
+        if ((s & 1) && (s >> 1) != e) {
+            pthread_mutex_unlock(&g.lock);
+            return e;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    e += 1;
+    g.epoch.store(e, std::memory_order_release);
+
+    std::vector<Deferred> expired;
+    extract_expired(g.orphans, e, expired);
+    pthread_mutex_unlock(&g.lock);
+
+    for (Deferred &d : expired) {
+        d.call();
+    }
+    return e;
+}
+
+void Local::collect() {
+    uint64_t e = try_advance();
+    std::vector<Deferred> expired;
+    extract_expired(bag, e, expired);
+    for (Deferred &d : expired) {
+        d.call();
+    }
+}
+
+namespace {
+
+// Owns the registration of current thread
+struct LocalHandle {
+    Local *local;
+
+    LocalHandle() : local(new Local()) {
+        Global &g = global();
+        pthread_mutex_lock(&g.lock);
+        g.locals.push_back(local);
+        pthread_mutex_unlock(&g.lock);
+    }
+    LocalHandle(LocalHandle &&other) : local(other.local) {
+        other.local = nullptr;
+    }
+    LocalHandle(const LocalHandle &) = delete;
+    ~LocalHandle() {
+        if (local == nullptr) {
+            return;
+        }
+        Global &g = global();
+        pthread_mutex_lock(&g.lock);
+        g.locals.erase(std::find(g.locals.begin(), g.locals.end(), local));
+        g.orphans.insert(g.orphans.end(), local->bag.begin(), local->bag.end());
+        pthread_mutex_unlock(&g.lock);
+        delete local;
+    }
+};
+
+} // namespace
+
+static_thread_local_(LocalHandle, local_handle) {
+    return LocalHandle();
+}
+
+Guard::Guard(Local *l) : local(l) {}
+
+Guard::~Guard() {
+    if (local != nullptr) {
+        local->guard_count -= 1;
+        if (local->guard_count == 0) {
+            local->state.fetch_and(~uint64_t(1), std::memory_order_release);
+        }
+    }
+}
+
+void Guard::defer_raw(void (*func)(void *), void *data) const {
+    // The pinned epoch of this thread may be one behind the global one,
+    // and a thread pinned at the global epoch could still hold the unlinked pointer.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t e = global().epoch.load(std::memory_order_relaxed);
+    local->bag.push_back(Deferred{func, data, e});
+    if (local->bag.size() >= MAX_BAG_SIZE) {
+        local->collect();
+    }
+}
+
+void Guard::flush() const {
+    local->collect();
+}
+
+Guard epoch::pin() {
+    Local *l = local_handle->local;
+    l->guard_count += 1;
+    if (l->guard_count == 1) {
+        uint64_t e = global().epoch.load(std::memory_order_relaxed);
+        l->state.store((e << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        l->pin_count += 1;
+        if (l->pin_count % PINS_BETWEEN_COLLECT == 0) {
+            l->collect();
+        }
+    }
+    return Guard(l);
+}
+
+bool epoch::is_pinned() {
+    return local_handle->local->guard_count > 0;
+}
+
+uint64_t epoch::__global_epoch() {
+    return global().epoch.load(std::memory_order_relaxed);
+}
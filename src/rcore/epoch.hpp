@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+
+
+namespace rcore {
+
+// Epoch-based memory reclamation.
+//
+// Threads enter critical sections with `pin()` and leave them when the returned `Guard` is destroyed.
+// Memory unlinked from a shared structure is passed to `Guard::defer_*` and released only
+// when every thread that could have observed it has left its critical section.
+// Each thread is registered on first `pin()` using `ThreadLocal` and unregistered on exit,
+// the garbage left by exited thread is collected by others.
+namespace epoch {
+
+class Local;
+
+class Guard final {
+private:
+    Local *local;
+
+public:
+    explicit Guard(Local *l);
+    ~Guard();
+
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+
+    Guard(Guard &&other) : local(other.local) {
+        other.local = nullptr;
+    }
+    Guard &operator=(Guard &&) = delete;
+
+    // Calls `func(data)` when it becomes safe
+    void defer_raw(void (*func)(void *), void *data) const;
+
+    template <typename F>
+    void defer(F &&f) const {
+        defer_raw([](void *p) {
+            F *func = (F *)p;
+            (*func)();
+            delete func;
+        }, (void *)new F(std::move(f)));
+    }
+    template <typename T>
+    void defer_destroy(T *ptr) const {
+        defer_raw([](void *p) {
+            delete (T *)p;
+        }, (void *)ptr);
+    }
+
+    // Tries to advance global epoch and release the garbage of current thread
+    void flush() const;
+};
+
+Guard pin();
+bool is_pinned();
+
+uint64_t __global_epoch();
+
+} // namespace epoch
+
+} // namespace rcore
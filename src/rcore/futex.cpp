@@ -0,0 +1,97 @@
+#include "futex.hpp"
+
+#include <errno.h>
+#include <time.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else // __linux__
+#include <pthread.h>
+#endif // __linux__
+
+
+using namespace rcore;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+#ifdef __linux__
+
+static long futex_call(
+    const std::atomic<uint32_t> *addr, int op, uint32_t val,
+    const timespec *timeout=nullptr
+) {
+    return syscall(SYS_futex, (const uint32_t *)addr, op, val, timeout, nullptr, 0);
+}
+
+void futex::wait(const std::atomic<uint32_t> *addr, uint32_t expected) {
+    futex_call(addr, FUTEX_WAIT_PRIVATE, expected);
+}
+bool futex::wait_for(const std::atomic<uint32_t> *addr, uint32_t expected, uint64_t timeout_ns) {
+    timespec ts;
+    ts.tv_sec = time_t(timeout_ns / 1000000000);
+    ts.tv_nsec = long(timeout_ns % 1000000000);
+    // Relative timeout
+    return !(futex_call(addr, FUTEX_WAIT_PRIVATE, expected, &ts) != 0 && errno == ETIMEDOUT);
+}
+void futex::wake_one(const std::atomic<uint32_t> *addr) {
+    futex_call(addr, FUTEX_WAKE_PRIVATE, 1);
+}
+void futex::wake_all(const std::atomic<uint32_t> *addr) {
+    futex_call(addr, FUTEX_WAKE_PRIVATE, INT32_MAX);
+}
+
+#else // __linux__
+
+namespace {
+
+struct Bucket {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+};
+const size_t BUCKET_COUNT = 64;
+Bucket buckets[BUCKET_COUNT];
+
+Bucket &bucket_of(const std::atomic<uint32_t> *addr) {
+    return buckets[((uintptr_t)addr >> 2) % BUCKET_COUNT];
+}
+
+} // namespace
+
+void futex::wait(const std::atomic<uint32_t> *addr, uint32_t expected) {
+    Bucket &b = bucket_of(addr);
+    pthread_mutex_lock(&b.mutex);
+    if (addr->load() == expected) {
+        pthread_cond_wait(&b.cond, &b.mutex);
+    }
+    pthread_mutex_unlock(&b.mutex);
+}
+bool futex::wait_for(const std::atomic<uint32_t> *addr, uint32_t expected, uint64_t timeout_ns) {
+    // Condition variable uses absolute realtime deadline
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t nsec = uint64_t(ts.tv_nsec) + timeout_ns % 1000000000;
+    ts.tv_sec += time_t(timeout_ns / 1000000000 + nsec / 1000000000);
+    ts.tv_nsec = long(nsec % 1000000000);
+
+    Bucket &b = bucket_of(addr);
+    bool woken = true;
+    pthread_mutex_lock(&b.mutex);
+    if (addr->load() == expected) {
+        woken = pthread_cond_timedwait(&b.cond, &b.mutex, &ts) != ETIMEDOUT;
+    }
+    pthread_mutex_unlock(&b.mutex);
+    return woken;
+}
+void futex::wake_one(const std::atomic<uint32_t> *addr) {
+    // Bucket is shared between addresses, so we have to wake everyone
+    futex::wake_all(addr);
+}
+void futex::wake_all(const std::atomic<uint32_t> *addr) {
+    Bucket &b = bucket_of(addr);
+    pthread_mutex_lock(&b.mutex);
+    pthread_cond_broadcast(&b.cond);
+    pthread_mutex_unlock(&b.mutex);
+}
+
+#endif // __linux__
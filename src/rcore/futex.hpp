@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace rcore {
+
+// Minimal futex-like interface.
+// Uses futex syscall on Linux and hashed condition variables elsewhere.
+namespace futex {
+
+// Blocks current thread while `*addr == expected`. May wake up spuriously.
+void wait(const std::atomic<uint32_t> *addr, uint32_t expected);
+// Same as `wait` but gives up after `timeout_ns` nanoseconds. Returns `false` on timeout.
+bool wait_for(const std::atomic<uint32_t> *addr, uint32_t expected, uint64_t timeout_ns);
+// Wakes up at least one thread waiting on `addr`.
+void wake_one(const std::atomic<uint32_t> *addr);
+// Wakes up all threads waiting on `addr`.
+void wake_all(const std::atomic<uint32_t> *addr);
+
+// Amount of iterations to spin before parking the thread
+inline constexpr int SPIN_LIMIT = 100;
+
+inline void cpu_relax() {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Spins until `cond()` becomes true or spin limit is reached. Returns the last `cond()` value.
+template <typename F>
+bool spin(F cond) {
+    for (int i = 0; i < SPIN_LIMIT; ++i) {
+        if (cond()) {
+            return true;
+        }
+        cpu_relax();
+    }
+    return cond();
+}
+
+} // namespace futex
+
+} // namespace rcore
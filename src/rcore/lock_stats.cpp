@@ -0,0 +1,198 @@
+#include "lock_stats.hpp"
+
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <iomanip>
+
+
+using namespace rcore;
+using namespace rcore::lock_stats;
+
+namespace {
+
+struct Registry {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    uint64_t next_id = 0;
+    std::vector<std::weak_ptr<Stats>> entries;
+};
+
+// Never destroyed because locks may outlive static destructors
+Registry &registry() {
+    static Registry *r = new Registry();
+    return *r;
+}
+
+void update_max(std::atomic<uint64_t> &max, uint64_t value) {
+    uint64_t prev = max.load(std::memory_order_relaxed);
+    while (prev < value && !max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+}
+
+std::string display_name(const Snapshot &s) {
+    if (s.name.empty()) {
+        return "#" + std::to_string(s.id);
+    } else {
+        return s.name;
+    }
+}
+
+void write_json_string(std::ostream &o, const std::string &s) {
+    o << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            o << '\\' << c;
+        } else if ((unsigned char)c < 0x20) {
+            o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+        } else {
+            o << c;
+        }
+    }
+    o << '"';
+}
+
+} // namespace
+
+Stats::Stats(uint64_t id) : id(id) {}
+
+void Stats::record_acquire(bool was_contended, uint64_t wait_ns) {
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (was_contended) {
+        contended.fetch_add(1, std::memory_order_relaxed);
+        wait_total_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+        update_max(wait_max_ns, wait_ns);
+    }
+}
+
+void Stats::record_release(uint64_t hold_ns) {
+    hold_total_ns.fetch_add(hold_ns, std::memory_order_relaxed);
+    update_max(hold_max_ns, hold_ns);
+}
+
+void Stats::reset() {
+    acquisitions.store(0, std::memory_order_relaxed);
+    contended.store(0, std::memory_order_relaxed);
+    wait_total_ns.store(0, std::memory_order_relaxed);
+    wait_max_ns.store(0, std::memory_order_relaxed);
+    hold_total_ns.store(0, std::memory_order_relaxed);
+    hold_max_ns.store(0, std::memory_order_relaxed);
+}
+
+void Stats::set_name(const std::string &name) {
+    Registry &r = registry();
+    pthread_mutex_lock(&r.lock);
+    name_ = name;
+    pthread_mutex_unlock(&r.lock);
+}
+
+std::string Stats::name() const {
+    Registry &r = registry();
+    pthread_mutex_lock(&r.lock);
+    std::string name = name_;
+    pthread_mutex_unlock(&r.lock);
+    return name;
+}
+
+std::shared_ptr<Stats> lock_stats::register_() {
+    Registry &r = registry();
+    pthread_mutex_lock(&r.lock);
+    // Remove destroyed entries when the registry grows twice
+    size_t size = r.entries.size();
+    if (size >= 64 && (size & (size - 1)) == 0) {
+        r.entries.erase(
+            std::remove_if(r.entries.begin(), r.entries.end(), [](const std::weak_ptr<Stats> &e) {
+                return e.expired();
+            }),
+            r.entries.end()
+        );
+    }
+    auto stats = std::make_shared<Stats>(r.next_id++);
+    r.entries.push_back(stats);
+    pthread_mutex_unlock(&r.lock);
+    return stats;
+}
+
+std::vector<Snapshot> lock_stats::snapshot() {
+    std::vector<Snapshot> out;
+    Registry &r = registry();
+    pthread_mutex_lock(&r.lock);
+    for (const auto &e : r.entries) {
+        if (auto s = e.lock()) {
+            out.push_back(Snapshot{
+                s->id,
+                s->name_,
+                s->acquisitions.load(std::memory_order_relaxed),
+                s->contended.load(std::memory_order_relaxed),
+                s->wait_total_ns.load(std::memory_order_relaxed),
+                s->wait_max_ns.load(std::memory_order_relaxed),
+                s->hold_total_ns.load(std::memory_order_relaxed),
+                s->hold_max_ns.load(std::memory_order_relaxed),
+            });
+        }
+    }
+    pthread_mutex_unlock(&r.lock);
+    std::stable_sort(out.begin(), out.end(), [](const Snapshot &a, const Snapshot &b) {
+        return a.wait_total_ns > b.wait_total_ns;
+    });
+    return out;
+}
+
+void lock_stats::reset() {
+    Registry &r = registry();
+    pthread_mutex_lock(&r.lock);
+    for (const auto &e : r.entries) {
+        if (auto s = e.lock()) {
+            s->reset();
+        }
+    }
+    pthread_mutex_unlock(&r.lock);
+}
+
+void lock_stats::dump(std::ostream &o) {
+    o << std::left
+        << std::setw(24) << "name" << std::right
+        << std::setw(12) << "acquired"
+        << std::setw(12) << "contended"
+        << std::setw(16) << "wait total us"
+        << std::setw(14) << "wait max us"
+        << std::setw(16) << "hold total us"
+        << std::setw(14) << "hold max us"
+        << std::endl;
+    for (const Snapshot &s : snapshot()) {
+        o << std::left
+            << std::setw(24) << display_name(s) << std::right
+            << std::setw(12) << s.acquisitions
+            << std::setw(12) << s.contended
+            << std::setw(16) << s.wait_total_ns / 1000
+            << std::setw(14) << s.wait_max_ns / 1000
+            << std::setw(16) << s.hold_total_ns / 1000
+            << std::setw(14) << s.hold_max_ns / 1000
+            << std::endl;
+    }
+}
+
+void lock_stats::dump_json(std::ostream &o) {
+    o << "[";
+    bool first = true;
+    for (const Snapshot &s : snapshot()) {
+        if (!first) {
+            o << ",";
+        }
+        first = false;
+        o << "{\"id\":" << s.id << ",\"name\":";
+        write_json_string(o, s.name);
+        o << ",\"acquisitions\":" << s.acquisitions
+            << ",\"contended\":" << s.contended
+            << ",\"wait_total_ns\":" << s.wait_total_ns
+            << ",\"wait_max_ns\":" << s.wait_max_ns
+            << ",\"hold_total_ns\":" << s.hold_total_ns
+            << ",\"hold_max_ns\":" << s.hold_max_ns
+            << "}";
+    }
+    o << "]";
+}
+
+uint64_t lock_stats::now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+namespace rcore {
+
+// Lock contention statistics.
+//
+// Locks create their `Stats` with `register_()` and record every acquisition and release.
+// Statistics of all alive locks can be collected from the global registry.
+// Mutexes do it only when `RSTD_MUTEX_STATS` is defined, otherwise the registry stays empty.
+namespace lock_stats {
+
+struct Snapshot {
+    uint64_t id;
+    std::string name;
+    uint64_t acquisitions;
+    uint64_t contended;
+    uint64_t wait_total_ns;
+    uint64_t wait_max_ns;
+    uint64_t hold_total_ns;
+    uint64_t hold_max_ns;
+};
+
+// Statistics of all alive locks sorted by total wait time in descending order
+std::vector<Snapshot> snapshot();
+
+class Stats final {
+public:
+    // Unique among all registered locks
+    const uint64_t id;
+
+    std::atomic<uint64_t> acquisitions{0};
+    // Acquisitions that had to wait for another thread to release the lock
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_total_ns{0};
+    std::atomic<uint64_t> wait_max_ns{0};
+    std::atomic<uint64_t> hold_total_ns{0};
+    std::atomic<uint64_t> hold_max_ns{0};
+
+    explicit Stats(uint64_t id);
+
+    Stats(const Stats &) = delete;
+    Stats &operator=(const Stats &) = delete;
+
+    void record_acquire(bool contended, uint64_t wait_ns);
+    void record_release(uint64_t hold_ns);
+    void reset();
+
+    // Name is protected by the registry lock, so it can be changed at any time
+    void set_name(const std::string &name);
+    std::string name() const;
+
+private:
+    std::string name_;
+
+    friend std::vector<Snapshot> snapshot();
+};
+
+// Creates statistics of a new lock and adds it to the registry.
+// Registry doesn't own the statistics, it is removed when the lock is destroyed.
+std::shared_ptr<Stats> register_();
+
+void reset();
+
+// Human-readable table
+void dump(std::ostream &o);
+// JSON array of objects with the `Snapshot` fields
+void dump_json(std::ostream &o);
+
+// Monotonic time in nanoseconds
+uint64_t now_ns();
+
+} // namespace lock_stats
+
+} // namespace rcore
@@ -10,12 +10,14 @@
 using namespace rcore;
 
 static void default_panic_hook(const std::string &message) {
+    const Thread &ct = thread::current();
     std::string thread_name;
-    if (thread::current().is_main) {
+    if (!ct.name.empty()) {
+        thread_name = "'" + ct.name + "'";
+    } else if (ct.is_main) {
         thread_name = "Main";
     } else {
-	// FIXME: get printable thread name
-        thread_name = "Unnamed"; //std::to_string(pthread_self());
+        thread_name = "Unnamed #" + std::to_string(ct.id);
     }
     stderr_()
     << "Thread " << thread_name
@@ -0,0 +1,307 @@
+#include "simd.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+
+using namespace rcore;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RCORE_SIMD_X86
+#endif
+
+#define RCORE_SIMD_INLINE inline __attribute__((always_inline))
+
+namespace {
+
+// Elements in a block of pairwise summation
+const size_t PAIRWISE_BLOCK = 256;
+
+// Sum with four vector accumulators of `W` bytes
+template <typename T, size_t W>
+RCORE_SIMD_INLINE T sum_kernel(const T *data, size_t len) {
+    typedef T V __attribute__((vector_size(W)));
+    const size_t L = W / sizeof(T);
+    V a0 = {}, a1 = {}, a2 = {}, a3 = {};
+    size_t i = 0;
+    for (; i + 4 * L <= len; i += 4 * L) {
+        V x0, x1, x2, x3;
+        memcpy(&x0, data + i, W);
+        memcpy(&x1, data + i + L, W);
+        memcpy(&x2, data + i + 2 * L, W);
+        memcpy(&x3, data + i + 3 * L, W);
+        a0 += x0;
+        a1 += x1;
+        a2 += x2;
+        a3 += x3;
+    }
+    for (; i + L <= len; i += L) {
+        V x;
+        memcpy(&x, data + i, W);
+        a0 += x;
+    }
+    V a = (a0 + a1) + (a2 + a3);
+    T s = T(0);
+    for (size_t k = 0; k < L; ++k) {
+        s += a[k];
+    }
+    for (; i < len; ++i) {
+        s += data[i];
+    }
+    return s;
+}
+
+// Product with four vector accumulators of `W` bytes
+template <typename T, size_t W>
+RCORE_SIMD_INLINE T product_kernel(const T *data, size_t len) {
+    typedef T V __attribute__((vector_size(W)));
+    const size_t L = W / sizeof(T);
+    V a0 = V{} + T(1), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 4 * L <= len; i += 4 * L) {
+        V x0, x1, x2, x3;
+        memcpy(&x0, data + i, W);
+        memcpy(&x1, data + i + L, W);
+        memcpy(&x2, data + i + 2 * L, W);
+        memcpy(&x3, data + i + 3 * L, W);
+        a0 *= x0;
+        a1 *= x1;
+        a2 *= x2;
+        a3 *= x3;
+    }
+    for (; i + L <= len; i += L) {
+        V x;
+        memcpy(&x, data + i, W);
+        a0 *= x;
+    }
+    V a = (a0 * a1) * (a2 * a3);
+    T p = T(1);
+    for (size_t k = 0; k < L; ++k) {
+        p *= a[k];
+    }
+    for (; i < len; ++i) {
+        p *= data[i];
+    }
+    return p;
+}
+
+// Block sums are combined like a binary counter, so that each of them
+// takes part in O(log n) additions, same as in recursive pairwise summation
+template <typename T, size_t W>
+RCORE_SIMD_INLINE T pairwise_sum_kernel(const T *data, size_t len) {
+    T stack[64];
+    size_t depth = 0;
+    uint64_t blocks = 0;
+    for (size_t i = 0; i < len; i += PAIRWISE_BLOCK) {
+        T s = sum_kernel<T, W>(data + i, std::min(PAIRWISE_BLOCK, len - i));
+        for (uint64_t b = blocks; (b & 1) != 0; b >>= 1) {
+            depth -= 1;
+            s = stack[depth] + s;
+        }
+        stack[depth] = s;
+        depth += 1;
+        blocks += 1;
+    }
+    T s = T(0);
+    while (depth > 0) {
+        depth -= 1;
+        s = stack[depth] + s;
+    }
+    return s;
+}
+
+template <typename T, bool MAX>
+RCORE_SIMD_INLINE T select(T a, T b) {
+    if (MAX) {
+        return b > a ? b : a;
+    } else {
+        return b < a ? b : a;
+    }
+}
+
+template <typename T, size_t W, bool MAX>
+RCORE_SIMD_INLINE T min_max_kernel(const T *data, size_t len) {
+    typedef T V __attribute__((vector_size(W)));
+    const size_t L = W / sizeof(T);
+    T r = data[0];
+    size_t i = 0;
+    if (len >= 4 * L) {
+        V a0, a1, a2, a3;
+        memcpy(&a0, data, W);
+        memcpy(&a1, data + L, W);
+        memcpy(&a2, data + 2 * L, W);
+        memcpy(&a3, data + 3 * L, W);
+        for (i = 4 * L; i + 4 * L <= len; i += 4 * L) {
+            V x0, x1, x2, x3;
+            memcpy(&x0, data + i, W);
+            memcpy(&x1, data + i + L, W);
+            memcpy(&x2, data + i + 2 * L, W);
+            memcpy(&x3, data + i + 3 * L, W);
+            a0 = MAX ? (x0 > a0 ? x0 : a0) : (x0 < a0 ? x0 : a0);
+            a1 = MAX ? (x1 > a1 ? x1 : a1) : (x1 < a1 ? x1 : a1);
+            a2 = MAX ? (x2 > a2 ? x2 : a2) : (x2 < a2 ? x2 : a2);
+            a3 = MAX ? (x3 > a3 ? x3 : a3) : (x3 < a3 ? x3 : a3);
+        }
+        for (size_t k = 0; k < L; ++k) {
+            r = select<T, MAX>(r, a0[k]);
+            r = select<T, MAX>(r, a1[k]);
+            r = select<T, MAX>(r, a2[k]);
+            r = select<T, MAX>(r, a3[k]);
+        }
+    }
+    for (; i < len; ++i) {
+        r = select<T, MAX>(r, data[i]);
+    }
+    return r;
+}
+
+#ifdef RCORE_SIMD_X86
+
+template <typename T>
+__attribute__((target("avx2"))) T sum_avx2(const T *data, size_t len) {
+    return sum_kernel<T, 32>(data, len);
+}
+template <typename T>
+__attribute__((target("avx2"))) T pairwise_sum_avx2(const T *data, size_t len) {
+    return pairwise_sum_kernel<T, 32>(data, len);
+}
+template <typename T>
+__attribute__((target("avx2"))) T product_avx2(const T *data, size_t len) {
+    return product_kernel<T, 32>(data, len);
+}
+template <typename T, bool MAX>
+__attribute__((target("avx2"))) T min_max_avx2(const T *data, size_t len) {
+    return min_max_kernel<T, 32, MAX>(data, len);
+}
+
+bool has_avx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+#endif // RCORE_SIMD_X86
+
+template <typename T>
+T sum_dispatch(const T *data, size_t len) {
+#ifdef RCORE_SIMD_X86
+    if (has_avx2()) {
+        return sum_avx2<T>(data, len);
+    }
+#endif // RCORE_SIMD_X86
+    return sum_kernel<T, 16>(data, len);
+}
+template <typename T>
+T pairwise_sum_dispatch(const T *data, size_t len) {
+#ifdef RCORE_SIMD_X86
+    if (has_avx2()) {
+        return pairwise_sum_avx2<T>(data, len);
+    }
+#endif // RCORE_SIMD_X86
+    return pairwise_sum_kernel<T, 16>(data, len);
+}
+template <typename T>
+T product_dispatch(const T *data, size_t len) {
+#ifdef RCORE_SIMD_X86
+    if (has_avx2()) {
+        return product_avx2<T>(data, len);
+    }
+#endif // RCORE_SIMD_X86
+    return product_kernel<T, 16>(data, len);
+}
+template <typename T, bool MAX>
+T min_max_dispatch(const T *data, size_t len) {
+#ifdef RCORE_SIMD_X86
+    if (has_avx2()) {
+        return min_max_avx2<T, MAX>(data, len);
+    }
+#endif // RCORE_SIMD_X86
+    return min_max_kernel<T, 16, MAX>(data, len);
+}
+
+// Signed sums are computed in unsigned type to wrap around instead of overflow
+template <typename T, typename U>
+T wrapping_sum(const T *data, size_t len) {
+    static_assert(sizeof(T) == sizeof(U));
+    return T(sum_dispatch<U>(reinterpret_cast<const U *>(data), len));
+}
+
+// Signed products are computed in unsigned type to wrap around instead of overflow
+template <typename T, typename U>
+T wrapping_product(const T *data, size_t len) {
+    static_assert(sizeof(T) == sizeof(U));
+    return T(product_dispatch<U>(reinterpret_cast<const U *>(data), len));
+}
+
+} // namespace
+
+const char *simd::kernels() {
+#ifdef RCORE_SIMD_X86
+    return has_avx2() ? "avx2" : "sse2";
+#else // RCORE_SIMD_X86
+    return "generic";
+#endif // RCORE_SIMD_X86
+}
+
+int32_t simd::sum(const int32_t *data, size_t len) {
+    return wrapping_sum<int32_t, uint32_t>(data, len);
+}
+uint32_t simd::sum(const uint32_t *data, size_t len) {
+    return sum_dispatch<uint32_t>(data, len);
+}
+int64_t simd::sum(const int64_t *data, size_t len) {
+    return wrapping_sum<int64_t, uint64_t>(data, len);
+}
+uint64_t simd::sum(const uint64_t *data, size_t len) {
+    return sum_dispatch<uint64_t>(data, len);
+}
+float simd::sum(const float *data, size_t len) {
+    return pairwise_sum_dispatch<float>(data, len);
+}
+double simd::sum(const double *data, size_t len) {
+    return pairwise_sum_dispatch<double>(data, len);
+}
+
+int32_t simd::product(const int32_t *data, size_t len) {
+    return wrapping_product<int32_t, uint32_t>(data, len);
+}
+uint32_t simd::product(const uint32_t *data, size_t len) {
+    return product_dispatch<uint32_t>(data, len);
+}
+int64_t simd::product(const int64_t *data, size_t len) {
+    return wrapping_product<int64_t, uint64_t>(data, len);
+}
+uint64_t simd::product(const uint64_t *data, size_t len) {
+    return product_dispatch<uint64_t>(data, len);
+}
+float simd::product(const float *data, size_t len) {
+    return product_dispatch<float>(data, len);
+}
+double simd::product(const double *data, size_t len) {
+    return product_dispatch<double>(data, len);
+}
+
+int32_t simd::min(const int32_t *data, size_t len) {
+    return min_max_dispatch<int32_t, false>(data, len);
+}
+uint32_t simd::min(const uint32_t *data, size_t len) {
+    return min_max_dispatch<uint32_t, false>(data, len);
+}
+int64_t simd::min(const int64_t *data, size_t len) {
+    return min_max_dispatch<int64_t, false>(data, len);
+}
+uint64_t simd::min(const uint64_t *data, size_t len) {
+    return min_max_dispatch<uint64_t, false>(data, len);
+}
+
+int32_t simd::max(const int32_t *data, size_t len) {
+    return min_max_dispatch<int32_t, true>(data, len);
+}
+uint32_t simd::max(const uint32_t *data, size_t len) {
+    return min_max_dispatch<uint32_t, true>(data, len);
+}
+int64_t simd::max(const int64_t *data, size_t len) {
+    return min_max_dispatch<int64_t, true>(data, len);
+}
+uint64_t simd::max(const uint64_t *data, size_t len) {
+    return min_max_dispatch<uint64_t, true>(data, len);
+}
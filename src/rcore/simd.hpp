@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace rcore {
+
+// Vectorized reductions over contiguous arrays.
+//
+// Kernels use several independent vector accumulators to hide instruction latency.
+// The instruction set is selected at runtime: AVX2 if the CPU supports it, otherwise
+// SSE2 on x86-64 or generic 16-byte vectors (e.g. NEON) on other platforms.
+namespace simd {
+
+// Name of the selected kernel set: "avx2", "sse2" or "generic"
+const char *kernels();
+
+// Integer sums wrap around on overflow
+int32_t sum(const int32_t *data, size_t len);
+uint32_t sum(const uint32_t *data, size_t len);
+int64_t sum(const int64_t *data, size_t len);
+uint64_t sum(const uint64_t *data, size_t len);
+// Floating-point sums use pairwise summation, so the rounding error grows
+// as O(log n) instead of O(n) for sequential accumulation
+float sum(const float *data, size_t len);
+double sum(const double *data, size_t len);
+
+// Integer products wrap around on overflow.
+// Floating-point products are reassociated, so they may differ from the sequential one in rounding.
+int32_t product(const int32_t *data, size_t len);
+uint32_t product(const uint32_t *data, size_t len);
+int64_t product(const int64_t *data, size_t len);
+uint64_t product(const uint64_t *data, size_t len);
+float product(const float *data, size_t len);
+double product(const double *data, size_t len);
+
+// `len` must be non-zero
+int32_t min(const int32_t *data, size_t len);
+uint32_t min(const uint32_t *data, size_t len);
+int64_t min(const int64_t *data, size_t len);
+uint64_t min(const uint64_t *data, size_t len);
+
+int32_t max(const int32_t *data, size_t len);
+uint32_t max(const uint32_t *data, size_t len);
+int64_t max(const int64_t *data, size_t len);
+uint64_t max(const uint64_t *data, size_t len);
+
+} // namespace simd
+
+} // namespace rcore
@@ -1,14 +1,81 @@
 #include "thread.hpp"
 
 #include <pthread.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif // __linux__
+#include <atomic>
+#include "futex.hpp"
 
 
 using namespace rcore;
 
+static std::atomic<uint64_t> next_thread_id(1);
+
+uint64_t thread::__next_id() {
+    return next_thread_id.fetch_add(1, std::memory_order_relaxed);
+}
+
 static_thread_local_(Thread, current_thread) {
-    return Thread();
+    Thread t;
+    t.id = thread::__next_id();
+    t.parker = std::make_shared<Parker>();
+    t.start_time_ns = thread::__now_ns();
+    return t;
+}
+
+uint64_t thread::__now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+ThreadStats Thread::stats() const {
+    ThreadStats s;
+    s.wall_time_ns = thread::__now_ns() - start_time_ns;
+#ifdef __linux__
+    rusage ru;
+    if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+        s.user_time_ns = uint64_t(ru.ru_utime.tv_sec) * 1000000000 + uint64_t(ru.ru_utime.tv_usec) * 1000;
+        s.system_time_ns = uint64_t(ru.ru_stime.tv_sec) * 1000000000 + uint64_t(ru.ru_stime.tv_usec) * 1000;
+        s.voluntary_switches = uint64_t(ru.ru_nvcsw);
+        s.involuntary_switches = uint64_t(ru.ru_nivcsw);
+    }
+#else // __linux__
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        s.user_time_ns = uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+    }
+#endif // __linux__
+    return s;
 }
 
 Thread &thread::current() {
     return *current_thread;
 }
+
+void thread::park() {
+    current().parker->park();
+}
+
+void Parker::park() {
+    if (state.fetch_sub(1, std::memory_order_acquire) == NOTIFIED) {
+        // Was notified, now EMPTY
+        return;
+    }
+    // Now PARKED
+    for (;;) {
+        futex::wait(&state, PARKED);
+        uint32_t expected = NOTIFIED;
+        if (state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void Parker::unpark() {
+    if (state.exchange(NOTIFIED, std::memory_order_release) == PARKED) {
+        futex::wake_one(&state);
+    }
+}
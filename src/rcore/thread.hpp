@@ -2,17 +2,72 @@
 
 #include <iostream>
 #include <functional>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <atomic>
 #include "once.hpp"
 #include "io.hpp"
 
 
 namespace rcore {
 
+// Token that allows a thread to block until it is unparked by another thread.
+class Parker {
+private:
+    static const uint32_t EMPTY = 0;
+    static const uint32_t NOTIFIED = 1;
+    static const uint32_t PARKED = uint32_t(-1);
+
+    std::atomic<uint32_t> state{EMPTY};
+
+public:
+    Parker() = default;
+    Parker(const Parker &) = delete;
+    Parker &operator=(const Parker &) = delete;
+
+    // Must be called only by the owning thread
+    void park();
+    void unpark();
+};
+
+// Resources consumed by a thread
+struct ThreadStats {
+    // Time passed since the thread was spawned (or first accessed for threads not created by `Builder`)
+    uint64_t wall_time_ns = 0;
+    uint64_t user_time_ns = 0;
+    // Zero on platforms that don't report it separately from `user_time_ns`
+    uint64_t system_time_ns = 0;
+    // Context switches, zero on platforms that don't report them
+    uint64_t voluntary_switches = 0;
+    uint64_t involuntary_switches = 0;
+
+    uint64_t cpu_time_ns() const {
+        return user_time_ns + system_time_ns;
+    }
+};
+
 class Thread {
 public:
     rcore::StdIo stdio;
     std::function<void(const std::string &)> panic_hook;
     bool is_main = true;
+    // Empty if the thread is unnamed
+    std::string name;
+    // Unique among all threads created during the process lifetime
+    uint64_t id = 0;
+    // Shared between all copies of the thread handle
+    std::shared_ptr<Parker> parker;
+    // Monotonic time of thread creation in nanoseconds
+    uint64_t start_time_ns = 0;
+
+    // Wakes the thread up if it is parked, otherwise makes next `park` call return immediately
+    void unpark() const {
+        parker->unpark();
+    }
+
+    // Resources consumed by the thread so far. Must be called from the thread itself.
+    ThreadStats stats() const;
 };
 
 template <typename T, void (*FO)(), T (*FT)()>
@@ -55,6 +110,13 @@ namespace thread {
 
 Thread &current();
 
+// Blocks current thread until its handle is unparked. May wake up spuriously.
+void park();
+
+uint64_t __next_id();
+// Monotonic time in nanoseconds
+uint64_t __now_ns();
+
 } // namespace thread
 
 } // namespace rcore
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+template <typename T>
+class ArcSwap;
+
+// Atomically reference counted heap-located storage.
+// Unlike `Rc` it owns its control block, so the counter could be manipulated directly by `ArcSwap`.
+template <typename T>
+class Arc final {
+private:
+    struct Inner {
+        std::atomic<int64_t> strong;
+        T value;
+
+        template <typename ...Args>
+        explicit Inner(Args &&...args) : strong(1), value(std::forward<Args>(args)...) {}
+    };
+    Inner *inner = nullptr;
+
+    explicit Arc(Inner *i) : inner(i) {}
+
+    void acquire() const {
+        if (inner != nullptr) {
+            inner->strong.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    static void __release(Inner *i, int64_t n = 1) {
+        if (i->strong.fetch_sub(n, std::memory_order_release) == n) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            delete i;
+        }
+    }
+
+public:
+    Arc() = default;
+    explicit Arc(T &&v) : inner(new Inner(std::move(v))) {}
+    explicit Arc(const T &v) : inner(new Inner(v)) {}
+    ~Arc() {
+        this->drop();
+    }
+
+    Arc(Arc &&other) : inner(other.inner) {
+        other.inner = nullptr;
+    }
+    Arc &operator=(Arc &&other) {
+        if (this != &other) {
+            this->drop();
+            inner = other.inner;
+            other.inner = nullptr;
+        }
+        return *this;
+    }
+
+    Arc(const Arc &other) : inner(other.inner) {
+        acquire();
+    }
+    Arc &operator=(const Arc &other) {
+        other.acquire();
+        this->drop();
+        inner = other.inner;
+        return *this;
+    }
+
+    T &operator*() {
+        assert_(inner != nullptr);
+        return inner->value;
+    }
+    const T &operator*() const {
+        assert_(inner != nullptr);
+        return inner->value;
+    }
+    T *operator->() {
+        return &**this;
+    }
+    const T *operator->() const {
+        return &**this;
+    }
+
+    void drop() {
+        if (inner != nullptr) {
+            __release(inner);
+            inner = nullptr;
+        }
+    }
+    Option<T> try_take() {
+        if (inner != nullptr && inner->strong.load(std::memory_order_acquire) == 1) {
+            auto ret = Option<T>::Some(T(std::move(inner->value)));
+            drop();
+            return ret;
+        } else {
+            return Option<T>::None();
+        }
+    }
+
+    // Number of existing references. May be outdated in case of concurrent access.
+    size_t strong_count() const {
+        if (inner != nullptr) {
+            return size_t(inner->strong.load(std::memory_order_relaxed));
+        } else {
+            return 0;
+        }
+    }
+    bool ptr_eq(const Arc &other) const {
+        return inner == other.inner;
+    }
+
+    operator bool() const {
+        return inner != nullptr;
+    }
+
+    friend class ArcSwap<T>;
+};
+
+template <typename T>
+struct TriviallyRelocatable<Arc<T>> : std::true_type {};
+
+} // namespace rstd
@@ -0,0 +1,168 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "arc.hpp"
+#include "arc_swap.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(arc_swap) {
+    struct Counted {
+        std::atomic<int> *alive;
+        int value;
+        Counted(std::atomic<int> *a, int v) : alive(a), value(v) {
+            *alive += 1;
+        }
+        Counted(Counted &&other) : alive(other.alive), value(other.value) {
+            *alive += 1;
+        }
+        ~Counted() {
+            *alive -= 1;
+        }
+    };
+
+    rtest_(arc) {
+        Arc<int> a(123);
+        assert_eq_(a.strong_count(), size_t(1));
+        Arc<int> b = a;
+        assert_eq_(a.strong_count(), size_t(2));
+        assert_(a.ptr_eq(b));
+        assert_(a.try_take().is_none());
+        b.drop();
+        assert_(!bool(b));
+        assert_eq_(a.try_take().unwrap(), 123);
+        assert_(!bool(a));
+    }
+    rtest_(load_store) {
+        ArcSwap<int> swap(1);
+        assert_eq_(*swap.load(), 1);
+        Arc<int> old = swap.load();
+        swap.store(2);
+        assert_eq_(*swap.load(), 2);
+        assert_eq_(*old, 1);
+        assert_eq_(old.strong_count(), size_t(1));
+        assert_eq_(*swap.swap(Arc<int>(3)), 2);
+        assert_eq_(*swap.load(), 3);
+    }
+    rtest_(reclaim) {
+        std::atomic<int> alive(0);
+        {
+            ArcSwap<Counted> swap(Counted(&alive, 0));
+            assert_eq_(alive.load(), 1);
+            Arc<Counted> guard = swap.load();
+            swap.store(Counted(&alive, 1));
+            assert_eq_(alive.load(), 2);
+            guard.drop();
+            assert_eq_(alive.load(), 1);
+            swap.store(Counted(&alive, 2));
+            assert_eq_(alive.load(), 1);
+            assert_eq_(swap.load()->value, 2);
+        }
+        assert_eq_(alive.load(), 0);
+    }
+    rtest_(many_loads) {
+        ArcSwap<int> swap(0);
+        std::vector<Arc<int>> refs;
+        for (int i = 0; i < 100000; ++i) {
+            refs.push_back(swap.load());
+        }
+        Arc<int> old = swap.swap(Arc<int>(1));
+        assert_eq_(old.strong_count(), size_t(100001));
+        refs.clear();
+        assert_eq_(old.strong_count(), size_t(1));
+    }
+    rtest_(contended_loads) {
+        // Local count passes its 16 bits many times over without any store
+        const size_t threads = 8, count = 40000;
+        ArcSwap<int> swap(0);
+        std::vector<std::vector<Arc<int>>> refs(threads);
+        std::vector<JoinHandle<>> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&swap, &refs, t]() {
+                for (size_t i = 0; i < count; ++i) {
+                    refs[t].push_back(swap.load());
+                    // Short-lived references
+                    assert_eq_(*swap.load(), 0);
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        Arc<int> old = swap.swap(Arc<int>(1));
+        assert_eq_(old.strong_count(), threads*count + 1);
+        refs.clear();
+        assert_eq_(old.strong_count(), size_t(1));
+    }
+    rtest_(loads_during_stores) {
+        // Transfers of the local count race with replacements of the value
+        const int threads = 32, count = 20000;
+        std::atomic<int> alive(0);
+        {
+            ArcSwap<Counted> swap(Counted(&alive, 0));
+            std::atomic<bool> done(false);
+            std::vector<JoinHandle<>> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.push_back(thread::spawn([&]() {
+                    for (int i = 0; i < count; ++i) {
+                        assert_(swap.load()->value >= 0);
+                    }
+                }));
+            }
+            auto writer = thread::spawn([&]() {
+                for (int i = 1; !done.load(); ++i) {
+                    swap.store(Counted(&alive, i));
+                }
+            });
+            for (auto &w : workers) {
+                w.join().unwrap();
+            }
+            done.store(true);
+            writer.join().unwrap();
+            assert_eq_(alive.load(), 1);
+        }
+        assert_eq_(alive.load(), 0);
+    }
+    rtest_(compare_and_swap) {
+        ArcSwap<int> swap(1);
+        Arc<int> cur = swap.load();
+        auto res = swap.compare_and_swap(cur, Arc<int>(2));
+        assert_eq_(*res.unwrap(), 1);
+        auto fail = swap.compare_and_swap(cur, Arc<int>(3));
+        assert_eq_(*fail.unwrap_err(), 3);
+        assert_eq_(*swap.load(), 2);
+    }
+    rtest_(concurrent_rcu) {
+        const int threads = 4, count = 1000;
+        std::atomic<int> alive(0);
+        {
+            ArcSwap<Counted> swap(Counted(&alive, 0));
+            std::vector<JoinHandle<>> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.push_back(thread::spawn([&]() {
+                    for (int i = 0; i < count; ++i) {
+                        swap.rcu([&](const Counted &c) { return Counted(&alive, c.value + 1); });
+                    }
+                }));
+            }
+            for (int t = 0; t < threads; ++t) {
+                workers.push_back(thread::spawn([&]() {
+                    int last = 0;
+                    for (int i = 0; i < count; ++i) {
+                        int v = swap.load()->value;
+                        assert_(v >= last);
+                        last = v;
+                    }
+                }));
+            }
+            for (auto &w : workers) {
+                w.join().unwrap();
+            }
+            assert_eq_(swap.load()->value, threads*count);
+        }
+        assert_eq_(alive.load(), 0);
+    }
+}
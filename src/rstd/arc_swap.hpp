@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "prelude.hpp"
+#include "arc.hpp"
+
+
+namespace rstd {
+
+// Atomically replaceable `Arc<T>`.
+//
+// Uses differential reference counting: the pointer to the current value and
+// the amount of references taken by readers (local count) are packed into a single atomic word.
+// So `load` usually costs a single `fetch_add` without touching the value counter.
+// While the value is installed it holds a large bias in its counter,
+// and when it's replaced the local count is transferred to the counter.
+template <typename T>
+class ArcSwap final {
+private:
+    typedef typename Arc<T>::Inner Inner;
+
+    static const int PTR_BITS = 48;
+    static const uint64_t PTR_MASK = (uint64_t(1) << PTR_BITS) - 1;
+    static const uint64_t LOCAL_ONE = uint64_t(1) << PTR_BITS;
+    // Local count is transferred to the value counter when it reaches this threshold.
+    // Each thread adds at most one reference above it before the count is transferred,
+    // so the 16 bits overflow only with more than 61000 concurrent loads.
+    static const uint64_t LOCAL_THRESHOLD = uint64_t(1) << 12;
+    // References owned by the swap itself while the value is installed
+    static const int64_t BIAS = int64_t(1) << 40;
+
+    mutable std::atomic<uint64_t> state;
+
+    static Inner *ptr_of(uint64_t s) {
+        return (Inner *)(uintptr_t)(s & PTR_MASK);
+    }
+    static uint64_t local_of(uint64_t s) {
+        return s >> PTR_BITS;
+    }
+
+    // Takes ownership of `value` and converts it into the installed state
+    static uint64_t install(Arc<T> &&value) {
+        Inner *inner = value.inner;
+        assert_(inner != nullptr);
+        assert_(((uintptr_t)inner & ~PTR_MASK) == 0);
+        value.inner = nullptr;
+        inner->strong.fetch_add(BIAS - 1, std::memory_order_relaxed);
+        return (uint64_t)(uintptr_t)inner;
+    }
+    // Converts the replaced state into the ordinary `Arc<T>`
+    static Arc<T> uninstall(uint64_t s) {
+        Inner *inner = ptr_of(s);
+        int64_t local = int64_t(local_of(s));
+        // Keep one reference for returned value
+        inner->strong.fetch_add(local - BIAS + 1, std::memory_order_acq_rel);
+        return Arc<T>(inner);
+    }
+
+    // Transfers the local count of the installed value `s` to its counter.
+    // Retries until the local count is cleared by this or another thread or the value is replaced,
+    // in the latter case the count is transferred by `uninstall`.
+    // Every failed attempt is caused by a concurrent load, store or successful transfer,
+    // and each thread loads at most once while the count is over the threshold,
+    // so the number of retries is bounded by the number of threads.
+    void normalize(uint64_t s) const {
+        Inner *inner = ptr_of(s);
+        while (ptr_of(s) == inner && local_of(s) >= LOCAL_THRESHOLD) {
+            int64_t local = int64_t(local_of(s));
+            inner->strong.fetch_add(local, std::memory_order_relaxed);
+            if (state.compare_exchange_strong(
+                s, s & PTR_MASK, std::memory_order_relaxed
+            )) {
+                return;
+            }
+            // The value may have been replaced and released by everyone else meanwhile
+            Arc<T>::__release(inner, local);
+        }
+    }
+
+public:
+    explicit ArcSwap(Arc<T> &&value) : state(install(std::move(value))) {}
+    explicit ArcSwap(T &&value) : ArcSwap(Arc<T>(std::move(value))) {}
+    ~ArcSwap() {
+        uninstall(state.load(std::memory_order_acquire)).drop();
+    }
+
+    ArcSwap(const ArcSwap &) = delete;
+    ArcSwap &operator=(const ArcSwap &) = delete;
+
+    // Returns the current value.
+    // Never waits for other threads: a load that finds the local count over the threshold
+    // transfers it by itself, so a preempted thread can't stall the others.
+    Arc<T> load() const {
+        uint64_t s = state.fetch_add(LOCAL_ONE, std::memory_order_acquire);
+        if (local_of(s) + 1 >= LOCAL_THRESHOLD) {
+            normalize(s + LOCAL_ONE);
+        }
+        // The reference is already accounted in the local count
+        return Arc<T>(ptr_of(s));
+    }
+
+    // Replaces the current value and returns the previous one
+    Arc<T> swap(Arc<T> &&value) {
+        uint64_t s = state.exchange(install(std::move(value)), std::memory_order_acq_rel);
+        return uninstall(s);
+    }
+    void store(Arc<T> &&value) {
+        swap(std::move(value)).drop();
+    }
+    void store(T &&value) {
+        store(Arc<T>(std::move(value)));
+    }
+
+    // Replaces the value only if it is still the `current` one.
+    // Returns `Ok` with the previous value on success, otherwise returns `new_value` back in `Err`.
+    Result<Arc<T>, Arc<T>> compare_and_swap(const Arc<T> &current, Arc<T> &&new_value) {
+        // Bias must be set before the value becomes visible to readers
+        uint64_t n = install(std::move(new_value));
+        uint64_t s = state.load(std::memory_order_acquire);
+        for (;;) {
+            if (ptr_of(s) != current.inner) {
+                return Result<Arc<T>, Arc<T>>::Err(uninstall(n));
+            }
+            if (state.compare_exchange_weak(
+                s, n,
+                std::memory_order_acq_rel, std::memory_order_acquire
+            )) {
+                return Result<Arc<T>, Arc<T>>::Ok(uninstall(s));
+            }
+        }
+    }
+
+    // Read-copy-update: applies `f` to the current value and stores the result,
+    // retrying if the value was concurrently replaced. Returns the replaced value.
+    // `f` may be called several times.
+    template <typename F>
+    Arc<T> rcu(F f) {
+        for (;;) {
+            Arc<T> cur = load();
+            auto res = compare_and_swap(cur, Arc<T>(f(*cur)));
+            if (res.is_ok()) {
+                return res.unwrap();
+            }
+            res.clear();
+        }
+    }
+};
+
+} // namespace rstd
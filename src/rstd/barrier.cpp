@@ -0,0 +1,42 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "barrier.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(barrier) {
+    rtest_(single) {
+        Barrier barrier(1);
+        assert_(barrier.wait().is_leader());
+        assert_(barrier.wait().is_leader());
+    }
+    rtest_(phases) {
+        const int threads = 8, rounds = 100;
+        Barrier barrier(threads);
+        std::atomic<int> phase_counter(0);
+        std::atomic<int> leaders(0);
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&]() {
+                for (int r = 0; r < rounds; ++r) {
+                    phase_counter += 1;
+                    if (barrier.wait().is_leader()) {
+                        leaders += 1;
+                    }
+                    // Every thread has finished the current round
+                    assert_(phase_counter.load() >= (r + 1)*threads);
+                    barrier.wait();
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        assert_eq_(phase_counter.load(), threads*rounds);
+        assert_eq_(leaders.load(), rounds);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <rcore/futex.hpp>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+class BarrierWaitResult final {
+private:
+    bool leader;
+
+public:
+    explicit BarrierWaitResult(bool l) : leader(l) {}
+
+    // Exactly one thread of each generation is a leader
+    bool is_leader() const {
+        return leader;
+    }
+};
+
+// Reusable barrier that blocks threads until all of them reach it.
+class Barrier final {
+private:
+    uint32_t count;
+    std::atomic<uint32_t> arrived{0};
+    std::atomic<uint32_t> generation{0};
+
+public:
+    explicit Barrier(uint32_t n) : count(n) {
+        assert_(n > 0);
+    }
+    ~Barrier() = default;
+
+    Barrier(const Barrier &) = delete;
+    Barrier &operator=(const Barrier &) = delete;
+
+    BarrierWaitResult wait() {
+        uint32_t gen = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            rcore::futex::wake_all(&generation);
+            return BarrierWaitResult(true);
+        }
+        auto passed = [&]() {
+            return generation.load(std::memory_order_acquire) != gen;
+        };
+        if (!rcore::futex::spin(passed)) {
+            while (!passed()) {
+                rcore::futex::wait(&generation, gen);
+            }
+        }
+        return BarrierWaitResult(false);
+    }
+};
+
+} // namespace rstd
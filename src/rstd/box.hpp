@@ -156,4 +156,7 @@ public:
     {}
 };
 
+template <typename T>
+struct TriviallyRelocatable<Box<T>> : std::true_type {};
+
 } // namespace rstd
@@ -0,0 +1,53 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "thread.hpp"
+#include "time.hpp"
+#include "cancellation.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(cancellation) {
+    rtest_(cancel) {
+        CancellationToken token;
+        CancellationToken copy = token;
+        assert_(copy.same_as(token));
+        assert_(!copy.is_cancelled());
+        token.cancel();
+        assert_(copy.is_cancelled());
+        copy.wait();
+        assert_(!CancellationToken().same_as(token));
+    }
+    rtest_(wait_for_timeout) {
+        CancellationToken token;
+        auto start = time::Instant::now();
+        assert_(!token.wait_for(time::Duration::from_millis(10)));
+        assert_(start.elapsed() >= time::Duration::from_millis(10));
+    }
+    rtest_(wait_for_max) {
+        CancellationToken token;
+        auto canceller = thread::spawn([token]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            token.cancel();
+        });
+        assert_(token.wait_for(time::Duration::max()));
+        canceller.join().unwrap();
+    }
+    rtest_(stop_worker) {
+        CancellationToken token;
+        std::atomic<int> iterations(0);
+        auto worker = thread::spawn([token, &iterations]() {
+            while (!token.wait_for(time::Duration::from_millis(1))) {
+                iterations += 1;
+            }
+        });
+        while (iterations.load() < 3) {
+            std::this_thread::yield();
+        }
+        token.cancel();
+        worker.join_timeout(time::Duration::from_secs(10)).unwrap().unwrap();
+    }
+}
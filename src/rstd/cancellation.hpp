@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <rcore/futex.hpp>
+#include "prelude.hpp"
+#include "time.hpp"
+
+
+namespace rstd {
+
+// Cooperative cancellation flag.
+// All copies of the token share the same state, so one thread can cancel the work
+// that other threads check with `is_cancelled` or wait for with `wait_for`.
+class CancellationToken final {
+private:
+    std::shared_ptr<std::atomic<uint32_t>> cancelled;
+
+public:
+    CancellationToken() : cancelled(std::make_shared<std::atomic<uint32_t>>(0)) {}
+
+    CancellationToken(const CancellationToken &) = default;
+    CancellationToken &operator=(const CancellationToken &) = default;
+    CancellationToken(CancellationToken &&) = default;
+    CancellationToken &operator=(CancellationToken &&) = default;
+
+    void cancel() const {
+        if (cancelled->exchange(1, std::memory_order_release) == 0) {
+            rcore::futex::wake_all(cancelled.get());
+        }
+    }
+    bool is_cancelled() const {
+        return cancelled->load(std::memory_order_acquire) != 0;
+    }
+
+    // Blocks until the token is cancelled
+    void wait() const {
+        while (!is_cancelled()) {
+            rcore::futex::wait(cancelled.get(), 0);
+        }
+    }
+    // Blocks until the token is cancelled or `timeout` expires.
+    // Returns `true` if cancelled, so it can be used as an interruptible sleep.
+    bool wait_for(const time::Duration &timeout) const {
+        time::Instant deadline = time::Instant::now().saturating_add(timeout);
+        while (!is_cancelled()) {
+            time::Duration remaining = deadline.duration_since(time::Instant::now());
+            if (remaining.is_zero()) {
+                return false;
+            }
+            rcore::futex::wait_for(cancelled.get(), 0, remaining.__saturating_as_nanos());
+        }
+        return true;
+    }
+
+    // Returns `true` if both tokens share the same state
+    bool same_as(const CancellationToken &other) const {
+        return cancelled == other.cancelled;
+    }
+};
+
+} // namespace rstd
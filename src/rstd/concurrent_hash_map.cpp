@@ -0,0 +1,117 @@
+#include <rtest.hpp>
+
+#include <string>
+#include <vector>
+#include "thread.hpp"
+#include "concurrent_hash_map.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(concurrent_hash_map) {
+    rtest_(insert_get_remove) {
+        ConcurrentHashMap<int, std::string> map;
+        assert_(map.insert(1, "one").is_none());
+        assert_(map.insert(2, "two").is_none());
+        assert_eq_(map.insert(1, "uno").unwrap(), std::string("one"));
+        assert_eq_(map.len(), size_t(2));
+
+        assert_eq_(*map.get(1).unwrap(), std::string("uno"));
+        assert_eq_(map.get(2).unwrap().key(), 2);
+        assert_(map.get(3).is_none());
+
+        *map.get_mut(2).unwrap() += "!";
+        assert_eq_(*map.get(2).unwrap(), std::string("two!"));
+
+        assert_eq_(map.remove(1).unwrap(), std::string("uno"));
+        assert_(map.remove(1).is_none());
+        assert_(!map.contains_key(1));
+        assert_eq_(map.len(), size_t(1));
+
+        map.clear();
+        assert_(map.is_empty());
+    }
+    rtest_(shard_amount) {
+        typedef ConcurrentHashMap<int, int> Map;
+        assert_eq_(Map(1).shard_amount(), size_t(1));
+        assert_eq_(Map(5).shard_amount(), size_t(8));
+        assert_eq_(Map(64).shard_amount(), size_t(64));
+
+        Map single(1);
+        for (int i = 0; i < 100; ++i) {
+            single.insert(i, i*i);
+        }
+        assert_eq_(*single.get(9).unwrap(), 81);
+    }
+    rtest_(entry) {
+        ConcurrentHashMap<std::string, int> map;
+        assert_eq_(*map.entry("a").or_insert(1), 1);
+        assert_eq_(*map.entry("a").or_insert(2), 1);
+        assert_eq_(*map.entry("b").or_default(), 0);
+        assert_eq_(*map.entry("c").or_insert_with([]() { return 3; }), 3);
+        {
+            auto e = map.entry("a");
+            assert_(e.is_occupied());
+            assert_eq_(e.get_key(), std::string("a"));
+        }
+        assert_(!map.entry("d").is_occupied());
+        assert_(!map.contains_key("d"));
+
+        assert_eq_(*map.entry("a").and_modify([](int &x) { x += 10; }).or_insert(0), 11);
+        assert_eq_(*map.entry("e").and_modify([](int &x) { x += 10; }).or_insert(0), 0);
+    }
+    rtest_(iter) {
+        ConcurrentHashMap<int, int> map(4);
+        for (int i = 0; i < 100; ++i) {
+            map.insert(i, 2*i);
+        }
+        std::vector<bool> seen(100, false);
+        for (auto kv : map.iter()) {
+            int k = kv.get<0>();
+            assert_eq_(kv.get<1>(), 2*k);
+            assert_(!seen[k]);
+            seen[k] = true;
+        }
+        for (bool s : seen) {
+            assert_(s);
+        }
+        assert_eq_(map.iter().count(), size_t(100));
+    }
+    rtest_(concurrent_insert) {
+        const int threads = 4, count = 1000;
+        ConcurrentHashMap<int, int> map;
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&map, t]() {
+                for (int i = 0; i < count; ++i) {
+                    map.insert(t*count + i, t);
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        assert_eq_(map.len(), size_t(threads*count));
+        for (int i = 0; i < threads*count; ++i) {
+            assert_eq_(*map.get(i).unwrap(), i / count);
+        }
+    }
+    rtest_(concurrent_upsert) {
+        const int threads = 4, count = 1000, keys = 16;
+        ConcurrentHashMap<int, int> map;
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&map]() {
+                for (int i = 0; i < count; ++i) {
+                    *map.entry(i % keys).or_insert(0) += 1;
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        assert_eq_(map.len(), size_t(keys));
+        int total = map.iter().map([](Tuple<int, int> &&kv) { return kv.get<1>(); }).sum();
+        assert_eq_(total, threads*count);
+    }
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "prelude.hpp"
+#include "rwlock.hpp"
+
+
+namespace rstd {
+
+// Hash map that could be shared between threads.
+// Entries are distributed over independently locked shards (lock striping),
+// so threads accessing different shards don't contend with each other.
+template <typename K, typename V, typename H=DefaultHasher>
+class ConcurrentHashMap final {
+private:
+    struct KeyHash {
+        size_t operator()(const K &key) const {
+            H hasher;
+            hasher.hash(key);
+            return hasher.finish();
+        }
+    };
+    typedef std::unordered_map<K, V, KeyHash> Map;
+
+    // Each shard occupies its own cache lines to avoid false sharing
+    struct alignas(cache_line_size) Shard {
+        _RwLock lock;
+        Map map;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_count = 0;
+    // Amount of bits to shift the mixed hash to get the shard index
+    size_t shift = 0;
+
+    Shard &shard_of(const K &key) const {
+        // Fibonacci hashing: take the high bits of the mixed hash
+        uint64_t h = uint64_t(KeyHash()(key)) * 0x9e3779b97f4a7c15ull;
+        return shards[shift < 64 ? size_t(h >> shift) : 0];
+    }
+
+    static size_t default_shard_amount() {
+        return 4 * std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+public:
+    template <typename T>
+    class Guard final {
+    private:
+        Option<_RwLock *> lock;
+        const K *key_ = nullptr;
+        T *value = nullptr;
+
+        void release() {
+            if (lock.is_some()) {
+                lock.take().unwrap()->unlock();
+            }
+        }
+
+    public:
+        Guard() = default;
+        Guard(_RwLock *l, const K *k, T *v) :
+            lock(Option<_RwLock *>::Some(l)), key_(k), value(v)
+        {}
+
+        Guard(Guard &&) = default;
+        Guard &operator=(Guard &&other) {
+            this->release();
+            lock = std::move(other.lock);
+            key_ = other.key_;
+            value = other.value;
+            return *this;
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard() {
+            this->release();
+        }
+
+        const K &key() const {
+            assert_(lock.is_some());
+            return *key_;
+        }
+        T &get() const {
+            assert_(lock.is_some());
+            return *value;
+        }
+        T &operator*() const {
+            return this->get();
+        }
+        T *operator->() const {
+            return &this->get();
+        }
+    };
+    typedef Guard<const V> ReadGuard;
+    typedef Guard<V> WriteGuard;
+
+    // View into a single entry that may be either vacant or occupied.
+    // Holds the write lock of the entry shard until it's dropped or converted to `WriteGuard`.
+    class Entry final {
+    private:
+        Option<Shard *> shard;
+        K key;
+
+        void release() {
+            if (shard.is_some()) {
+                shard.take().unwrap()->lock.unlock();
+            }
+        }
+
+        template <typename F>
+        WriteGuard insert_with(F f) {
+            Shard *s = shard.take().unwrap();
+            auto it = s->map.find(key);
+            if (it == s->map.end()) {
+                it = s->map.emplace(std::move(key), f()).first;
+            }
+            return WriteGuard(&s->lock, &it->first, &it->second);
+        }
+
+    public:
+        Entry(Shard *s, K &&k) : shard(Option<Shard *>::Some(s)), key(std::move(k)) {}
+
+        Entry(Entry &&) = default;
+        Entry &operator=(Entry &&other) {
+            this->release();
+            shard = std::move(other.shard);
+            key = std::move(other.key);
+            return *this;
+        }
+
+        Entry(const Entry &) = delete;
+        Entry &operator=(const Entry &) = delete;
+
+        ~Entry() {
+            this->release();
+        }
+
+        const K &get_key() const {
+            return key;
+        }
+        bool is_occupied() const {
+            const Map &map = shard.get()->map;
+            return map.find(key) != map.end();
+        }
+
+        template <typename F>
+        Entry and_modify(F f) {
+            Map &map = shard.get()->map;
+            auto it = map.find(key);
+            if (it != map.end()) {
+                f(it->second);
+            }
+            return std::move(*this);
+        }
+        WriteGuard or_insert(V &&v) {
+            return insert_with([&]() { return std::move(v); });
+        }
+        template <typename F>
+        WriteGuard or_insert_with(F f) {
+            return insert_with(f);
+        }
+        WriteGuard or_default() {
+            return insert_with([]() { return V(); });
+        }
+    };
+
+    // Weakly consistent iterator over copies of map entries.
+    // Each shard is copied under its read lock at the moment the iterator reaches it,
+    // so concurrent modifications of already visited or not yet visited shards may or may not be observed.
+    class Iter final : public Iterator<Tuple<K, V>, Iter> {
+    private:
+        const ConcurrentHashMap *owner;
+        size_t next_shard = 0;
+        std::vector<Tuple<K, V>> buffer;
+        size_t pos = 0;
+
+        void finish() {
+            next_shard = owner->shard_count;
+            buffer.clear();
+            pos = 0;
+        }
+
+    public:
+        explicit Iter(const ConcurrentHashMap *o) : owner(o) {}
+        Iter(Iter &&other) :
+            owner(other.owner),
+            next_shard(other.next_shard),
+            buffer(std::move(other.buffer)),
+            pos(other.pos)
+        {
+            other.finish();
+        }
+        Iter &operator=(Iter &&other) {
+            owner = other.owner;
+            next_shard = other.next_shard;
+            buffer = std::move(other.buffer);
+            pos = other.pos;
+            other.finish();
+            return *this;
+        }
+
+        Option<Tuple<K, V>> next() {
+            while (pos == buffer.size()) {
+                if (next_shard == owner->shard_count) {
+                    return None();
+                }
+                buffer.clear();
+                pos = 0;
+                Shard &s = owner->shards[next_shard++];
+                s.lock.read();
+                buffer.reserve(s.map.size());
+                for (const auto &kv : s.map) {
+                    buffer.push_back(Tuple<K, V>(clone(kv.first), clone(kv.second)));
+                }
+                s.lock.unlock();
+            }
+            return Some(std::move(buffer[pos++]));
+        }
+        typedef void Rev;
+    };
+
+public:
+    ConcurrentHashMap() : ConcurrentHashMap(default_shard_amount()) {}
+    // Amount of shards is rounded up to the power of two
+    explicit ConcurrentHashMap(size_t shard_amount) {
+        assert_(shard_amount > 0);
+        size_t bits = 0;
+        while ((size_t(1) << bits) < shard_amount) {
+            ++bits;
+        }
+        shard_count = size_t(1) << bits;
+        shift = 64 - bits;
+        shards.reset(new Shard[shard_count]);
+    }
+    ~ConcurrentHashMap() = default;
+
+    ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+    ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+    size_t shard_amount() const {
+        return shard_count;
+    }
+
+    Option<V> insert(K &&key, V &&value) {
+        Shard &s = shard_of(key);
+        s.lock.write();
+        Option<V> ret;
+        auto it = s.map.find(key);
+        if (it != s.map.end()) {
+            ret = Option<V>::Some(std::move(it->second));
+            it->second = std::move(value);
+        } else {
+            s.map.emplace(std::move(key), std::move(value));
+        }
+        s.lock.unlock();
+        return ret;
+    }
+    Option<V> insert(const K &key, const V &value) {
+        return insert(clone(key), clone(value));
+    }
+
+    Option<ReadGuard> get(const K &key) const {
+        Shard &s = shard_of(key);
+        s.lock.read();
+        auto it = s.map.find(key);
+        if (it != s.map.end()) {
+            return Option<ReadGuard>::Some(ReadGuard(&s.lock, &it->first, &it->second));
+        } else {
+            s.lock.unlock();
+            return Option<ReadGuard>::None();
+        }
+    }
+    Option<WriteGuard> get_mut(const K &key) {
+        Shard &s = shard_of(key);
+        s.lock.write();
+        auto it = s.map.find(key);
+        if (it != s.map.end()) {
+            return Option<WriteGuard>::Some(WriteGuard(&s.lock, &it->first, &it->second));
+        } else {
+            s.lock.unlock();
+            return Option<WriteGuard>::None();
+        }
+    }
+    bool contains_key(const K &key) const {
+        return get(key).is_some();
+    }
+
+    Entry entry(K &&key) {
+        Shard &s = shard_of(key);
+        s.lock.write();
+        return Entry(&s, std::move(key));
+    }
+    Entry entry(const K &key) {
+        return entry(clone(key));
+    }
+
+    Option<V> remove(const K &key) {
+        Shard &s = shard_of(key);
+        s.lock.write();
+        Option<V> ret;
+        auto it = s.map.find(key);
+        if (it != s.map.end()) {
+            ret = Option<V>::Some(std::move(it->second));
+            s.map.erase(it);
+        }
+        s.lock.unlock();
+        return ret;
+    }
+
+    // Result may be outdated if the map is modified concurrently
+    size_t len() const {
+        size_t n = 0;
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards[i].lock.read();
+            n += shards[i].map.size();
+            shards[i].lock.unlock();
+        }
+        return n;
+    }
+    bool is_empty() const {
+        return len() == 0;
+    }
+    void clear() {
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards[i].lock.write();
+            shards[i].map.clear();
+            shards[i].lock.unlock();
+        }
+    }
+
+    Iter iter() const {
+        return Iter(this);
+    }
+};
+
+} // namespace rstd
@@ -4,6 +4,7 @@
 #include <utility>
 #include <numeric>
 #include <algorithm>
+#include <type_traits>
 
 namespace rstd {
 
@@ -54,9 +55,21 @@ struct _Visit<S, 0> {
     static void visit(F &&) {}
 };
 
+// Assumed size of CPU cache line, used to avoid false sharing
+inline constexpr size_t cache_line_size = 64;
+
 template <typename T>
 inline constexpr bool is_copyable_v = 
     std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>;
 
+// Object of trivially relocatable type can be moved to another address by copying its bytes,
+// which is equivalent to the move construction followed by the destruction of the source.
+// Trivially copyable types are such by default, other types opt in by specializing this.
+// Containers use it to move elements with `memcpy` and `realloc`.
+template <typename T, typename=void>
+struct TriviallyRelocatable : std::is_trivially_copyable<T> {};
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = TriviallyRelocatable<T>::value;
+
 
 } // namespace rstd
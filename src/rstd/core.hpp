@@ -12,10 +12,12 @@ inline std::ostream &stderr_() { return rcore::stderr_(); }
 typedef rcore::Once Once;
 
 typedef rcore::Thread Thread;
+typedef rcore::ThreadStats ThreadStats;
 
 namespace thread {
 
 inline Thread &current() { return rcore::thread::current(); }
+inline void park() { rcore::thread::park(); }
 
 } // namespace thread
 
@@ -0,0 +1,150 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "epoch.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(epoch) {
+    struct Counted {
+        std::atomic<int> *alive;
+        explicit Counted(std::atomic<int> *a) : alive(a) {
+            *alive += 1;
+        }
+        ~Counted() {
+            *alive -= 1;
+        }
+    };
+
+    // Flushes until `alive` reaches zero or attempts are exhausted
+    bool flush_until_released(std::atomic<int> &alive) {
+        for (int i = 0; i < 100 && alive.load() > 0; ++i) {
+            epoch::pin().flush();
+        }
+        return alive.load() == 0;
+    }
+
+    rtest_(pin) {
+        assert_(!epoch::is_pinned());
+        {
+            auto g0 = epoch::pin();
+            assert_(epoch::is_pinned());
+            {
+                auto g1 = epoch::pin();
+                assert_(epoch::is_pinned());
+            }
+            assert_(epoch::is_pinned());
+        }
+        assert_(!epoch::is_pinned());
+    }
+    rtest_(defer_destroy) {
+        std::atomic<int> alive(0);
+        epoch::pin().defer_destroy(new Counted(&alive));
+        assert_(flush_until_released(alive));
+    }
+    rtest_(defer) {
+        std::atomic<int> called(1);
+        epoch::pin().defer([&called]() { called -= 1; });
+        assert_(flush_until_released(called));
+    }
+    rtest_(pinned_thread_blocks_release) {
+        std::atomic<int> alive(0);
+        std::atomic<int> stage(0);
+        auto jh = thread::spawn([&]() {
+            auto guard = epoch::pin();
+            stage = 1;
+            while (stage.load() != 2) {}
+        });
+        while (stage.load() != 1) {}
+
+        epoch::pin().defer_destroy(new Counted(&alive));
+        for (int i = 0; i < 100; ++i) {
+            epoch::pin().flush();
+        }
+        assert_eq_(alive.load(), 1);
+
+        stage = 2;
+        jh.join().unwrap();
+        assert_(flush_until_released(alive));
+    }
+    rtest_(defer_after_advance) {
+        std::atomic<int> alive(0);
+        std::atomic<int> stage(0);
+        auto guard = epoch::pin();
+        // Global epoch moves one ahead of the epoch this thread is pinned at
+        uint64_t e = rcore::epoch::__global_epoch();
+        thread::spawn([&]() {
+            while (rcore::epoch::__global_epoch() == e) {
+                epoch::pin().flush();
+            }
+        }).join().unwrap();
+        // Reader pinned at the new epoch could observe the object before it is unlinked
+        auto jh = thread::spawn([&]() {
+            auto g = epoch::pin();
+            stage = 1;
+            while (stage.load() != 2) {}
+        });
+        while (stage.load() != 1) {}
+
+        guard.defer_destroy(new Counted(&alive));
+        { auto g = std::move(guard); }
+        for (int i = 0; i < 100; ++i) {
+            epoch::pin().flush();
+        }
+        assert_eq_(alive.load(), 1);
+
+        stage = 2;
+        jh.join().unwrap();
+        assert_(flush_until_released(alive));
+    }
+    rtest_(readers_across_advance) {
+        static const uint64_t MAGIC = 0x5eed5eed5eed5eed;
+        struct Node {
+            std::atomic<uint64_t> magic{MAGIC};
+            ~Node() {
+                magic = 0;
+            }
+        };
+        std::atomic<Node *> shared(new Node());
+        std::atomic<bool> done(false);
+        std::atomic<size_t> bad(0);
+
+        std::vector<JoinHandle<>> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.push_back(thread::spawn([&]() {
+                while (!done.load()) {
+                    auto guard = epoch::pin();
+                    Node *n = shared.load(std::memory_order_acquire);
+                    // Hold the pointer while the global epoch moves on
+                    uint64_t e = rcore::epoch::__global_epoch();
+                    for (int i = 0; i < 1000 && rcore::epoch::__global_epoch() == e; ++i) {}
+                    if (n->magic.load() != MAGIC) {
+                        bad += 1;
+                    }
+                }
+            }));
+        }
+        for (int i = 0; i < 20000; ++i) {
+            // Advancing the epoch while pinned makes the pinned epoch of the writer stale
+            auto guard = epoch::pin();
+            guard.flush();
+            guard.defer_destroy(shared.exchange(new Node(), std::memory_order_acq_rel));
+        }
+        done = true;
+        for (auto &jh : readers) {
+            jh.join().unwrap();
+        }
+        delete shared.load();
+        assert_eq_(bad.load(), size_t(0));
+    }
+    rtest_(exited_thread_garbage) {
+        std::atomic<int> alive(0);
+        thread::spawn([&]() {
+            epoch::pin().defer_destroy(new Counted(&alive));
+        }).join().unwrap();
+        assert_(flush_until_released(alive));
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <rcore/epoch.hpp>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+namespace epoch {
+
+typedef rcore::epoch::Guard Guard;
+
+// Pins current thread. Pointers loaded from epoch-protected structures
+// stay valid until the returned guard is destroyed.
+inline Guard pin() {
+    return rcore::epoch::pin();
+}
+inline bool is_pinned() {
+    return rcore::epoch::is_pinned();
+}
+
+} // namespace epoch
+
+} // namespace rstd
@@ -0,0 +1,120 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "executor.hpp"
+
+using namespace rstd;
+
+
+// Future that completes after it was woken `n` times from another thread
+class RemoteCounter final : public Future<int, RemoteCounter> {
+private:
+    int remaining;
+    Option<rstd::JoinHandle<>> helper;
+public:
+    explicit RemoteCounter(int n) : remaining(n) {}
+    Poll<int> poll(Context &cx) {
+        if (helper.is_some()) {
+            helper.take_some().join().unwrap();
+        }
+        if (remaining == 0) {
+            return Ready(0);
+        }
+        remaining -= 1;
+        Waker waker = cx.waker();
+        helper = Option<rstd::JoinHandle<>>::Some(thread::spawn([waker]() {
+            waker.wake();
+        }));
+        return Pending();
+    }
+};
+
+rtest_module_(executor) {
+    rtest_(block_on) {
+        assert_eq_(executor::block_on(future::ready(42)), 42);
+        assert_eq_(executor::block_on(RemoteCounter(4)), 0);
+    }
+    rtest_(local_pool) {
+        executor::LocalPool pool;
+        int counter = 0;
+        std::vector<executor::JoinHandle<int>> handles;
+        for (int i = 0; i < 16; ++i) {
+            handles.push_back(pool.spawn(
+                future::yield_now().map([&counter, i](Tuple<>) {
+                    counter += 1;
+                    return i;
+                })
+            ));
+        }
+        pool.run();
+        assert_eq_(counter, 16);
+        for (int i = 0; i < 16; ++i) {
+            assert_eq_(executor::block_on(std::move(handles[i])).unwrap(), i);
+        }
+    }
+    rtest_(local_pool_run_until) {
+        executor::LocalPool pool;
+        auto handle = pool.spawn(RemoteCounter(3).map([](int x) { return x + 1; }));
+        assert_eq_(pool.run_until(std::move(handle)).unwrap(), 1);
+    }
+    rtest_(local_pool_cancel) {
+        executor::JoinHandle<int> handle = [&]() {
+            executor::LocalPool pool;
+            auto handle = pool.spawn(future::pending<int>());
+            pool.run_until_stalled();
+            return handle;
+        }();
+        auto res = executor::block_on(std::move(handle));
+        assert_(res.is_err());
+        res.clear();
+    }
+    rtest_(thread_pool) {
+        const int tasks = 64;
+        std::atomic<int> counter(0);
+        std::vector<executor::JoinHandle<int>> handles;
+        {
+            executor::ThreadPool pool(4);
+            assert_eq_(pool.size(), size_t(4));
+            for (int i = 0; i < tasks; ++i) {
+                handles.push_back(pool.spawn(
+                    future::yield_now()
+                    .then([](Tuple<>) { return future::yield_now(); })
+                    .map([&counter, i](Tuple<>) {
+                        counter += 1;
+                        return i * i;
+                    })
+                ));
+            }
+            for (int i = 0; i < tasks; ++i) {
+                assert_eq_(handles[i].join().unwrap(), i * i);
+            }
+        }
+        assert_eq_(counter.load(), tasks);
+    }
+    rtest_(thread_pool_panic) {
+        executor::ThreadPool pool(2);
+        auto handle = pool.spawn(future::lazy([]() -> int {
+            panic_("Task panic");
+            return 0;
+        }));
+        auto res = handle.join();
+        assert_(res.is_err());
+        res.clear();
+        // The other worker is still alive
+        assert_eq_(pool.spawn(future::ready(1)).join().unwrap(), 1);
+    }
+    rtest_(thread_pool_panic_all_workers) {
+        executor::ThreadPool pool(2);
+        // More panics than workers, each panicked worker is replaced
+        for (size_t i = 0; i < pool.size() + 1; ++i) {
+            auto res = pool.spawn(future::lazy([]() -> int {
+                panic_("Task panic");
+                return 0;
+            })).join();
+            assert_(res.is_err());
+            res.clear();
+        }
+        assert_eq_(pool.spawn(future::ready(1)).join().unwrap(), 1);
+    }
+}
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <rstd/prelude.hpp>
+#include "future.hpp"
+
+
+namespace rstd {
+namespace executor {
+
+// Polls the future on the current thread until it completes, parking the thread while it's pending.
+template <typename F, typename T=future_output<F>>
+T block_on(F &&fut) {
+    class ThreadWaker final : public Waker::Target {
+    private:
+        Thread thread_;
+    public:
+        explicit ThreadWaker(const Thread &t) : thread_(t) {}
+        void wake() override {
+            thread_.unpark();
+        }
+    };
+
+    F f(std::move(fut));
+    Waker waker(std::make_shared<ThreadWaker>(thread::current()));
+    Context cx(waker);
+    for (;;) {
+        Poll<T> p = f.poll(cx);
+        if (p.is_ready()) {
+            return p.unwrap();
+        }
+        thread::park();
+    }
+}
+
+class __TaskBase;
+
+// Queue of tasks ready to be polled. Shared between executor and wakers of its tasks.
+class __TaskQueue final {
+private:
+    Mutex<std::deque<std::shared_ptr<__TaskBase>>> queue;
+    Mutex<std::vector<std::weak_ptr<__TaskBase>>> tasks;
+    Semaphore ready{0};
+    std::atomic<bool> closed{false};
+
+public:
+    void push(std::shared_ptr<__TaskBase> task) {
+        if (closed.load(std::memory_order_acquire)) {
+            return;
+        }
+        queue.lock()->push_back(std::move(task));
+        ready.release();
+    }
+    // Blocks until a task is available. Returns `nullptr` on wake-up without a task.
+    std::shared_ptr<__TaskBase> pop() {
+        ready.acquire();
+        auto guard = queue.lock();
+        if (guard->empty()) {
+            return nullptr;
+        }
+        auto task = std::move(guard->front());
+        guard->pop_front();
+        return task;
+    }
+    Option<std::shared_ptr<__TaskBase>> try_pop() {
+        if (!ready.try_acquire()) {
+            return None();
+        }
+        auto guard = queue.lock();
+        if (guard->empty()) {
+            return None();
+        }
+        auto task = std::move(guard->front());
+        guard->pop_front();
+        return Some(std::move(task));
+    }
+    // Wakes up `n` threads blocked in `pop`
+    void notify(uint32_t n) {
+        ready.release(n);
+    }
+
+    void register_task(const std::shared_ptr<__TaskBase> &task) {
+        auto guard = tasks.lock();
+        // Remove finished tasks from time to time
+        if (guard->size() >= 64 && (guard->size() & (guard->size() - 1)) == 0) {
+            std::vector<std::weak_ptr<__TaskBase>> alive;
+            for (auto &t : *guard) {
+                if (!t.expired()) {
+                    alive.push_back(std::move(t));
+                }
+            }
+            *guard = std::move(alive);
+        }
+        guard->push_back(task);
+    }
+    // Stops accepting tasks, so woken tasks aren't scheduled anymore
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+    // Drops the queue and cancels all unfinished tasks. Must be called when no task is running.
+    inline void cancel_all();
+};
+
+class __TaskBase : public Waker::Target, public std::enable_shared_from_this<__TaskBase> {
+private:
+    static const uint32_t IDLE = 0;
+    static const uint32_t SCHEDULED = 1;
+    static const uint32_t RUNNING = 2;
+    // Woken while running, must be polled again
+    static const uint32_t NOTIFIED = 3;
+    static const uint32_t DONE = 4;
+
+    std::atomic<uint32_t> state{IDLE};
+    std::shared_ptr<__TaskQueue> queue;
+
+protected:
+    // Returns `true` when the future is complete
+    virtual bool poll(Context &cx) = 0;
+    // Resolves the task output with an error, optionally dropping the future
+    virtual void cancel_output(bool drop_future) = 0;
+
+public:
+    explicit __TaskBase(std::shared_ptr<__TaskQueue> q) : queue(std::move(q)) {}
+    virtual ~__TaskBase() = default;
+
+    void wake() override {
+        uint32_t s = state.load(std::memory_order_acquire);
+        for (;;) {
+            if (s == IDLE) {
+                if (state.compare_exchange_weak(s, SCHEDULED, std::memory_order_acq_rel)) {
+                    queue->push(shared_from_this());
+                    return;
+                }
+            } else if (s == RUNNING) {
+                if (state.compare_exchange_weak(s, NOTIFIED, std::memory_order_acq_rel)) {
+                    return;
+                }
+            } else {
+                return;
+            }
+        }
+    }
+    void schedule() {
+        wake();
+    }
+
+    // Polls the task once. Returns `true` if the task has been completed by this call.
+    bool run() {
+        uint32_t s = SCHEDULED;
+        if (!state.compare_exchange_strong(s, RUNNING, std::memory_order_acq_rel)) {
+            return false;
+        }
+        Waker waker(shared_from_this());
+        Context cx(waker);
+        if (poll(cx)) {
+            state.store(DONE, std::memory_order_release);
+            return true;
+        }
+        s = RUNNING;
+        if (!state.compare_exchange_strong(s, IDLE, std::memory_order_acq_rel)) {
+            // Woken during the poll
+            state.store(SCHEDULED, std::memory_order_release);
+            queue->push(shared_from_this());
+        }
+        return false;
+    }
+
+    void cancel() {
+        if (state.exchange(DONE, std::memory_order_acq_rel) != DONE) {
+            cancel_output(true);
+        }
+    }
+    // Called when the thread has panicked while polling the task.
+    // The future is left untouched because its state is unknown.
+    void abort() {
+        state.store(DONE, std::memory_order_release);
+        cancel_output(false);
+    }
+};
+
+void __TaskQueue::cancel_all() {
+    drop(*queue.lock());
+    std::vector<std::weak_ptr<__TaskBase>> list = std::move(*tasks.lock());
+    for (auto &t : list) {
+        if (auto task = t.lock()) {
+            task->cancel();
+        }
+    }
+}
+
+// Storage for the output of a task shared with its `JoinHandle`
+template <typename T>
+class __TaskOutput final {
+private:
+    struct State {
+        bool finished = false;
+        // `None` if the task was cancelled
+        Option<T> value;
+        Option<Waker> waiter;
+    };
+    Mutex<State> state;
+
+public:
+    void complete(Option<T> &&value) {
+        Option<Waker> waiter;
+        {
+            auto guard = state.lock();
+            if (guard->finished) {
+                return;
+            }
+            guard->finished = true;
+            guard->value = std::move(value);
+            waiter = guard->waiter.take();
+        }
+        if (waiter.is_some()) {
+            waiter.get().wake();
+        }
+    }
+    Poll<Result<T>> poll(Context &cx) {
+        auto guard = state.lock();
+        if (guard->finished) {
+            if (guard->value.is_some()) {
+                return Poll<Result<T>>::Ready(Result<T>::Ok(guard->value.take_some()));
+            } else {
+                return Poll<Result<T>>::Ready(Result<T>::Err(Tuple<>()));
+            }
+        }
+        guard->waiter = Option<Waker>::Some(cx.waker());
+        return Pending();
+    }
+};
+
+template <typename F, typename T>
+class __Task final : public __TaskBase {
+private:
+    std::optional<F> future;
+    std::shared_ptr<__TaskOutput<T>> output;
+
+protected:
+    bool poll(Context &cx) override {
+        Poll<T> p = future->poll(cx);
+        if (p.is_ready()) {
+            // Drop the future first to release everything it holds
+            future.reset();
+            output->complete(Option<T>::Some(p.unwrap()));
+            return true;
+        }
+        return false;
+    }
+    void cancel_output(bool drop_future) override {
+        if (drop_future) {
+            future.reset();
+        }
+        output->complete(Option<T>::None());
+    }
+
+public:
+    __Task(std::shared_ptr<__TaskQueue> q, F &&f, std::shared_ptr<__TaskOutput<T>> o) :
+        __TaskBase(std::move(q)), output(std::move(o))
+    {
+        future.emplace(std::move(f));
+    }
+    ~__Task() override {
+        output->complete(Option<T>::None());
+    }
+};
+
+// Handle to the spawned task. It's a future itself that resolves into `Ok` with the task output
+// or `Err` if the task was cancelled (e.g. the executor was destroyed before the task completed).
+// Dropping the handle detaches the task.
+template <typename T=Tuple<>>
+class JoinHandle final : public Future<Result<T>, JoinHandle<T>> {
+private:
+    std::shared_ptr<__TaskOutput<T>> output;
+
+public:
+    explicit JoinHandle(std::shared_ptr<__TaskOutput<T>> o) : output(std::move(o)) {}
+
+    Poll<Result<T>> poll(Context &cx) {
+        return output->poll(cx);
+    }
+    // Blocks current thread until the task is complete
+    Result<T> join() {
+        return block_on(std::move(*this));
+    }
+};
+
+template <typename F, typename T>
+JoinHandle<T> __spawn(const std::shared_ptr<__TaskQueue> &queue, F &&fut) {
+    auto output = std::make_shared<__TaskOutput<T>>();
+    std::shared_ptr<__TaskBase> task = std::make_shared<__Task<F, T>>(queue, std::move(fut), output);
+    queue->register_task(task);
+    task->schedule();
+    return JoinHandle<T>(std::move(output));
+}
+
+// Single-threaded executor. Tasks are polled only on the thread that runs the pool.
+// Wakers may be used from any thread.
+class LocalPool final {
+private:
+    // Wakes up the pool thread
+    class PoolWaker final : public Waker::Target {
+    private:
+        std::shared_ptr<__TaskQueue> queue;
+    public:
+        std::atomic<bool> woken{true};
+        explicit PoolWaker(std::shared_ptr<__TaskQueue> q) : queue(std::move(q)) {}
+        void wake() override {
+            woken.store(true);
+            queue->notify(1);
+        }
+    };
+
+    std::shared_ptr<__TaskQueue> queue;
+    size_t active = 0;
+
+    void run_task(std::shared_ptr<__TaskBase> &&task) {
+        if (task && task->run()) {
+            active -= 1;
+        }
+    }
+
+public:
+    LocalPool() : queue(std::make_shared<__TaskQueue>()) {}
+    ~LocalPool() {
+        queue->close();
+        queue->cancel_all();
+    }
+
+    LocalPool(const LocalPool &) = delete;
+    LocalPool &operator=(const LocalPool &) = delete;
+
+    template <typename F, typename T=future_output<F>>
+    JoinHandle<T> spawn(F &&fut) {
+        active += 1;
+        return __spawn<F, T>(queue, std::move(fut));
+    }
+
+    // Runs tasks until all of them are complete
+    void run() {
+        while (active > 0) {
+            run_task(queue->pop());
+        }
+    }
+    // Runs tasks until there are no tasks ready to be polled
+    void run_until_stalled() {
+        for (;;) {
+            auto task = queue->try_pop();
+            if (task.is_none()) {
+                break;
+            }
+            run_task(task.unwrap());
+        }
+    }
+    // Runs tasks until `fut` is complete and returns its output.
+    // `fut` itself is polled on the current thread.
+    template <typename F, typename T=future_output<F>>
+    T run_until(F &&fut) {
+        F f(std::move(fut));
+        auto target = std::make_shared<PoolWaker>(queue);
+        Waker waker(target);
+        Context cx(waker);
+        for (;;) {
+            if (target->woken.exchange(false)) {
+                Poll<T> p = f.poll(cx);
+                if (p.is_ready()) {
+                    return p.unwrap();
+                }
+            }
+            run_task(queue->pop());
+        }
+    }
+};
+
+// Multi-threaded executor with fixed amount of worker threads.
+// If a task panics then its worker thread is terminated and replaced with a new one,
+// and the task `JoinHandle` resolves into `Err`.
+class ThreadPool final {
+private:
+    struct Worker {
+        ThreadPool *pool;
+        size_t index;
+        __TaskBase *task;
+    };
+
+    std::shared_ptr<__TaskQueue> queue;
+    size_t size_;
+    // Handles of all spawned workers including the terminated ones, replacements are appended
+    Mutex<std::vector<rstd::JoinHandle<>>> workers;
+
+    // Called when the running task panics and terminates the worker thread
+    static void replace_worker(void *worker) {
+        Worker *w = (Worker *)worker;
+        w->task->abort();
+        w->pool->spawn_worker(w->index);
+    }
+    void spawn_worker(size_t index) {
+        ThreadPool *pool = this;
+        auto handle = thread::Builder()
+        .name(format_("pool-worker-{}", index))
+        .spawn([pool, index]() {
+            Worker w{pool, index, nullptr};
+            for (;;) {
+                auto task = pool->queue->pop();
+                if (!task) {
+                    break;
+                }
+                w.task = task.get();
+                pthread_cleanup_push(replace_worker, (void *)&w);
+                task->run();
+                pthread_cleanup_pop(0);
+            }
+        });
+        workers.lock()->push_back(std::move(handle));
+    }
+
+public:
+    explicit ThreadPool(size_t size) : queue(std::make_shared<__TaskQueue>()), size_(size) {
+        assert_(size > 0);
+        for (size_t i = 0; i < size; ++i) {
+            spawn_worker(i);
+        }
+    }
+    // Tasks that are already scheduled are polled once more, then unfinished tasks are cancelled
+    ~ThreadPool() {
+        queue->close();
+        queue->notify(uint32_t(size_));
+        // A worker appends its replacement before it terminates,
+        // so the list is empty only when all workers are joined
+        for (;;) {
+            rstd::JoinHandle<> w;
+            {
+                auto guard = workers.lock();
+                if (guard->empty()) {
+                    break;
+                }
+                w = std::move(guard->back());
+                guard->pop_back();
+            }
+            w.join().clear();
+        }
+        queue->cancel_all();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const {
+        return size_;
+    }
+
+    template <typename F, typename T=future_output<F>>
+    JoinHandle<T> spawn(F &&fut) {
+        return __spawn<F, T>(queue, std::move(fut));
+    }
+};
+
+} // namespace executor
+} // namespace rstd
@@ -0,0 +1,82 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <memory>
+#include "future.hpp"
+
+using namespace rstd;
+
+
+class CountingWaker final : public Waker::Target {
+public:
+    std::atomic<int> count{0};
+    void wake() override {
+        count += 1;
+    }
+};
+
+rtest_module_(future) {
+    rtest_(ready) {
+        auto target = std::make_shared<CountingWaker>();
+        Waker waker(target);
+        Context cx(waker);
+
+        auto fut = future::ready(123);
+        assert_eq_(fut.poll(cx).unwrap(), 123);
+    }
+    rtest_(map_then) {
+        auto target = std::make_shared<CountingWaker>();
+        Waker waker(target);
+        Context cx(waker);
+
+        auto fut = future::ready(2)
+            .map([](int x) { return x * 10; })
+            .then([](int x) { return future::ready(x + 1); });
+        assert_eq_(fut.poll(cx).unwrap(), 21);
+    }
+    rtest_(and_then) {
+        auto target = std::make_shared<CountingWaker>();
+        Waker waker(target);
+        Context cx(waker);
+
+        auto ok = future::ready(Result<int, int>::Ok(1))
+            .and_then([](int x) { return future::ready(Result<int, int>::Ok(x + 1)); });
+        assert_eq_(ok.poll(cx).unwrap().unwrap(), 2);
+
+        auto err = future::ready(Result<int, int>::Err(-1))
+            .and_then([](int x) { return future::ready(Result<int, int>::Ok(x + 1)); });
+        assert_eq_(err.poll(cx).unwrap().unwrap_err(), -1);
+    }
+    rtest_(poll_fn_join) {
+        auto target = std::make_shared<CountingWaker>();
+        Waker waker(target);
+        Context cx(waker);
+
+        int counter = 0;
+        auto fut = future::poll_fn([&counter](Context &cx) -> Poll<int> {
+            counter += 1;
+            if (counter < 3) {
+                cx.waker().wake();
+                return Pending();
+            }
+            return Ready(counter);
+        }).join(future::lazy([]() { return 'x'; }));
+
+        assert_(fut.poll(cx).is_pending());
+        assert_(fut.poll(cx).is_pending());
+        auto out = fut.poll(cx).unwrap();
+        assert_eq_(out.get<0>(), 3);
+        assert_eq_(out.get<1>(), 'x');
+        assert_eq_(target->count.load(), 2);
+    }
+    rtest_(yield_now) {
+        auto target = std::make_shared<CountingWaker>();
+        Waker waker(target);
+        Context cx(waker);
+
+        auto fut = future::yield_now();
+        assert_(fut.poll(cx).is_pending());
+        assert_eq_(target->count.load(), 1);
+        assert_(fut.poll(cx).is_ready());
+    }
+}
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <rstd/prelude.hpp>
+
+
+namespace rstd {
+
+struct _Pending {};
+
+// Result of polling a future: either ready value or nothing yet.
+template <typename T=Tuple<>>
+class Poll final {
+private:
+    Option<T> value;
+
+    explicit Poll(Option<T> &&v) : value(std::move(v)) {}
+
+public:
+    Poll(_Pending) {}
+
+    Poll(const Poll &) = default;
+    Poll &operator=(const Poll &) = default;
+    Poll(Poll &&) = default;
+    Poll &operator=(Poll &&) = default;
+
+    static Poll Ready(T &&x) { return Poll(Option<T>::Some(std::move(x))); }
+    static Poll Ready(const T &x) { return Poll(Option<T>::Some(x)); }
+    static Poll Pending() { return Poll(Option<T>::None()); }
+
+    bool is_ready() const {
+        return value.is_some();
+    }
+    bool is_pending() const {
+        return value.is_none();
+    }
+
+    T unwrap() {
+        if (!is_ready()) {
+            panic_("Poll is Pending");
+        }
+        return value.unwrap();
+    }
+    Option<T> into_option() {
+        return std::move(value);
+    }
+
+    template <
+        typename F,
+        typename U=std::invoke_result_t<F, T &&>
+    >
+    Poll<U> map(F f) {
+        if (is_ready()) {
+            return Poll<U>::Ready(f(value.unwrap()));
+        } else {
+            return Poll<U>::Pending();
+        }
+    }
+};
+
+template <typename T>
+Poll<T> Ready(T &&t) {
+    return Poll<T>::Ready(std::move(t));
+}
+template <typename T>
+Poll<T> Ready(const T &t) {
+    return Poll<T>::Ready(t);
+}
+template <typename T>
+Poll<T> Ready(T &t) {
+    return Poll<T>::Ready(clone(t));
+}
+inline _Pending Pending() {
+    return _Pending();
+}
+
+// Handle that notifies the executor that the task is ready to be polled again.
+class Waker final {
+public:
+    class Target {
+    public:
+        virtual ~Target() = default;
+        virtual void wake() = 0;
+    };
+
+private:
+    std::shared_ptr<Target> target;
+
+public:
+    explicit Waker(std::shared_ptr<Target> t) : target(std::move(t)) {
+        assert_(bool(target));
+    }
+
+    Waker(const Waker &) = default;
+    Waker &operator=(const Waker &) = default;
+    Waker(Waker &&) = default;
+    Waker &operator=(Waker &&) = default;
+
+    void wake() const {
+        target->wake();
+    }
+    bool will_wake(const Waker &other) const {
+        return target == other.target;
+    }
+};
+
+class Context final {
+private:
+    const Waker *waker_;
+
+public:
+    explicit Context(const Waker &w) : waker_(&w) {}
+
+    Context(const Context &) = delete;
+    Context &operator=(const Context &) = delete;
+
+    const Waker &waker() const {
+        return *waker_;
+    }
+};
+
+template <typename F>
+struct FutureOutput {
+    typedef decltype(std::declval<F &>().poll(std::declval<Context &>()).unwrap()) type;
+};
+template <typename F>
+using future_output = typename FutureOutput<F>::type;
+
+template <typename T>
+struct _ResultTypes;
+template <typename T, typename E>
+struct _ResultTypes<Result<T, E>> {
+    typedef T ok;
+    typedef E err;
+};
+
+namespace future {
+
+template <typename T, typename I, typename F, typename R=std::invoke_result_t<F, T &&>>
+class Map;
+
+template <typename T, typename I, typename F, typename J=std::invoke_result_t<F, T &&>>
+class Then;
+
+template <typename T, typename I, typename F, typename J>
+class AndThen;
+
+template <typename T, typename U, typename I, typename J>
+class Join;
+
+} // namespace future
+
+// Asynchronous computation that produces a value of type `T`.
+// `Self` must provide `Poll<T> poll(Context &)` method.
+template <typename T, typename Self>
+class Future {
+private:
+    Self &self() { return *static_cast<Self *>(this); }
+
+public:
+    typedef T Output;
+
+    template <typename F>
+    future::Map<T, Self, F> map(F &&f) {
+        return future::Map<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // `f` returns another future which output becomes the output of the resulting future
+    template <typename F>
+    future::Then<T, Self, F> then(F &&f) {
+        return future::Then<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // For `Result` outputs: chains `f` returning a future of `Result` if the output is `Ok`
+    template <typename F, typename R=T, typename J=std::invoke_result_t<F, typename _ResultTypes<R>::ok &&>>
+    future::AndThen<T, Self, F, J> and_then(F &&f) {
+        return future::AndThen<T, Self, F, J>(std::move(self()), std::move(f));
+    }
+    template <typename F>
+    decltype(auto) map_ok(F &&f) {
+        return self().map([f](T &&r) { return r.map(f); });
+    }
+    template <typename F>
+    decltype(auto) map_err(F &&f) {
+        return self().map([f](T &&r) { return r.map_err(f); });
+    }
+    // For `Option` outputs: converts `None` into `Err(e)`
+    template <typename E>
+    decltype(auto) ok_or(E &&e) {
+        typedef option_some_type<T> U;
+        return self().map([e](T &&o) mutable {
+            if (o.is_some()) {
+                return Result<U, E>::Ok(o.unwrap());
+            } else {
+                return Result<U, E>::Err(std::move(e));
+            }
+        });
+    }
+    template <typename J, typename U=future_output<J>>
+    future::Join<T, U, Self, J> join(J &&other) {
+        return future::Join<T, U, Self, J>(std::move(self()), std::move(other));
+    }
+};
+
+namespace future {
+
+template <typename T, typename I, typename F, typename R>
+class Map final : public Future<R, Map<T, I, F, R>> {
+private:
+    I inner;
+    F func;
+public:
+    Map(I &&i, F &&f) : inner(std::move(i)), func(std::move(f)) {}
+    Poll<R> poll(Context &cx) {
+        Poll<T> p = inner.poll(cx);
+        if (p.is_ready()) {
+            return Poll<R>::Ready(func(p.unwrap()));
+        } else {
+            return rstd::Pending();
+        }
+    }
+};
+
+template <typename T, typename I, typename F, typename J>
+class Then final : public Future<future_output<J>, Then<T, I, F, J>> {
+private:
+    typedef future_output<J> R;
+    Option<I> first;
+    F func;
+    // Constructed in-place because futures are not required to be assignable
+    std::optional<J> second;
+public:
+    Then(I &&i, F &&f) :
+        first(Option<I>::Some(std::move(i))),
+        func(std::move(f))
+    {}
+    Poll<R> poll(Context &cx) {
+        if (first.is_some()) {
+            Poll<T> p = first.get().poll(cx);
+            if (p.is_pending()) {
+                return rstd::Pending();
+            }
+            drop(first);
+            second.emplace(func(p.unwrap()));
+        }
+        return second->poll(cx);
+    }
+};
+
+template <typename T, typename I, typename F, typename J>
+class AndThen final : public Future<future_output<J>, AndThen<T, I, F, J>> {
+private:
+    typedef future_output<J> R;
+    Option<I> first;
+    F func;
+    // Constructed in-place because futures are not required to be assignable
+    std::optional<J> second;
+public:
+    AndThen(I &&i, F &&f) :
+        first(Option<I>::Some(std::move(i))),
+        func(std::move(f))
+    {}
+    Poll<R> poll(Context &cx) {
+        if (first.is_some()) {
+            Poll<T> p = first.get().poll(cx);
+            if (p.is_pending()) {
+                return rstd::Pending();
+            }
+            drop(first);
+            T res = p.unwrap();
+            if (res.is_err()) {
+                return Poll<R>::Ready(R::Err(res.unwrap_err()));
+            }
+            second.emplace(func(res.unwrap()));
+        }
+        return second->poll(cx);
+    }
+};
+
+template <typename T, typename U, typename I, typename J>
+class Join final : public Future<Tuple<T, U>, Join<T, U, I, J>> {
+private:
+    I first;
+    J second;
+    Option<T> first_out;
+    Option<U> second_out;
+public:
+    Join(I &&i, J &&j) : first(std::move(i)), second(std::move(j)) {}
+    Poll<Tuple<T, U>> poll(Context &cx) {
+        if (first_out.is_none()) {
+            first_out = first.poll(cx).into_option();
+        }
+        if (second_out.is_none()) {
+            second_out = second.poll(cx).into_option();
+        }
+        if (first_out.is_some() && second_out.is_some()) {
+            return Poll<Tuple<T, U>>::Ready(Tuple<T, U>(first_out.unwrap(), second_out.unwrap()));
+        } else {
+            return rstd::Pending();
+        }
+    }
+};
+
+// Future that is immediately ready with a value
+template <typename T>
+class Ready final : public Future<T, Ready<T>> {
+private:
+    Option<T> value;
+public:
+    explicit Ready(T &&v) : value(Option<T>::Some(std::move(v))) {}
+    Poll<T> poll(Context &) {
+        return Poll<T>::Ready(value.expect("Ready polled after completion"));
+    }
+};
+template <typename T>
+Ready<T> ready(T &&t) {
+    return Ready<T>(std::move(t));
+}
+
+// Future that never resolves
+template <typename T>
+class Pending final : public Future<T, Pending<T>> {
+public:
+    Poll<T> poll(Context &) {
+        return rstd::Pending();
+    }
+};
+template <typename T>
+Pending<T> pending() {
+    return Pending<T>();
+}
+
+// Future that calls `f(cx)` on each poll
+template <typename F, typename R=decltype(std::declval<F &>()(std::declval<Context &>()).unwrap())>
+class PollFn final : public Future<R, PollFn<F, R>> {
+private:
+    F func;
+public:
+    explicit PollFn(F &&f) : func(std::move(f)) {}
+    Poll<R> poll(Context &cx) {
+        return func(cx);
+    }
+};
+template <typename F>
+PollFn<F> poll_fn(F &&f) {
+    return PollFn<F>(std::move(f));
+}
+
+// Future that calls `f()` on the first poll and is immediately ready with its result
+template <typename F, typename R=std::invoke_result_t<F>>
+class Lazy final : public Future<R, Lazy<F, R>> {
+private:
+    Option<F> func;
+public:
+    explicit Lazy(F &&f) : func(Option<F>::Some(std::move(f))) {}
+    Poll<R> poll(Context &) {
+        return Poll<R>::Ready(func.expect("Lazy polled after completion")());
+    }
+};
+template <typename F>
+Lazy<F> lazy(F &&f) {
+    return Lazy<F>(std::move(f));
+}
+
+// Future that returns `Pending` once (waking itself immediately) and then completes
+class YieldNow final : public Future<Tuple<>, YieldNow> {
+private:
+    bool yielded = false;
+public:
+    Poll<Tuple<>> poll(Context &cx) {
+        if (yielded) {
+            return Poll<Tuple<>>::Ready(Tuple<>());
+        }
+        yielded = true;
+        cx.waker().wake();
+        return rstd::Pending();
+    }
+};
+inline YieldNow yield_now() {
+    return YieldNow();
+}
+
+} // namespace future
+
+} // namespace rstd
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "future.hpp"
+#include "executor.hpp"
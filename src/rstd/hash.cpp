@@ -0,0 +1,214 @@
+#include <rtest.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "hash_map.hpp"
+
+using namespace rstd;
+
+
+uint64_t wyhash(const std::string &s, uint64_t seed) {
+    return WyHasher::hash_bytes(reinterpret_cast<const uint8_t *>(s.data()), s.size(), seed);
+}
+template <typename H>
+uint64_t hash_u64(uint64_t x, H hasher=H()) {
+    hasher.write_u64(x);
+    return hasher.finish();
+}
+
+// Largest deviation from 1/2 of the probability that flipping an input bit flips an output bit
+template <typename F>
+double avalanche_bias(F &&hash, size_t bits, size_t samples) {
+    std::mt19937_64 rng(7);
+    std::vector<size_t> flips(bits * 64, 0);
+    std::vector<uint8_t> key((bits + 7) / 8);
+    for (size_t n = 0; n < samples; ++n) {
+        for (uint8_t &b : key) {
+            b = uint8_t(rng());
+        }
+        uint64_t h = hash(key);
+        for (size_t i = 0; i < bits; ++i) {
+            key[i / 8] ^= uint8_t(1 << (i % 8));
+            uint64_t d = h ^ hash(key);
+            key[i / 8] ^= uint8_t(1 << (i % 8));
+            for (size_t j = 0; j < 64; ++j) {
+                flips[i * 64 + j] += (d >> j) & 1;
+            }
+        }
+    }
+    double bias = 0.0;
+    for (size_t f : flips) {
+        bias = std::max(bias, std::abs(double(f) / double(samples) - 0.5));
+    }
+    return bias;
+}
+
+// Hashes of all 64-bit words with at most 2 bits set, which should all be different
+template <typename H>
+size_t sparse_collisions() {
+    std::vector<uint64_t> hashes;
+    hashes.push_back(hash_u64<H>(0));
+    for (size_t i = 0; i < 64; ++i) {
+        hashes.push_back(hash_u64<H>(uint64_t(1) << i));
+        for (size_t j = i + 1; j < 64; ++j) {
+            hashes.push_back(hash_u64<H>((uint64_t(1) << i) | (uint64_t(1) << j)));
+        }
+    }
+    std::sort(hashes.begin(), hashes.end());
+    size_t distinct = size_t(std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+    return hashes.size() - distinct;
+}
+
+rtest_module_(hash) {
+    rtest_(wyhash_vectors) {
+        // Test vectors of the reference implementation
+        assert_eq_(wyhash("", 0), uint64_t(0x0409638ee2bde459));
+        assert_eq_(wyhash("a", 1), uint64_t(0xa8412d091b5fe0a9));
+        assert_eq_(wyhash("abc", 2), uint64_t(0x32dd92e4b2915153));
+        assert_eq_(wyhash("message digest", 3), uint64_t(0x8619124089a3a16b));
+        assert_eq_(wyhash("abcdefghijklmnopqrstuvwxyz", 4), uint64_t(0x7a43afb61d7f5f40));
+        assert_eq_(
+            wyhash("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 5),
+            uint64_t(0xff42329b90e50d58)
+        );
+        assert_eq_(
+            wyhash("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 6),
+            uint64_t(0xc39cab13b115aad3)
+        );
+    }
+    rtest_(siphash_vectors) {
+        // Test vectors of the SipHash paper: key `00 01 .. 0f`, message `00 01 .. (n - 1)`
+        const uint64_t k0 = 0x0706050403020100, k1 = 0x0f0e0d0c0b0a0908;
+        uint8_t msg[64];
+        for (size_t i = 0; i < 64; ++i) {
+            msg[i] = uint8_t(i);
+        }
+        auto sip = [&](size_t n) {
+            SipHasher24 h(k0, k1);
+            h.write(msg, n);
+            return h.finish();
+        };
+        assert_eq_(sip(0), uint64_t(0x726fdb47dd0e0e31));
+        assert_eq_(sip(1), uint64_t(0x74f839c593dc67fd));
+        assert_eq_(sip(15), uint64_t(0xa129ca6149be45e5));
+
+        // Streaming gives the same result for any split
+        for (size_t n = 0; n <= 64; ++n) {
+            for (size_t split : {size_t(0), size_t(1), size_t(3), size_t(8), size_t(13)}) {
+                size_t m = std::min(split, n);
+                SipHasher13 a(k0, k1), b(k0, k1);
+                a.write(msg, n);
+                b.write(msg, m);
+                b.write(msg + m, n - m);
+                assert_eq_(a.finish(), b.finish());
+            }
+        }
+        SipHasher13 w(k0, k1), bytes(k0, k1);
+        w.write_u8(1);
+        w.write_u64(0x1122334455667788);
+        uint8_t le[16] = {1, 0, 0, 0, 0, 0, 0, 0, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11};
+        bytes.write(le, 16);
+        assert_eq_(w.finish(), bytes.finish());
+
+        // Keys change the result, default keys are the same within a process
+        assert_(hash_u64(1, SipHasher13(1, 2)) != hash_u64(1, SipHasher13(1, 3)));
+        assert_eq_(hash_u64<SipHasher13>(1), hash_u64<SipHasher13>(1));
+    }
+    rtest_(fxhash) {
+        assert_eq_(hash_u64<FxHasher>(1), uint64_t(0x517cc1b727220a95));
+        FxHasher h;
+        h.write(reinterpret_cast<const uint8_t *>("abcdefgh"), 8);
+        assert_eq_(h.finish(), hash_u64<FxHasher>(0x6867666564636261));
+    }
+    rtest_(avalanche) {
+        auto wy_word = [](const std::vector<uint8_t> &k) {
+            uint64_t x;
+            std::memcpy(&x, k.data(), 8);
+            return hash_u64<WyHasher>(x);
+        };
+        auto wy_bytes = [](const std::vector<uint8_t> &k) {
+            WyHasher h;
+            h.write(k.data(), k.size());
+            return h.finish();
+        };
+        auto sip_word = [](const std::vector<uint8_t> &k) {
+            uint64_t x;
+            std::memcpy(&x, k.data(), 8);
+            return hash_u64(x, SipHasher13(3, 4));
+        };
+        // Expected deviation is about 0.016 for 1000 samples
+        assert_(avalanche_bias(wy_word, 64, 1000) < 0.1);
+        assert_(avalanche_bias(wy_bytes, 24 * 8, 1000) < 0.1);
+        assert_(avalanche_bias(wy_bytes, 3 * 8, 1000) < 0.1);
+        assert_(avalanche_bias(sip_word, 64, 1000) < 0.1);
+    }
+    rtest_(sparse_keys) {
+        assert_eq_(sparse_collisions<WyHasher>(), size_t(0));
+        assert_eq_(sparse_collisions<SipHasher13>(), size_t(0));
+        assert_eq_(sparse_collisions<FxHasher>(), size_t(0));
+        assert_eq_(sparse_collisions<FoldHasher>(), size_t(0));
+    }
+    rtest_(fold_hasher) {
+        // Bytes go through wyhash seeded by the state
+        FoldHasher a(5), b(5);
+        a.write(reinterpret_cast<const uint8_t *>("abc"), 3);
+        assert_eq_(a.finish(), wyhash("abc", 5));
+        b.write_u64(1);
+        assert_(b.finish() != FoldHasher(5).finish());
+        assert_(hash_u64<FoldHasher>(1) != hash_u64<FoldHasher>(2));
+        // Order of words matters
+        FoldHasher c, d;
+        c.write_u64(1);
+        c.write_u64(2);
+        d.write_u64(2);
+        d.write_u64(1);
+        assert_(c.finish() != d.finish());
+    }
+    rtest_(sequential_distribution) {
+        // Sequential keys should fill low bits uniformly, as used for bucket indices
+        const size_t buckets = 256, n = 256 * 64;
+        std::vector<size_t> counts(buckets, 0);
+        for (uint64_t i = 0; i < n; ++i) {
+            DefaultHasher h;
+            h.hash(i);
+            counts[h.finish() % buckets] += 1;
+        }
+        double chi2 = 0.0;
+        for (size_t c : counts) {
+            chi2 += (double(c) - 64.0) * (double(c) - 64.0) / 64.0;
+        }
+        // 255 degrees of freedom, far in the tail
+        assert_(chi2 < 400.0);
+    }
+    rtest_(strings) {
+        // Strings are prefix-free, so concatenations differ
+        DefaultHasher a, b;
+        a.hash(std::string("ab"));
+        a.hash(std::string("c"));
+        b.hash(std::string("a"));
+        b.hash(std::string("bc"));
+        assert_(a.finish() != b.finish());
+
+        DefaultHasher c, d;
+        c.hash(std::string("abc"));
+        d.hash(std::string_view("abc"));
+        assert_eq_(c.finish(), d.finish());
+    }
+    rtest_(hash_map_hashers) {
+        HashMap<std::string, int, SipHasher13> sip;
+        HashMap<uint64_t, int, FxHasher> fx;
+        HashSet<int, WyHasher> wy;
+        for (int i = 0; i < 1000; ++i) {
+            sip.insert(std::to_string(i), i);
+            fx.insert(uint64_t(i) << 32, i);
+            wy.insert(i);
+        }
+        assert_eq_(*sip.get("777").unwrap(), 777);
+        assert_eq_(*fx.get(uint64_t(777) << 32).unwrap(), 777);
+        assert_(wy.contains(777));
+        assert_eq_(sip.len() + fx.len() + wy.len(), size_t(3000));
+    }
+}
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
 #include <functional>
+#include <random>
+#include <type_traits>
 
 
 namespace rstd {
 
+// Feeds `value` into `hasher`, could be specialized for user types
 template <typename T>
 struct Hash {
     template <typename H>
@@ -13,24 +20,296 @@ struct Hash {
     }
 };
 
-class DefaultHasher {
+// Little-endian loads of unaligned bytes
+inline uint64_t __read_u64(const uint8_t *p) {
+    uint64_t x;
+    std::memcpy(&x, p, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+inline uint64_t __read_u32(const uint8_t *p) {
+    uint32_t x;
+    std::memcpy(&x, p, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap32(x);
+#endif
+    return x;
+}
+inline uint64_t __rotl(uint64_t x, unsigned b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+// Streaming hasher interface.
+//
+// `Self` provides `write(data, len)` for bytes, `write_u64(x)` for words and `finish()`.
+// Values are fed with `hash(x)` which goes through `Hash<T>`.
+// Integers are written as a single word and strings as their bytes followed by `0xff`,
+// so that concatenated strings don't collide. Other types fall back to `std::hash`.
+template <typename Self>
+class Hasher {
 private:
-    size_t state = 0;
+    Self &self() { return *static_cast<Self *>(this); }
+
 public:
-    void _hash_raw(size_t value) {
-        state ^= value + 0x9e3779b9 + (state << 6) + (state >> 2);
-    }
+    void write_u8(uint8_t x) { self().write_u64(x); }
+    void write_u16(uint16_t x) { self().write_u64(x); }
+    void write_u32(uint32_t x) { self().write_u64(x); }
+    void write_usize(size_t x) { self().write_u64(x); }
+
     template <typename T>
     void _hash(const T &value) {
-        _hash_raw(std::hash<T>()(value));
+        if constexpr (std::is_integral_v<T>) {
+            self().write_u64(uint64_t(value));
+        } else if constexpr (std::is_enum_v<T>) {
+            self().write_u64(uint64_t(std::underlying_type_t<T>(value)));
+        } else if constexpr (std::is_pointer_v<T>) {
+            self().write_u64(uint64_t(reinterpret_cast<uintptr_t>(value)));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            self().write(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+            self().write_u8(0xff);
+        } else {
+            self().write_u64(uint64_t(std::hash<T>()(value)));
+        }
     }
     template <typename T>
     void hash(const T &x) {
-        Hash<T>::hash(x, *this);
+        Hash<T>::hash(x, self());
+    }
+};
+
+// Fast hasher for integer keys, used by rustc (FxHash).
+// Each word costs a rotation and a multiplication, but the low bits of the result are weak,
+// so it relies on the table to mix the hash once more (as `HashMap` does).
+class FxHasher final : public Hasher<FxHasher> {
+private:
+    static constexpr uint64_t SEED = 0x517cc1b727220a95;
+    uint64_t state = 0;
+
+    void add(uint64_t w) {
+        state = (__rotl(state, 5) ^ w) * SEED;
+    }
+
+public:
+    void write(const uint8_t *data, size_t len) {
+        for (; len >= 8; data += 8, len -= 8) {
+            add(__read_u64(data));
+        }
+        if (len >= 4) {
+            add(__read_u32(data));
+            data += 4;
+            len -= 4;
+        }
+        for (; len > 0; ++data, --len) {
+            add(*data);
+        }
+    }
+    void write_u64(uint64_t x) {
+        add(x);
+    }
+    uint64_t finish() const {
+        return state;
+    }
+};
+
+// 128-bit product of `a` and `b` folded to 64 bits
+inline uint64_t __wymix(uint64_t a, uint64_t b) {
+    __uint128_t r = __uint128_t(a) * b;
+    return uint64_t(r) ^ uint64_t(r >> 64);
+}
+
+// Hasher built on wyhash (final version 4), fast for both words and long byte strings.
+// Each `write` of bytes hashes them with wyhash seeded by the current state,
+// each word is folded into the state with a single 64x64 to 128 bit multiplication.
+class WyHasher final : public Hasher<WyHasher> {
+private:
+    static constexpr uint64_t SECRET[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+    };
+    uint64_t state;
+
+public:
+    explicit WyHasher(uint64_t seed=0) : state(seed) {}
+
+    // wyhash of `len` bytes, matches the reference implementation with the default secret
+    static uint64_t hash_bytes(const uint8_t *p, size_t len, uint64_t seed) {
+        seed ^= __wymix(seed ^ SECRET[0], SECRET[1]);
+        uint64_t a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                size_t d = (len >> 3) << 2;
+                a = (__read_u32(p) << 32) | __read_u32(p + d);
+                b = (__read_u32(p + len - 4) << 32) | __read_u32(p + len - 4 - d);
+            } else if (len > 0) {
+                a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | uint64_t(p[len - 1]);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = __wymix(__read_u64(p) ^ SECRET[1], __read_u64(p + 8) ^ seed);
+                    see1 = __wymix(__read_u64(p + 16) ^ SECRET[2], __read_u64(p + 24) ^ see1);
+                    see2 = __wymix(__read_u64(p + 32) ^ SECRET[3], __read_u64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            for (; i > 16; p += 16, i -= 16) {
+                seed = __wymix(__read_u64(p) ^ SECRET[1], __read_u64(p + 8) ^ seed);
+            }
+            a = __read_u64(p + i - 16);
+            b = __read_u64(p + i - 8);
+        }
+        a ^= SECRET[1];
+        b ^= seed;
+        __uint128_t r = __uint128_t(a) * b;
+        a = uint64_t(r);
+        b = uint64_t(r >> 64);
+        return __wymix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+    }
+
+    void write(const uint8_t *data, size_t len) {
+        state = hash_bytes(data, len, state);
+    }
+    void write_u64(uint64_t x) {
+        state = __wymix(x ^ SECRET[0], state ^ SECRET[1]);
     }
-    size_t finish() const {
+    uint64_t finish() const {
+        return __wymix(state ^ SECRET[2], SECRET[3]);
+    }
+};
+
+// Default hasher for hash tables, which mix the result once more.
+// Each word costs a single folded multiplication, so unlike `WyHasher` the result
+// doesn't depend on every input bit equally. Bytes are hashed with wyhash.
+class FoldHasher final : public Hasher<FoldHasher> {
+private:
+    static constexpr uint64_t SEED = 0x243f6a8885a308d3ull;
+    static constexpr uint64_t MULT = 0xa0761d6478bd642full;
+    uint64_t state;
+
+public:
+    explicit FoldHasher(uint64_t seed=SEED) : state(seed) {}
+
+    void write(const uint8_t *data, size_t len) {
+        state = WyHasher::hash_bytes(data, len, state);
+    }
+    void write_u64(uint64_t x) {
+        state = __wymix(state ^ x, MULT);
+    }
+    uint64_t finish() const {
         return state;
     }
 };
 
+// Keys of `SipHasher` created without explicit ones, random for each process
+struct __SipKeys {
+    uint64_t k0, k1;
+
+    static const __SipKeys &random() {
+        static const __SipKeys keys = []() {
+            std::random_device rd;
+            __SipKeys k;
+            k.k0 = (uint64_t(rd()) << 32) | rd();
+            k.k1 = (uint64_t(rd()) << 32) | rd();
+            return k;
+        }();
+        return keys;
+    }
+};
+
+// Keyed SipHash-c-d. With secret keys it resists hash flooding by crafted inputs,
+// but is several times slower than `WyHasher`.
+// Default constructed hashers use keys chosen randomly once per process.
+template <size_t C, size_t D>
+class SipHasher final : public Hasher<SipHasher<C, D>> {
+private:
+    struct State {
+        uint64_t v0, v1, v2, v3;
+
+        void round() {
+            v0 += v1; v1 = __rotl(v1, 13); v1 ^= v0; v0 = __rotl(v0, 32);
+            v2 += v3; v3 = __rotl(v3, 16); v3 ^= v2;
+            v0 += v3; v3 = __rotl(v3, 21); v3 ^= v0;
+            v2 += v1; v1 = __rotl(v1, 17); v1 ^= v2; v2 = __rotl(v2, 32);
+        }
+        void compress(uint64_t m) {
+            v3 ^= m;
+            for (size_t i = 0; i < C; ++i) {
+                round();
+            }
+            v0 ^= m;
+        }
+    };
+
+    State s;
+    // Bytes that don't form a whole word yet, little-endian
+    uint64_t tail = 0;
+    size_t ntail = 0, length = 0;
+
+public:
+    SipHasher() : SipHasher(__SipKeys::random().k0, __SipKeys::random().k1) {}
+    SipHasher(uint64_t k0, uint64_t k1) {
+        s.v0 = k0 ^ 0x736f6d6570736575ull;
+        s.v1 = k1 ^ 0x646f72616e646f6dull;
+        s.v2 = k0 ^ 0x6c7967656e657261ull;
+        s.v3 = k1 ^ 0x7465646279746573ull;
+    }
+
+    void write(const uint8_t *data, size_t len) {
+        length += len;
+        if (ntail > 0) {
+            for (; len > 0 && ntail < 8; ++data, --len, ++ntail) {
+                tail |= uint64_t(*data) << (8 * ntail);
+            }
+            if (ntail < 8) {
+                return;
+            }
+            s.compress(tail);
+            tail = 0;
+            ntail = 0;
+        }
+        for (; len >= 8; data += 8, len -= 8) {
+            s.compress(__read_u64(data));
+        }
+        for (; len > 0; ++data, --len, ++ntail) {
+            tail |= uint64_t(*data) << (8 * ntail);
+        }
+    }
+    void write_u64(uint64_t x) {
+        if (ntail == 0) {
+            length += 8;
+            s.compress(x);
+        } else {
+            uint8_t bytes[8];
+            for (size_t i = 0; i < 8; ++i) {
+                bytes[i] = uint8_t(x >> (8 * i));
+            }
+            write(bytes, 8);
+        }
+    }
+    uint64_t finish() const {
+        State f = s;
+        f.compress((uint64_t(length & 0xff) << 56) | tail);
+        f.v2 ^= 0xff;
+        for (size_t i = 0; i < D; ++i) {
+            f.round();
+        }
+        return f.v0 ^ f.v1 ^ f.v2 ^ f.v3;
+    }
+};
+typedef SipHasher<1, 3> SipHasher13;
+typedef SipHasher<2, 4> SipHasher24;
+
+// Hasher used by hash maps unless another one is specified.
+// Use `WyHasher` when the hash itself must be well distributed
+// and `SipHasher13` for keys controlled by an adversary.
+typedef FoldHasher DefaultHasher;
+
 } // namespace rstd
@@ -0,0 +1,235 @@
+#include <rtest.hpp>
+
+#include <string>
+#include <vector>
+#include "hash_map.hpp"
+
+using namespace rstd;
+
+
+// All keys collide, so probing has to go through whole groups
+struct ConstHasher {
+    template <typename T>
+    void hash(const T &) {}
+    size_t finish() const {
+        return 0;
+    }
+};
+
+rtest_module_(hash_map) {
+    rtest_(insert_get_remove) {
+        HashMap<int, std::string> map;
+        assert_(map.is_empty());
+        assert_(map.get(1).is_none());
+        assert_(map.insert(1, "one").is_none());
+        assert_(map.insert(2, "two").is_none());
+        assert_eq_(map.insert(1, "uno").unwrap(), std::string("one"));
+        assert_eq_(map.len(), size_t(2));
+
+        assert_eq_(*map.get(1).unwrap(), std::string("uno"));
+        assert_(map.get(3).is_none());
+        *map.get_mut(2).unwrap() += "!";
+        assert_eq_(*map.get(2).unwrap(), std::string("two!"));
+
+        assert_eq_(map.remove(1).unwrap(), std::string("uno"));
+        assert_(map.remove(1).is_none());
+        assert_(!map.contains_key(1));
+        assert_(map.contains_key(2));
+        auto e = map.remove_entry(2).unwrap();
+        assert_eq_(e.get<0>(), 2);
+        assert_eq_(e.get<1>(), std::string("two!"));
+        assert_(map.is_empty());
+    }
+    rtest_(grow) {
+        HashMap<int, int> map;
+        for (int i = 0; i < 10000; ++i) {
+            assert_(map.insert(i, i * i).is_none());
+        }
+        assert_eq_(map.len(), size_t(10000));
+        assert_(map.capacity() >= map.len());
+        for (int i = 0; i < 10000; i += 2) {
+            assert_eq_(map.remove(i).unwrap(), i * i);
+        }
+        for (int i = 0; i < 10000; ++i) {
+            assert_eq_(map.get(i).is_some(), i % 2 == 1);
+        }
+        assert_eq_(map.len(), size_t(5000));
+    }
+    rtest_(collisions) {
+        HashMap<int, int, ConstHasher> map;
+        for (int i = 0; i < 100; ++i) {
+            map.insert(i, -i);
+        }
+        for (int i = 0; i < 100; i += 3) {
+            assert_eq_(map.remove(i).unwrap(), -i);
+        }
+        for (int i = 0; i < 100; ++i) {
+            assert_eq_(map.contains_key(i), i % 3 != 0);
+        }
+        // Tombstones are reused
+        for (int i = 0; i < 100; i += 3) {
+            map.insert(i, i);
+        }
+        for (int i = 0; i < 100; ++i) {
+            assert_eq_(*map.get(i).unwrap(), i % 3 == 0 ? i : -i);
+        }
+    }
+    rtest_(churn) {
+        // Inserting and removing distinct keys doesn't grow a small map
+        HashMap<int, int> map;
+        map.insert(-1, 0);
+        size_t cap = map.capacity();
+        for (int i = 0; i < 100000; ++i) {
+            map.insert(i, i);
+            assert_eq_(map.remove(i).unwrap(), i);
+        }
+        assert_eq_(map.capacity(), cap);
+        assert_eq_(map.len(), size_t(1));
+    }
+    rtest_(reserve) {
+        HashMap<int, int> map;
+        assert_eq_(map.capacity(), size_t(0));
+        map.reserve(1000);
+        size_t cap = map.capacity();
+        assert_(cap >= 1000);
+        for (int i = 0; i < 1000; ++i) {
+            map.insert(i, i);
+        }
+        assert_eq_(map.capacity(), cap);
+
+        for (int i = 10; i < 1000; ++i) {
+            map.remove(i);
+        }
+        map.shrink_to_fit();
+        assert_(map.capacity() < 100);
+        assert_eq_(*map.get(9).unwrap(), 9);
+
+        auto res = map.try_reserve(size_t(PTRDIFF_MAX));
+        assert_eq_(res.take_err().kind, AllocError::CAPACITY_OVERFLOW);
+        auto m = HashMap<int, int>::with_capacity(100);
+        assert_(m.capacity() >= 100);
+    }
+    rtest_(entry) {
+        HashMap<std::string, int> map;
+        assert_eq_(map.entry("a").or_insert(1), 1);
+        assert_eq_(map.entry("a").or_insert(2), 1);
+        assert_eq_(map.entry("b").or_default(), 0);
+        assert_eq_(map.entry("c").or_insert_with([]() { return 3; }), 3);
+        assert_(map.entry("a").is_occupied());
+        assert_eq_(map.entry("a").get_key(), std::string("a"));
+        assert_(!map.entry("d").is_occupied());
+        assert_(!map.contains_key("d"));
+
+        assert_eq_(map.entry("a").and_modify([](int &x) { x += 10; }).or_insert(0), 11);
+        assert_eq_(map.entry("e").and_modify([](int &x) { x += 10; }).or_insert(5), 5);
+        map.entry("e").or_default() += 1;
+        assert_eq_(*map.get("e").unwrap(), 6);
+        assert_eq_(map.len(), size_t(4));
+
+        // Counting words
+        HashMap<std::string, int> counts;
+        for (const char *w : {"x", "y", "x", "z", "x", "y"}) {
+            counts.entry(w).or_default() += 1;
+        }
+        assert_eq_(*counts.get("x").unwrap(), 3);
+        assert_eq_(*counts.get("y").unwrap(), 2);
+        assert_eq_(*counts.get("z").unwrap(), 1);
+    }
+    rtest_(iter) {
+        HashMap<int, int> map;
+        for (int i = 0; i < 100; ++i) {
+            map.insert(i, 2 * i);
+        }
+        assert_eq_(map.iter().size_hint().lower, size_t(100));
+        assert_eq_(map.iter().map([](Tuple<const int *, const int *> &&e) {
+            assert_eq_(*e.get<1>(), 2 * *e.get<0>());
+            return *e.get<0>();
+        }).sum(), 4950);
+        assert_eq_(map.keys().map([](const int *k) { return *k; }).sum(), 4950);
+        assert_eq_(map.values().map([](const int *v) { return *v; }).sum(), 9900);
+
+        map.values_mut().for_each([](int *v) { *v += 1; });
+        map.iter_mut().for_each([](Tuple<const int *, int *> &&e) { *e.get<1>() += 1; });
+        assert_eq_(*map.get(10).unwrap(), 22);
+
+        std::vector<Tuple<int, int>> items = into_iter(std::move(map)).collect<std::vector>();
+        assert_eq_(items.size(), size_t(100));
+        int sum = 0;
+        for (const auto &e : items) {
+            sum += e.get<1>() - e.get<0>();
+        }
+        assert_eq_(sum, 4950 + 200);
+    }
+    rtest_(into_iter_partial) {
+        HashMap<std::string, std::string> map;
+        for (int i = 0; i < 50; ++i) {
+            map.insert(std::to_string(i), std::string(32, char('a' + i % 26)));
+        }
+        auto it = into_iter(std::move(map));
+        assert_eq_(it.size_hint().lower, size_t(50));
+        assert_(it.next().is_some());
+        assert_eq_(it.size_hint().lower, size_t(49));
+        // The rest is dropped with the iterator
+    }
+    rtest_(collect_clone_eq) {
+        auto map = Range(20).map([](int i) {
+            return Tuple<int, std::string>(int(i), std::to_string(i));
+        }).collect<HashMap<int, std::string>>();
+        assert_eq_(map.len(), size_t(20));
+        assert_eq_(*map.get(13).unwrap(), std::string("13"));
+
+        HashMap<int, std::string> copy(map);
+        assert_(copy == map);
+        copy.insert(13, "x");
+        assert_(copy != map);
+        copy.insert(13, "13");
+        assert_(copy == map);
+        copy.remove(0);
+        assert_(copy != map);
+
+        map.retain([](const int &k, std::string &) { return k < 5; });
+        assert_eq_(map.len(), size_t(5));
+        map.clear();
+        assert_(map.is_empty());
+        assert_(map.capacity() >= 20);
+        map.insert(1, "1");
+        assert_eq_(format_("{}", map), std::string("{1: 1}"));
+    }
+}
+
+rtest_module_(hash_set) {
+    rtest_(insert_remove) {
+        HashSet<std::string> set;
+        assert_(set.insert("a"));
+        assert_(set.insert("b"));
+        assert_(!set.insert("a"));
+        assert_eq_(set.len(), size_t(2));
+        assert_(set.contains("a"));
+        assert_(!set.contains("c"));
+        assert_eq_(*set.get("b").unwrap(), std::string("b"));
+
+        assert_eq_(set.take("a").unwrap(), std::string("a"));
+        assert_(!set.remove("a"));
+        assert_(set.remove("b"));
+        assert_(set.is_empty());
+    }
+    rtest_(collect_iter) {
+        auto set = Range(1000).map([](int i) { return i % 100; }).collect<HashSet<int>>();
+        assert_eq_(set.len(), size_t(100));
+        assert_eq_(set.iter().map([](const int *x) { return *x; }).sum(), 4950);
+
+        HashSet<int, ConstHasher> slow;
+        Range(50).for_each([&slow](int i) { slow.insert(i); });
+        slow.retain([](const int &x) { return x % 2 == 0; });
+        assert_eq_(slow.len(), size_t(25));
+        assert_(slow.contains(48));
+        assert_(!slow.contains(49));
+
+        auto other = into_iter(std::move(set)).filter([](const int &x) { return x < 50; }).collect<HashSet<int>>();
+        HashSet<int> expected;
+        expected.extend_from_iter(Range(50));
+        assert_(other == expected);
+        expected.insert(50);
+        assert_(other != expected);
+    }
+}
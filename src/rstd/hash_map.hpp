@@ -0,0 +1,845 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+template <typename K, typename V, typename H=DefaultHasher>
+class HashMap;
+template <typename T, typename H=DefaultHasher>
+class HashSet;
+
+namespace hash_map {
+
+// Control byte of a bucket: `EMPTY`, `DELETED` or 7 bits of the key hash if the bucket is full
+typedef int8_t Ctrl;
+inline constexpr Ctrl EMPTY = -128;
+inline constexpr Ctrl DELETED = -2;
+
+// Buckets are probed in groups of control bytes matched by a single vector comparison
+inline constexpr size_t GROUP_WIDTH = 16;
+
+// Control bytes of the table without buckets, lookups in it need no special case
+alignas(GROUP_WIDTH) inline const Ctrl __EMPTY_GROUP[GROUP_WIDTH] = {
+    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
+};
+
+// Control bytes of `GROUP_WIDTH` consecutive buckets.
+// Bit `i` of each match is set if bucket `i` of the group satisfies the condition.
+class __Group final {
+private:
+    typedef Simd<Ctrl, GROUP_WIDTH> Bytes;
+    Bytes ctrl;
+
+public:
+    explicit __Group(const Ctrl *p) : ctrl(Bytes::load(p)) {}
+
+    uint32_t match(Ctrl h2) const {
+        return uint32_t((ctrl == Bytes::splat(h2)).to_bitmask());
+    }
+    uint32_t match_empty() const {
+        return match(EMPTY);
+    }
+    uint32_t match_empty_or_deleted() const {
+        return uint32_t((ctrl < Bytes::splat(0)).to_bitmask());
+    }
+    uint32_t match_full() const {
+        return ~match_empty_or_deleted() & ((uint32_t(1) << GROUP_WIDTH) - 1);
+    }
+};
+
+// Spreads entropy of a possibly weak hash (e.g. identity for integers) over all bits
+inline uint64_t __mix(uint64_t h) {
+    __uint128_t p = __uint128_t(h) * 0x9e3779b97f4a7c15ull;
+    return uint64_t(p) ^ uint64_t(p >> 64);
+}
+// Low 7 bits of the mixed hash are stored in the control byte, the rest selects the first group to probe
+inline Ctrl __h2(size_t hash) {
+    return Ctrl(hash & 0x7f);
+}
+inline size_t __h1(size_t hash) {
+    return hash >> 7;
+}
+
+// Index of the first empty or deleted bucket in the probe sequence of `hash`.
+// Groups are probed at triangular offsets which visit every group of a power-of-two table.
+inline size_t __find_insert_slot(const Ctrl *ctrl, size_t mask, size_t hash) {
+    size_t pos = __h1(hash) & mask, stride = 0;
+    for (;;) {
+        uint32_t bits = __Group(ctrl + pos).match_empty_or_deleted();
+        if (bits != 0) {
+            return (pos + size_t(__builtin_ctz(bits))) & mask;
+        }
+        stride += GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
+// The first `GROUP_WIDTH - 1` control bytes are mirrored after the last bucket,
+// so that a group starting at any bucket could be loaded without wrapping around.
+inline void __set_ctrl(Ctrl *ctrl, size_t mask, size_t i, Ctrl c) {
+    ctrl[i] = c;
+    ctrl[((i - (GROUP_WIDTH - 1)) & mask) + (GROUP_WIDTH - 1)] = c;
+}
+// Index of the first full bucket starting from `pos`, or `buckets` if there is none
+inline size_t __next_full(const Ctrl *ctrl, size_t buckets, size_t pos) {
+    for (; pos < buckets; pos += GROUP_WIDTH) {
+        uint32_t bits = __Group(ctrl + pos).match_full();
+        if (bits != 0) {
+            return std::min(pos + size_t(__builtin_ctz(bits)), buckets);
+        }
+    }
+    return buckets;
+}
+
+// Open addressing table of slots `S` with keys `K` extracted by `KeyOf::key(slot)` (Swiss table).
+//
+// Slots and their control bytes are stored in a single allocation.
+// The amount of buckets is a power of two not less than `GROUP_WIDTH`, at most 7/8 of them are occupied.
+// Removal leaves a `DELETED` tombstone only if the bucket could be in the middle of a probe sequence,
+// i.e. if it belongs to a window of `GROUP_WIDTH` buckets without empty ones.
+template <typename K, typename S, typename KeyOf, typename H>
+class __RawTable final {
+private:
+    S *slots_ = nullptr;
+    Ctrl *ctrl_ = const_cast<Ctrl *>(__EMPTY_GROUP);
+    // Buckets are never written while `ctrl_` points to `__EMPTY_GROUP` because `growth_left_` is zero
+    size_t buckets_ = 0, mask_ = 0;
+    size_t len_ = 0;
+    // Amount of entries that could be inserted into empty buckets before rehashing
+    size_t growth_left_ = 0;
+
+    static constexpr size_t max_buckets = size_t(PTRDIFF_MAX) / (sizeof(S) + 1) - GROUP_WIDTH;
+
+    static size_t capacity_of(size_t buckets) {
+        return buckets - buckets / 8;
+    }
+    // Smallest amount of buckets that holds `n` entries, zero on overflow
+    static size_t buckets_for(size_t n) {
+        size_t b = GROUP_WIDTH;
+        while (capacity_of(b) < n) {
+            if (b > max_buckets / 2) {
+                return 0;
+            }
+            b *= 2;
+        }
+        return b;
+    }
+    static size_t ctrl_offset(size_t buckets) {
+        return buckets * sizeof(S);
+    }
+    static size_t alloc_size(size_t buckets) {
+        size_t size = ctrl_offset(buckets) + buckets + GROUP_WIDTH - 1;
+        // Size must be a multiple of alignment for `aligned_alloc`
+        return (size + alignof(S) - 1) / alignof(S) * alignof(S);
+    }
+    static void *allocate(size_t size) {
+        if constexpr (alignof(S) > alignof(std::max_align_t)) {
+            return std::aligned_alloc(alignof(S), size);
+        } else {
+            return std::malloc(size);
+        }
+    }
+
+    void destroy_all() {
+        if constexpr (!std::is_trivially_destructible_v<S>) {
+            for (size_t i = __next_full(ctrl_, buckets_, 0); i < buckets_; i = __next_full(ctrl_, buckets_, i + 1)) {
+                slots_[i].~S();
+            }
+        }
+    }
+    void release() {
+        if (buckets_ > 0) {
+            destroy_all();
+            std::free(static_cast<void *>(slots_));
+        }
+        reset();
+    }
+    void reset() {
+        slots_ = nullptr;
+        ctrl_ = const_cast<Ctrl *>(__EMPTY_GROUP);
+        buckets_ = mask_ = len_ = growth_left_ = 0;
+    }
+    void take(__RawTable &other) {
+        slots_ = other.slots_;
+        ctrl_ = other.ctrl_;
+        buckets_ = other.buckets_;
+        mask_ = other.mask_;
+        len_ = other.len_;
+        growth_left_ = other.growth_left_;
+        other.reset();
+    }
+
+    // Moves all entries into a new allocation of `buckets`, which also drops all tombstones
+    Result<Tuple<>, AllocError> resize(size_t buckets) {
+        if (buckets == 0) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        size_t size = alloc_size(buckets);
+        void *mem = allocate(size);
+        if (mem == nullptr) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::OUT_OF_MEMORY, size));
+        }
+        S *slots = static_cast<S *>(mem);
+        Ctrl *ctrl = reinterpret_cast<Ctrl *>(static_cast<unsigned char *>(mem) + ctrl_offset(buckets));
+        std::memset(static_cast<void *>(ctrl), uint8_t(EMPTY), buckets + GROUP_WIDTH - 1);
+        size_t mask = buckets - 1;
+        for (size_t i = __next_full(ctrl_, buckets_, 0); i < buckets_; i = __next_full(ctrl_, buckets_, i + 1)) {
+            size_t hash = hash_of(KeyOf::key(slots_[i]));
+            size_t j = __find_insert_slot(ctrl, mask, hash);
+            __set_ctrl(ctrl, mask, j, __h2(hash));
+            vec::__relocate(slots + j, slots_ + i, 1);
+        }
+        if (buckets_ > 0) {
+            std::free(static_cast<void *>(slots_));
+        }
+        slots_ = slots;
+        ctrl_ = ctrl;
+        buckets_ = buckets;
+        mask_ = mask;
+        growth_left_ = capacity_of(buckets) - len_;
+        return Result<Tuple<>, AllocError>::Ok();
+    }
+    // Makes room for one more entry in an empty bucket
+    Result<Tuple<>, AllocError> grow_for_insert() {
+        size_t cap = capacity_of(buckets_);
+        if (buckets_ > 0 && len_ < cap / 2) {
+            // Most of the growth was eaten by tombstones, rehashing at the same size is enough
+            return resize(buckets_);
+        }
+        return resize(buckets_for(cap + 1));
+    }
+
+public:
+    static void expect(Result<Tuple<>, AllocError> &&res) {
+        if (res.is_err()) {
+            const AllocError &e = res.get_err();
+            if (e.kind == AllocError::CAPACITY_OVERFLOW) {
+                panic_("Capacity overflow");
+            } else {
+                panic_("Allocation of {} bytes failed", e.size);
+            }
+        }
+        res.clear();
+    }
+    static size_t hash_of(const K &key) {
+        H hasher;
+        hasher.hash(key);
+        return size_t(__mix(uint64_t(hasher.finish())));
+    }
+
+    __RawTable() = default;
+    __RawTable(const __RawTable &other) {
+        if (other.len_ == 0) {
+            return;
+        }
+        expect(resize(other.buckets_));
+        // Same amount of buckets, so entries keep their positions
+        std::memcpy(static_cast<void *>(ctrl_), static_cast<const void *>(other.ctrl_), buckets_ + GROUP_WIDTH - 1);
+        for (size_t i = __next_full(ctrl_, buckets_, 0); i < buckets_; i = __next_full(ctrl_, buckets_, i + 1)) {
+            new (slots_ + i) S(clone(other.slots_[i]));
+        }
+        len_ = other.len_;
+        growth_left_ = other.growth_left_;
+    }
+    __RawTable &operator=(const __RawTable &other) {
+        if (this != &other) {
+            *this = __RawTable(other);
+        }
+        return *this;
+    }
+    __RawTable(__RawTable &&other) {
+        take(other);
+    }
+    __RawTable &operator=(__RawTable &&other) {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+    ~__RawTable() {
+        release();
+    }
+
+    size_t len() const { return len_; }
+    size_t buckets() const { return buckets_; }
+    size_t capacity() const { return len_ + growth_left_; }
+    S *slots() const { return slots_; }
+    const Ctrl *ctrl() const { return ctrl_; }
+
+    Option<size_t> find(const K &key, size_t hash) const {
+        Ctrl h2 = __h2(hash);
+        size_t pos = __h1(hash) & mask_, stride = 0;
+        for (;;) {
+            __Group g(ctrl_ + pos);
+            for (uint32_t bits = g.match(h2); bits != 0; bits &= bits - 1) {
+                size_t i = (pos + size_t(__builtin_ctz(bits))) & mask_;
+                if (KeyOf::key(slots_[i]) == key) {
+                    return Option<size_t>::Some(i);
+                }
+            }
+            // Insertion would have stopped at the empty bucket
+            if (g.match_empty() != 0) {
+                return Option<size_t>::None();
+            }
+            stride += GROUP_WIDTH;
+            pos = (pos + stride) & mask_;
+        }
+    }
+    Option<size_t> find(const K &key) const {
+        return find(key, hash_of(key));
+    }
+    // Marks a bucket for a new entry with `hash` as full and returns its index.
+    // The caller must construct the slot right away.
+    size_t prepare_insert(size_t hash) {
+        size_t i = __find_insert_slot(ctrl_, mask_, hash);
+        if (growth_left_ == 0 && ctrl_[i] != DELETED) {
+            expect(grow_for_insert());
+            i = __find_insert_slot(ctrl_, mask_, hash);
+        }
+        growth_left_ -= ctrl_[i] == EMPTY ? 1 : 0;
+        __set_ctrl(ctrl_, mask_, i, __h2(hash));
+        len_ += 1;
+        return i;
+    }
+    // Marks a full bucket as free, the slot must be already destroyed or moved out
+    void erase_at(size_t i) {
+        uint32_t empty_before = __Group(ctrl_ + ((i - GROUP_WIDTH) & mask_)).match_empty();
+        uint32_t empty_after = __Group(ctrl_ + i).match_empty();
+        // Probing could have passed this bucket only if it is inside a window of `GROUP_WIDTH` non-empty buckets
+        bool never_full = empty_before != 0 && empty_after != 0 && (
+            size_t(__builtin_ctz(empty_after)) + size_t(__builtin_clz(empty_before) - (32 - GROUP_WIDTH)) < GROUP_WIDTH
+        );
+        __set_ctrl(ctrl_, mask_, i, never_full ? EMPTY : DELETED);
+        growth_left_ += never_full ? 1 : 0;
+        len_ -= 1;
+    }
+
+    Result<Tuple<>, AllocError> try_reserve(size_t additional) {
+        if (additional <= growth_left_) {
+            return Result<Tuple<>, AllocError>::Ok();
+        }
+        if (additional > max_buckets - len_) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        return resize(buckets_for(len_ + additional));
+    }
+    void shrink_to_fit() {
+        if (len_ == 0) {
+            release();
+            return;
+        }
+        size_t buckets = buckets_for(len_);
+        if (buckets < buckets_) {
+            // Keep the old allocation if the new one fails
+            resize(buckets).clear();
+        }
+    }
+    void clear() {
+        if (buckets_ > 0) {
+            destroy_all();
+            std::memset(static_cast<void *>(ctrl_), uint8_t(EMPTY), buckets_ + GROUP_WIDTH - 1);
+        }
+        len_ = 0;
+        growth_left_ = capacity_of(buckets_);
+    }
+    // Removes entries for which `f(slot)` returns `false`
+    template <typename F>
+    void retain(F &&f) {
+        for (size_t i = __next_full(ctrl_, buckets_, 0); i < buckets_; i = __next_full(ctrl_, buckets_, i + 1)) {
+            if (!f(slots_[i])) {
+                slots_[i].~S();
+                erase_at(i);
+            }
+        }
+    }
+};
+
+// Iterator over full slots of a table.
+// `P::project(slot)` converts a pointer to slot `P::Slot` into item `P::Item`.
+template <typename P>
+class Iter final : public Iterator<typename P::Item, Iter<P>> {
+private:
+    typedef typename P::Slot Slot;
+
+    Slot *slots;
+    const Ctrl *ctrl;
+    size_t buckets, pos = 0, left;
+
+public:
+    Iter(Slot *s, const Ctrl *c, size_t b, size_t n) : slots(s), ctrl(c), buckets(b), left(n) {}
+
+    Option<typename P::Item> next() {
+        if (left == 0) {
+            return None();
+        }
+        pos = __next_full(ctrl, buckets, pos);
+        left -= 1;
+        return Option<typename P::Item>::Some(P::project(slots + pos++));
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(left);
+    }
+    typedef void Rev;
+};
+
+// Owning iterator that moves entries out of the table of container `C`.
+// Moved-from slots are destroyed with the table.
+template <typename P, typename C>
+class IntoIter final : public Iterator<typename P::Item, IntoIter<P, C>> {
+private:
+    typename C::Table table;
+    size_t pos = 0, left;
+
+public:
+    explicit IntoIter(C &&c) : table(std::move(c.table)), left(table.len()) {}
+
+    Option<typename P::Item> next() {
+        if (left == 0) {
+            return None();
+        }
+        pos = __next_full(table.ctrl(), table.buckets(), pos);
+        left -= 1;
+        return Option<typename P::Item>::Some(P::project(table.slots() + pos++));
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(left);
+    }
+    typedef void Rev;
+};
+
+template <typename K, typename V>
+struct __MapKeyOf {
+    static const K &key(const Tuple<K, V> &s) { return s.template get<0>(); }
+};
+template <typename T>
+struct __SetKeyOf {
+    static const T &key(const T &s) { return s; }
+};
+
+// Projections of slots to iterator items
+template <typename K, typename V>
+struct __PairRef {
+    typedef const Tuple<K, V> Slot;
+    typedef Tuple<const K *, const V *> Item;
+    static Item project(Slot *s) { return Item(&s->template get<0>(), &s->template get<1>()); }
+};
+template <typename K, typename V>
+struct __PairMut {
+    typedef Tuple<K, V> Slot;
+    typedef Tuple<const K *, V *> Item;
+    static Item project(Slot *s) { return Item(&s->template get<0>(), &s->template get<1>()); }
+};
+template <typename K, typename V>
+struct __KeyRef {
+    typedef const Tuple<K, V> Slot;
+    typedef const K *Item;
+    static Item project(Slot *s) { return &s->template get<0>(); }
+};
+template <typename K, typename V>
+struct __ValueRef {
+    typedef const Tuple<K, V> Slot;
+    typedef const V *Item;
+    static Item project(Slot *s) { return &s->template get<1>(); }
+};
+template <typename K, typename V>
+struct __ValueMut {
+    typedef Tuple<K, V> Slot;
+    typedef V *Item;
+    static Item project(Slot *s) { return &s->template get<1>(); }
+};
+template <typename T>
+struct __SetRef {
+    typedef const T Slot;
+    typedef const T *Item;
+    static Item project(Slot *s) { return s; }
+};
+template <typename S>
+struct __Move {
+    typedef S Slot;
+    typedef S Item;
+    static Item project(Slot *s) { return std::move(*s); }
+};
+
+} // namespace hash_map
+
+// Hash map with open addressing and SIMD probing (Swiss table).
+//
+// Keys are hashed with `H` (see `hash.hpp`) and the result is mixed once more,
+// so weak hashers are fine. Entries are moved on rehashing,
+// so pointers to keys and values are invalidated by insertion.
+// Allocation failures are reported by `try_*` methods as `AllocError`, the rest of the methods panic on them.
+template <typename K, typename V, typename H>
+class HashMap final {
+private:
+    typedef Tuple<K, V> Slot;
+    typedef hash_map::__RawTable<K, Slot, hash_map::__MapKeyOf<K, V>, H> Table;
+
+    Table table;
+
+    template <typename P, typename C>
+    friend class hash_map::IntoIter;
+
+    template <typename F>
+    V &insert_with(K &&key, size_t hash, F &&f) {
+        // Value is created before the table is modified, so `f` may access the map
+        V value = f();
+        size_t i = table.prepare_insert(hash);
+        new (table.slots() + i) Slot(std::move(key), std::move(value));
+        return table.slots()[i].template get<1>();
+    }
+
+public:
+    typedef Tuple<K, V> value_type;
+
+    // View into a single entry that may be either vacant or occupied.
+    // The map must not be modified while the entry exists.
+    class Entry final {
+    private:
+        HashMap *map;
+        K key;
+        size_t hash;
+        Option<size_t> index;
+
+        template <typename F>
+        V &insert_with(F &&f) {
+            if (index.is_some()) {
+                return map->table.slots()[index.get()].template get<1>();
+            }
+            return map->insert_with(std::move(key), hash, f);
+        }
+
+    public:
+        Entry(HashMap *m, K &&k) : map(m), key(std::move(k)), hash(Table::hash_of(key)) {
+            index = map->table.find(key, hash);
+        }
+
+        const K &get_key() const {
+            return key;
+        }
+        bool is_occupied() const {
+            return index.is_some();
+        }
+
+        template <typename F>
+        Entry and_modify(F f) {
+            if (index.is_some()) {
+                f(map->table.slots()[index.get()].template get<1>());
+            }
+            return std::move(*this);
+        }
+        V &or_insert(V &&v) {
+            return insert_with([&]() { return std::move(v); });
+        }
+        template <typename F>
+        V &or_insert_with(F f) {
+            return insert_with(f);
+        }
+        V &or_default() {
+            return insert_with([]() { return V(); });
+        }
+    };
+
+    HashMap() = default;
+    // Holds `cap` entries without rehashing
+    static HashMap with_capacity(size_t cap) {
+        HashMap m;
+        m.reserve(cap);
+        return m;
+    }
+
+    size_t len() const { return table.len(); }
+    bool is_empty() const { return table.len() == 0; }
+    // Amount of entries the map holds without rehashing
+    size_t capacity() const { return table.capacity(); }
+
+    // Ensures `additional` more entries could be inserted without rehashing
+    void reserve(size_t additional) {
+        Table::expect(table.try_reserve(additional));
+    }
+    Result<Tuple<>, AllocError> try_reserve(size_t additional) {
+        return table.try_reserve(additional);
+    }
+    void shrink_to_fit() {
+        table.shrink_to_fit();
+    }
+
+    // Returns the previous value of the key
+    Option<V> insert(K &&key, V &&value) {
+        size_t hash = Table::hash_of(key);
+        Option<size_t> found = table.find(key, hash);
+        if (found.is_some()) {
+            V &old = table.slots()[found.get()].template get<1>();
+            std::swap(old, value);
+            return Option<V>::Some(std::move(value));
+        }
+        insert_with(std::move(key), hash, [&]() { return std::move(value); });
+        return Option<V>::None();
+    }
+    Option<V> insert(const K &key, const V &value) {
+        return insert(clone(key), clone(value));
+    }
+
+    Option<const V *> get(const K &key) const {
+        Option<size_t> found = table.find(key);
+        if (found.is_none()) {
+            return Option<const V *>::None();
+        }
+        return Option<const V *>::Some(&table.slots()[found.get()].template get<1>());
+    }
+    Option<V *> get_mut(const K &key) {
+        Option<size_t> found = table.find(key);
+        if (found.is_none()) {
+            return Option<V *>::None();
+        }
+        return Option<V *>::Some(&table.slots()[found.get()].template get<1>());
+    }
+    bool contains_key(const K &key) const {
+        return table.find(key).is_some();
+    }
+
+    Entry entry(K &&key) {
+        return Entry(this, std::move(key));
+    }
+    Entry entry(const K &key) {
+        return entry(clone(key));
+    }
+
+    Option<Tuple<K, V>> remove_entry(const K &key) {
+        Option<size_t> found = table.find(key);
+        if (found.is_none()) {
+            return Option<Tuple<K, V>>::None();
+        }
+        Slot &s = table.slots()[found.get()];
+        Tuple<K, V> entry(std::move(s));
+        s.~Slot();
+        table.erase_at(found.get());
+        return Option<Tuple<K, V>>::Some(std::move(entry));
+    }
+    Option<V> remove(const K &key) {
+        return remove_entry(key).map([](Tuple<K, V> &&e) { return std::move(e.template get<1>()); });
+    }
+    // Keeps only entries for which `f(key, value)` returns `true`
+    template <typename F>
+    void retain(F &&f) {
+        table.retain([&f](Slot &s) { return bool(f(s.template get<0>(), s.template get<1>())); });
+    }
+    // Removes all entries, keeps the allocation
+    void clear() {
+        table.clear();
+    }
+
+    // Adds an entry, used by `Iterator::collect<HashMap<K, V>>()`
+    void extend_one(Tuple<K, V> &&entry) {
+        insert(std::move(entry.template get<0>()), std::move(entry.template get<1>()));
+    }
+    template <typename I>
+    void extend_from_iter(I &&iter) {
+        reserve(iter.size_hint().lower);
+        iter.for_each([this](Tuple<K, V> &&e) { extend_one(std::move(e)); });
+    }
+
+    // Entries in arbitrary order
+    hash_map::Iter<hash_map::__PairRef<K, V>> iter() const {
+        return hash_map::Iter<hash_map::__PairRef<K, V>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+    hash_map::Iter<hash_map::__PairMut<K, V>> iter_mut() {
+        return hash_map::Iter<hash_map::__PairMut<K, V>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+    hash_map::Iter<hash_map::__KeyRef<K, V>> keys() const {
+        return hash_map::Iter<hash_map::__KeyRef<K, V>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+    hash_map::Iter<hash_map::__ValueRef<K, V>> values() const {
+        return hash_map::Iter<hash_map::__ValueRef<K, V>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+    hash_map::Iter<hash_map::__ValueMut<K, V>> values_mut() {
+        return hash_map::Iter<hash_map::__ValueMut<K, V>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+
+    bool operator==(const HashMap &other) const {
+        if (len() != other.len()) {
+            return false;
+        }
+        return iter().all([&other](const Tuple<const K *, const V *> &e) {
+            Option<const V *> v = other.get(*e.template get<0>());
+            return v.is_some() && *v.get() == *e.template get<1>();
+        });
+    }
+    bool operator!=(const HashMap &other) const {
+        return !(*this == other);
+    }
+};
+
+// Hash set, a `HashMap` without values
+template <typename T, typename H>
+class HashSet final {
+private:
+    typedef hash_map::__RawTable<T, T, hash_map::__SetKeyOf<T>, H> Table;
+
+    Table table;
+
+    template <typename P, typename C>
+    friend class hash_map::IntoIter;
+
+public:
+    typedef T value_type;
+
+    HashSet() = default;
+    // Holds `cap` elements without rehashing
+    static HashSet with_capacity(size_t cap) {
+        HashSet s;
+        s.reserve(cap);
+        return s;
+    }
+
+    size_t len() const { return table.len(); }
+    bool is_empty() const { return table.len() == 0; }
+    // Amount of elements the set holds without rehashing
+    size_t capacity() const { return table.capacity(); }
+
+    // Ensures `additional` more elements could be inserted without rehashing
+    void reserve(size_t additional) {
+        Table::expect(table.try_reserve(additional));
+    }
+    Result<Tuple<>, AllocError> try_reserve(size_t additional) {
+        return table.try_reserve(additional);
+    }
+    void shrink_to_fit() {
+        table.shrink_to_fit();
+    }
+
+    // Returns `false` if an equal element is already present, the set isn't changed then
+    bool insert(T &&x) {
+        size_t hash = Table::hash_of(x);
+        if (table.find(x, hash).is_some()) {
+            return false;
+        }
+        size_t i = table.prepare_insert(hash);
+        new (table.slots() + i) T(std::move(x));
+        return true;
+    }
+    bool insert(const T &x) {
+        return insert(clone(x));
+    }
+
+    bool contains(const T &x) const {
+        return table.find(x).is_some();
+    }
+    Option<const T *> get(const T &x) const {
+        Option<size_t> found = table.find(x);
+        if (found.is_none()) {
+            return Option<const T *>::None();
+        }
+        return Option<const T *>::Some(table.slots() + found.get());
+    }
+
+    // Removes the element and returns it
+    Option<T> take(const T &x) {
+        Option<size_t> found = table.find(x);
+        if (found.is_none()) {
+            return Option<T>::None();
+        }
+        T &s = table.slots()[found.get()];
+        T value(std::move(s));
+        s.~T();
+        table.erase_at(found.get());
+        return Option<T>::Some(std::move(value));
+    }
+    bool remove(const T &x) {
+        return take(x).is_some();
+    }
+    // Keeps only elements for which `f(x)` returns `true`
+    template <typename F>
+    void retain(F &&f) {
+        table.retain([&f](const T &x) { return bool(f(x)); });
+    }
+    // Removes all elements, keeps the allocation
+    void clear() {
+        table.clear();
+    }
+
+    // Adds an element, used by `Iterator::collect<HashSet<T>>()`
+    void extend_one(T &&x) {
+        insert(std::move(x));
+    }
+    template <typename I>
+    void extend_from_iter(I &&iter) {
+        reserve(iter.size_hint().lower);
+        iter.for_each([this](T &&x) { insert(std::move(x)); });
+    }
+
+    // Elements in arbitrary order
+    hash_map::Iter<hash_map::__SetRef<T>> iter() const {
+        return hash_map::Iter<hash_map::__SetRef<T>>(table.slots(), table.ctrl(), table.buckets(), table.len());
+    }
+
+    bool operator==(const HashSet &other) const {
+        return len() == other.len() && iter().all([&other](const T *x) { return other.contains(*x); });
+    }
+    bool operator!=(const HashSet &other) const {
+        return !(*this == other);
+    }
+};
+
+// Moves entries out of the map as `Tuple<K, V>`
+template <typename K, typename V, typename H>
+hash_map::IntoIter<hash_map::__Move<Tuple<K, V>>, HashMap<K, V, H>> into_iter(HashMap<K, V, H> &&map) {
+    return hash_map::IntoIter<hash_map::__Move<Tuple<K, V>>, HashMap<K, V, H>>(std::move(map));
+}
+template <typename T, typename H>
+hash_map::IntoIter<hash_map::__Move<T>, HashSet<T, H>> into_iter(HashSet<T, H> &&set) {
+    return hash_map::IntoIter<hash_map::__Move<T>, HashSet<T, H>>(std::move(set));
+}
+// More specialized than `into_iter(C<T> &&)` for the default hasher
+template <typename T>
+hash_map::IntoIter<hash_map::__Move<T>, HashSet<T>> into_iter(HashSet<T> &&set) {
+    return hash_map::IntoIter<hash_map::__Move<T>, HashSet<T>>(std::move(set));
+}
+
+template <typename K, typename V, typename H>
+struct TriviallyRelocatable<HashMap<K, V, H>> : std::true_type {};
+template <typename T, typename H>
+struct TriviallyRelocatable<HashSet<T, H>> : std::true_type {};
+
+template <typename K, typename V, typename H>
+struct fmt::Display<HashMap<K, V, H>> {
+    static void fmt(const HashMap<K, V, H> &m, std::ostream &o) {
+        o << "{";
+        bool first = true;
+        m.iter().for_each([&](Tuple<const K *, const V *> &&e) {
+            if (!first) {
+                o << ", ";
+            }
+            first = false;
+            fmt::display(o, *e.template get<0>());
+            o << ": ";
+            fmt::display(o, *e.template get<1>());
+        });
+        o << "}";
+    }
+};
+template <typename T, typename H>
+struct fmt::Display<HashSet<T, H>> {
+    static void fmt(const HashSet<T, H> &s, std::ostream &o) {
+        o << "{";
+        bool first = true;
+        s.iter().for_each([&](const T *x) {
+            if (!first) {
+                o << ", ";
+            }
+            first = false;
+            fmt::display(o, *x);
+        });
+        o << "}";
+    }
+};
+
+} // namespace rstd
@@ -3,6 +3,10 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <string>
 
 #include "container.hpp"
 
@@ -123,4 +127,174 @@ rtest_module_(iter_container) {
         assert_(iter_rev.next().is_none());
         assert_(iter_rev.rev().next().is_none());
     }
+    rtest_(size_hint) {
+        std::vector<int> data = {0, 1, 2, 3, 4};
+        auto iter = iter_ref(data);
+        assert_eq_(iter.len(), size_t(5));
+        iter.next().unwrap();
+        assert_eq_(iter.len(), size_t(4));
+        assert_eq_(iter.rev().len(), size_t(4));
+
+        std::set<int> set = {0, 1, 2};
+        assert_(iter_ref(set).size_hint().upper.is_none());
+
+        auto into = into_iter(std::move(set));
+        assert_eq_(into.len(), size_t(3));
+        into.next().unwrap();
+        assert_eq_(into.len(), size_t(2));
+    }
+    rtest_(nth_last_count) {
+        std::vector<int> data = {0, 1, 2, 3, 4, 5, 6};
+        auto iter = iter_ref(data);
+        assert_eq_(*iter.nth(2).unwrap(), 2);
+        assert_eq_(iter.advance_by(2), size_t(2));
+        assert_eq_(*iter.next().unwrap(), 5);
+        assert_eq_(*iter.last().unwrap(), 6);
+        assert_eq_(iter.count(), size_t(0));
+
+        const std::set<int> set = {0, 1, 2, 3};
+        auto set_iter = iter_ref(set);
+        assert_eq_(*set_iter.nth(1).unwrap(), 1);
+        assert_eq_(set_iter.advance_by(5), size_t(2));
+
+        auto into = into_iter(std::vector<std::string>{"a", "b", "c", "d"});
+        assert_eq_(into.nth(1).unwrap(), std::string("b"));
+        assert_eq_(into.count(), size_t(2));
+        auto into_rev = into_iter(std::vector<std::string>{"a", "b", "c", "d"}).rev();
+        assert_eq_(into_rev.nth(1).unwrap(), std::string("c"));
+        assert_eq_(into_rev.last().unwrap(), std::string("a"));
+    }
+    rtest_(into_iter_vector) {
+        std::vector<std::unique_ptr<int>> data;
+        for (int i = 0; i < 4; ++i) {
+            data.push_back(std::make_unique<int>(i));
+        }
+        auto *buf = data.data();
+        auto iter = into_iter(std::move(data));
+        assert_eq_(iter.__buffer(), buf);
+        for (int i = 0; i < 4; ++i) {
+            assert_eq_(*iter.next().unwrap(), i);
+        }
+        assert_(iter.next().is_none());
+    }
+    rtest_(collect_in_place) {
+        std::vector<std::string> data = {"a", "b", "c", "d", "e", "f"};
+        auto *buf = data.data();
+        std::vector<std::string> out = into_iter(std::move(data))
+            .filter([](const std::string &s) { return s != "c"; })
+            .map([](std::string s) { return s + s; })
+            .take(4)
+            .collect<std::vector>();
+        assert_eq_(out.data(), buf);
+        assert_eq_(out.size(), size_t(4));
+        assert_eq_(out[0], std::string("aa"));
+        assert_eq_(out[1], std::string("bb"));
+        assert_eq_(out[2], std::string("dd"));
+        assert_eq_(out[3], std::string("ee"));
+    }
+    rtest_(collect_in_place_fallback) {
+        // Reversed iterator and different item type allocate a new buffer
+        std::vector<int> data = {0, 1, 2, 3};
+        auto *buf = data.data();
+        std::vector<int> rev = into_iter(std::move(data)).rev().collect<std::vector>();
+        assert_(rev.data() != buf);
+        assert_eq_(rev[0], 3);
+        assert_eq_(rev[3], 0);
+
+        std::vector<long> wide = into_iter(std::move(rev))
+            .map([](int x) { return long(x); })
+            .collect<std::vector>();
+        assert_eq_(wide.size(), size_t(4));
+        assert_eq_(wide[0], 3l);
+    }
+    rtest_(cloned_simd) {
+        // Lengths around the vector widths check the kernel tails
+        for (size_t n : {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1000}) {
+            std::vector<int32_t> i32;
+            std::vector<uint64_t> u64;
+            for (size_t i = 0; i < n; ++i) {
+                int32_t x = int32_t((i * 7919) % 1009) - 500;
+                i32.push_back(x);
+                u64.push_back(uint64_t(x) * 3);
+            }
+            int32_t s = 0, mn = INT32_MAX, mx = INT32_MIN;
+            uint64_t su = 0, pu = 1;
+            for (size_t i = 0; i < n; ++i) {
+                s += i32[i];
+                mn = std::min(mn, i32[i]);
+                mx = std::max(mx, i32[i]);
+                su += u64[i];
+                pu *= u64[i] | 1;
+            }
+            assert_eq_(iter_ref(i32).cloned().sum(), s);
+            assert_eq_(iter_ref(u64).cloned().sum(), su);
+            std::vector<uint64_t> odd = iter_ref(u64).map([](const uint64_t *x) { return *x | 1; }).collect<std::vector>();
+            assert_eq_(iter_ref(odd).cloned().product(), pu);
+            assert_eq_(Slice<int32_t>(i32).iter().cloned().sum(), s);
+            if (n > 0) {
+                assert_eq_(iter_ref(i32).cloned().min().unwrap(), mn);
+                assert_eq_(iter_ref(i32).cloned().max().unwrap(), mx);
+                assert_eq_(iter_ref(i32).rev().cloned().max().unwrap(), mx);
+            } else {
+                assert_(iter_ref(i32).cloned().min().is_none());
+            }
+        }
+        std::vector<int> data = {5, 1, 4};
+        auto iter = iter_ref(data).cloned();
+        iter.next().unwrap();
+        assert_eq_(iter.sum(), 5);
+        iter.next().unwrap_none();
+    }
+    rtest_(cloned_product) {
+        std::vector<int32_t> i32 = {3, -2, 5, 1, 1, -1, 7, 2, 2};
+        assert_eq_(iter_ref(i32).cloned().product(), 840);
+        std::vector<double> dd(100, 2.0);
+        dd[37] = 0.5;
+        assert_eq_(iter_ref(dd).cloned().product(), std::ldexp(1.0, 98));
+        std::vector<float> empty;
+        assert_eq_(iter_ref(empty).cloned().product(), 1.0f);
+        // Wraps around like the loop
+        std::vector<int64_t> big(40, int64_t(1) << 3);
+        int64_t p = 1;
+        for (int64_t x : big) {
+            p = int64_t(uint64_t(p) * uint64_t(x));
+        }
+        assert_eq_(iter_ref(big).cloned().product(), p);
+    }
+    rtest_(cloned_pairwise_sum) {
+        // Sequential accumulation of 0.1f loses several digits here
+        std::vector<float> data(10000000, 0.1f);
+        float s = iter_ref(data).cloned().sum();
+        assert_(std::abs(s - 1000000.0f) < 1.0f);
+        std::vector<double> dd = {0.5, 0.25, 0.125};
+        assert_eq_(iter_ref(dd).cloned().sum(), 0.875);
+    }
+    rtest_(next_chunk) {
+        std::vector<int> data = {1, 2, 3, 4, 5};
+        auto refs = iter_ref(data);
+        int *rb[3];
+        assert_eq_(refs.next_chunk(rb, 3), size_t(3));
+        assert_eq_(rb[2], &data[2]);
+        assert_eq_(refs.next().unwrap(), &data[3]);
+
+        std::vector<std::string> strs = {"a", "b", "c"};
+        auto iter = into_iter(std::move(strs));
+        std::string sb[2];
+        assert_eq_(iter.next_chunk(sb, 2), size_t(2));
+        assert_eq_(sb[1], std::string("b"));
+        assert_eq_(iter.next_chunk(sb, 2), size_t(1));
+        assert_eq_(sb[0], std::string("c"));
+
+        auto rev = into_iter(std::vector<int>{1, 2, 3, 4}).rev();
+        int ib[3];
+        assert_eq_(rev.next_chunk(ib, 3), size_t(3));
+        assert_eq_(ib[0], 4);
+        assert_eq_(ib[2], 2);
+        assert_eq_(rev.next().unwrap(), 1);
+
+        auto cloned = iter_ref(data).cloned();
+        assert_eq_(cloned.next_chunk(ib, 3), size_t(3));
+        assert_eq_(ib[2], 3);
+        assert_eq_(cloned.sum(), 9);
+    }
 }
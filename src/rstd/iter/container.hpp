@@ -1,6 +1,9 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include "iterator.hpp"
 
 
@@ -10,7 +13,22 @@ template <template <typename...> typename C, typename T, typename U, typename J>
 class Iter : public Iterator<U, Iter<C, T, U, J>> {
 private:
     J cur, end;
+    static constexpr bool random_access = std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<J>::iterator_category
+    >;
 public:
+    // Elements are stored in a single array, see `iter::Cloned`
+    static constexpr bool contiguous = std::is_pointer_v<J> || (
+        std::is_same_v<C<T>, std::vector<T>> && !std::is_same_v<T, bool> && (
+            std::is_same_v<J, typename std::vector<T>::iterator> ||
+            std::is_same_v<J, typename std::vector<T>::const_iterator>
+        )
+    );
+    // Pointer to the next element, the iterator must be contiguous and non-empty
+    U __data() const {
+        return &*cur;
+    }
     Iter(J begin, J end) :
         cur(begin), end(end)
     {}
@@ -37,6 +55,73 @@ public:
             return Option<U>::None();
         }
     }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        J c = cur;
+        bool done = true;
+        while (c != end) {
+            U i = &*c;
+            ++c;
+            if (!f(std::move(i))) {
+                done = false;
+                break;
+            }
+        }
+        cur = c;
+        return done;
+    }
+    size_t next_chunk(U *buf, size_t n) {
+        if constexpr (random_access) {
+            size_t k = std::min(n, size_t(end - cur));
+            for (size_t i = 0; i < k; ++i) {
+                buf[i] = &*(cur + i);
+            }
+            cur += k;
+            return k;
+        } else {
+            return Iterator<U, Iter>::next_chunk(buf, n);
+        }
+    }
+    // O(1) for random-access containers
+    size_t advance_by(size_t n) {
+        if constexpr (random_access) {
+            size_t k = std::min(n, size_t(end - cur));
+            cur += k;
+            return k;
+        } else {
+            return Iterator<U, Iter>::advance_by(n);
+        }
+    }
+    Option<U> last() {
+        if constexpr (random_access) {
+            if (cur != end) {
+                U i = &*(end - 1);
+                cur = end;
+                return Option<U>::Some(i);
+            } else {
+                return Option<U>::None();
+            }
+        } else {
+            return Iterator<U, Iter>::last();
+        }
+    }
+    size_t count() {
+        if constexpr (random_access) {
+            size_t n = size_t(end - cur);
+            cur = end;
+            return n;
+        } else {
+            return Iterator<U, Iter>::count();
+        }
+    }
+    // Exact for random-access containers
+    iter::SizeHint size_hint() const {
+        if constexpr (random_access) {
+            return iter::SizeHint::exact(size_t(end - cur));
+        } else {
+            return iter::SizeHint::unknown();
+        }
+    }
     typedef Iter<C, T, U, std::reverse_iterator<J>> Rev;
     Rev rev() {
         auto r = Rev(
@@ -72,8 +157,18 @@ private:
     size_t cur, end;
     bool rev_;
 public:
+    // Takes over the buffer of the vector
+    explicit IntoIter(std::vector<T> &&v, bool r=false) :
+        data(std::move(v)), cur(0), end(data.size()), rev_(r)
+    {}
     template <typename J>
     IntoIter(J b, J e, bool r=false) {
+        if constexpr (std::is_base_of_v<
+            std::forward_iterator_tag,
+            typename std::iterator_traits<J>::iterator_category
+        >) {
+            data.reserve(size_t(std::distance(b, e)));
+        }
         for (J j = b; j != e; ++j) {
             data.push_back(std::move(*j));
         }
@@ -115,21 +210,109 @@ public:
             return Option<T>::None();
         }
     }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        size_t c = cur, e = end;
+        bool done = true;
+        if (!rev_) {
+            while (c != e) {
+                T t = std::move(data[c]);
+                ++c;
+                if (!f(std::move(t))) {
+                    done = false;
+                    break;
+                }
+            }
+        } else {
+            while (c != e) {
+                --e;
+                T t = std::move(data[e]);
+                if (!f(std::move(t))) {
+                    done = false;
+                    break;
+                }
+            }
+        }
+        cur = c;
+        end = e;
+        return done;
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = std::min(n, end - cur);
+        if (!rev_) {
+            std::move(data.begin() + cur, data.begin() + (cur + k), buf);
+            cur += k;
+        } else {
+            std::move(data.rbegin() + (data.size() - end), data.rbegin() + (data.size() - end + k), buf);
+            end -= k;
+        }
+        return k;
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, end - cur);
+        if (!rev_) {
+            cur += k;
+        } else {
+            end -= k;
+        }
+        return k;
+    }
+    Option<T> last() {
+        if (cur != end) {
+            T t = std::move(!rev_ ? data[end - 1] : data[cur]);
+            cur = end;
+            return Option<T>::Some(std::move(t));
+        } else {
+            return Option<T>::None();
+        }
+    }
+    size_t count() {
+        size_t n = end - cur;
+        cur = end;
+        return n;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(end - cur);
+    }
     typedef IntoIter Rev;
     Rev rev() {
         rev_ = !rev_;
         return std::move(*this);
     }
+
+    // In-place collection, see `FromIterator`
+    typedef IntoIter InPlaceSource;
+    IntoIter &__in_place_source() {
+        return *this;
+    }
+    // Items can be written to the front of the buffer only while it is consumed from the front
+    bool __in_place_ok() const {
+        return !rev_;
+    }
+    T *__buffer() {
+        return data.data();
+    }
+    // Releases the buffer keeping the first `len` elements
+    std::vector<T> __into_buffer(size_t len) {
+        data.erase(data.begin() + len, data.end());
+        cur = end = 0;
+        return std::move(data);
+    }
 };
 template <
     template <typename...> typename C,
     typename T,
-    typename I=IntoIter<T>
+    typename I
 >
 I into_iter(C<T> &&cont) {
     auto r = I(cont.begin(), cont.end());
     drop(cont);
     return r;
 }
+// Doesn't copy the elements
+template <typename T>
+IntoIter<T> into_iter(std::vector<T> &&cont) {
+    return IntoIter<T>(std::move(cont));
+}
 
 } // namespace rstd
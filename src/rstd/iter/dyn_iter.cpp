@@ -0,0 +1,164 @@
+#include <rtest.hpp>
+
+#include <array>
+#include <vector>
+#include <string>
+#include "dyn_iter.hpp"
+#include "range.hpp"
+#include "container.hpp"
+
+using namespace rstd;
+
+
+static DynIterator<int> pipeline(bool even, int n) {
+    if (even) {
+        return Range(n).filter([](int x) { return x % 2 == 0; });
+    } else {
+        return Range(n).map([](int x) { return 2*x + 1; }).take(3);
+    }
+}
+
+struct NoDefault {
+    int value;
+    explicit NoDefault(int v) : value(v) {}
+};
+
+// Counts default constructions, which are the cost of a heap batch
+struct Tracked {
+    static inline size_t defaults = 0;
+    int value = 0;
+    Tracked() {
+        defaults += 1;
+    }
+    explicit Tracked(int v) : value(v) {}
+};
+
+// Counts `next` calls, internal iteration doesn't go through them
+struct CountingRange : public Iterator<int, CountingRange> {
+    int cur = 0, end = 0;
+    size_t *nexts = nullptr;
+
+    CountingRange(int n, size_t *c) : end(n), nexts(c) {}
+    Option<int> next() {
+        *nexts += 1;
+        if (cur < end) {
+            return Option<int>::Some(cur++);
+        } else {
+            return Option<int>::None();
+        }
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        while (cur < end) {
+            if (!f(cur++)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    typedef void Rev;
+};
+
+rtest_module_(iter_dyn) {
+    rtest_(runtime_pipeline) {
+        auto even = pipeline(true, 10);
+        assert_(even.is_inline());
+        assert_eq_(even.next().unwrap(), 0);
+        assert_eq_(even.sum(), 2 + 4 + 6 + 8);
+        even.next().unwrap_none();
+
+        auto odd = pipeline(false, 10);
+        assert_eq_(odd.len(), size_t(3));
+        auto v = odd.collect<std::vector>();
+        assert_eq_(v.size(), size_t(3));
+        assert_eq_(v[2], 5);
+    }
+    rtest_(heap) {
+        std::array<int, 32> big;
+        for (int i = 0; i < 32; ++i) {
+            big[i] = i;
+        }
+        DynIterator<int> iter = Range(32).map([big](int i) { return big[i]; });
+        assert_(!iter.is_inline());
+        DynIterator<int> moved = std::move(iter);
+        iter.next().unwrap_none();
+        assert_eq_(moved.sum(), 31 * 32 / 2);
+    }
+    rtest_(move_inline) {
+        auto iter = Range(1000).boxed();
+        assert_eq_(iter.next().unwrap(), 0);
+        DynIterator<int> moved = std::move(iter);
+        assert_eq_(moved.next().unwrap(), 1);
+        iter = std::move(moved);
+        assert_eq_(iter.count(), size_t(998));
+    }
+    rtest_(next_chunk) {
+        auto iter = Range(100).boxed();
+        int buf[64];
+        assert_eq_(iter.next_chunk(buf, 64), size_t(64));
+        assert_eq_(buf[63], 63);
+        assert_eq_(iter.next_chunk(buf, 64), size_t(36));
+        assert_eq_(buf[0], 64);
+        assert_eq_(iter.next_chunk(buf, 64), size_t(0));
+    }
+    rtest_(early_stop_keeps_batch) {
+        auto iter = Range(200).boxed();
+        // Stops in the middle of the first batch
+        assert_eq_(iter.find([](int x) { return x == 10; }).unwrap(), 10);
+        assert_eq_(iter.size_hint().lower, size_t(189));
+        assert_eq_(iter.next().unwrap(), 11);
+        assert_eq_(iter.nth(100).unwrap(), 112);
+        int buf[4];
+        assert_eq_(iter.next_chunk(buf, 4), size_t(4));
+        assert_eq_(buf[0], 113);
+        assert_eq_(iter.count(), size_t(200 - 117));
+    }
+    rtest_(early_stop_stack_batch) {
+        // Trivial items are batched on the stack and moved to the heap on early stop
+        auto iter = into_iter(Range(200).collect<std::vector>()).boxed();
+        assert_eq_(iter.find([](int x) { return x == 70; }).unwrap(), 70);
+        assert_eq_(iter.size_hint().lower, size_t(129));
+        assert_eq_(iter.next().unwrap(), 71);
+        assert_eq_(iter.sum(), (71 + 199) * 129 / 2 - 71);
+    }
+    rtest_(adapters_batched) {
+        // Adapters without own `next_chunk` are batched through their `try_for_each`
+        size_t nexts = 0;
+        DynIterator<int> iter = CountingRange(1000, &nexts)
+            .filter([](const int &x) { return x % 3 != 0; })
+            .map([](int x) { return 2 * x; });
+        assert_eq_(iter.sum(), 2 * (999 * 500 - 3 * 333 * 334 / 2));
+        assert_eq_(nexts, size_t(0));
+
+        nexts = 0;
+        DynIterator<int> early = CountingRange(1000, &nexts).map([](int x) { return x + 1; });
+        assert_eq_(early.find([](int x) { return x == 10; }).unwrap(), 10);
+        assert_eq_(early.next().unwrap(), 11);
+        assert_eq_(early.count(), size_t(989));
+        assert_eq_(nexts, size_t(0));
+    }
+    rtest_(batch_cost) {
+        Tracked::defaults = 0;
+
+        std::vector<Tracked> data;
+        for (int i = 0; i < 300; ++i) {
+            data.push_back(Tracked(i));
+        }
+        // The heap batch is created once
+        DynIterator<Tracked> native = into_iter(std::move(data));
+        assert_eq_(native.find([](const Tracked &t) { return t.value == 100; }).unwrap().value, 100);
+        assert_eq_(native.map([](Tracked t) { return t.value; }).sum(), 299 * 150 - 5050);
+        assert_eq_(Tracked::defaults, DynIterator<Tracked>::BATCH_SIZE);
+    }
+    rtest_(non_default_constructible) {
+        DynIterator<NoDefault> iter = Range(5).map([](int x) { return NoDefault(x); });
+        assert_eq_(iter.next().unwrap().value, 0);
+        assert_eq_(iter.map([](NoDefault x) { return x.value; }).sum(), 1 + 2 + 3 + 4);
+    }
+    rtest_(strings) {
+        std::vector<std::string> data = {"a", "b", "c"};
+        DynIterator<std::string> iter = into_iter(std::move(data));
+        assert_eq_(iter.fold(std::string(), [](std::string a, std::string b) { return a + b; }), std::string("abc"));
+        assert_(DynIterator<std::string>().next().is_none());
+    }
+}
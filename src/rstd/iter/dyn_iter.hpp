@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include "iterator.hpp"
+
+
+namespace rstd {
+
+template <typename T>
+class __DynIteratorBase {
+public:
+    virtual ~__DynIteratorBase() = default;
+
+    virtual Option<T> next() = 0;
+    // Move-assigns up to `n` items to `buf`, returns their number.
+    // Returns less than `n` only if the iterator is exhausted.
+    virtual size_t next_chunk(T *buf, size_t n) = 0;
+    virtual size_t advance_by(size_t n) = 0;
+    virtual iter::SizeHint size_hint() const = 0;
+    // Move-constructs the iterator at `place`, used to move inline storage
+    virtual __DynIteratorBase *move_to(void *place) = 0;
+};
+
+template <typename T, typename I>
+class __DynIteratorImpl final : public __DynIteratorBase<T> {
+private:
+    I iter;
+
+public:
+    explicit __DynIteratorImpl(I &&i) : iter(std::move(i)) {}
+
+    Option<T> next() override {
+        return iter.next();
+    }
+    size_t next_chunk(T *buf, size_t n) override {
+        return iter.next_chunk(buf, n);
+    }
+    size_t advance_by(size_t n) override {
+        return iter.advance_by(n);
+    }
+    iter::SizeHint size_hint() const override {
+        return iter.size_hint();
+    }
+    __DynIteratorBase<T> *move_to(void *place) override {
+        return new (place) __DynIteratorImpl(std::move(iter));
+    }
+};
+
+// Type-erased iterator of `T`.
+//
+// Iterators up to `INLINE_SIZE` bytes are stored inline, larger ones are allocated on the heap.
+// Internal iteration (and so all the sinks) fetches items with a single virtual `next_chunk`
+// call per batch of `BATCH_SIZE` items if `T` is default-constructible. The batch is filled by
+// the non-virtual `try_for_each` of the wrapped iterator, so adapters without their own
+// `next_chunk` (`map`, `filter`, ...) are batched as well.
+// Batches of trivial types are read into an uninitialized buffer on the stack. Other types use
+// a heap buffer of `BATCH_SIZE` default-constructed items created on the first batched iteration.
+// Items of a batch that weren't consumed because of early stop are kept for the next calls,
+// moving them to the heap buffer if needed.
+template <typename T>
+class DynIterator final : public Iterator<T, DynIterator<T>> {
+public:
+    static constexpr size_t INLINE_SIZE = 64;
+    static constexpr size_t BATCH_SIZE = 64;
+
+private:
+    static constexpr bool batched = std::is_default_constructible_v<T>;
+    // Default construction of a stack buffer costs nothing
+    static constexpr bool stack_batch = std::is_trivial_v<T>;
+
+    alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+    __DynIteratorBase<T> *impl = nullptr;
+    bool inline_ = false;
+
+    std::unique_ptr<T[]> batch;
+    size_t batch_pos = 0, batch_len = 0;
+
+    void release() {
+        if (impl != nullptr) {
+            if (inline_) {
+                impl->~__DynIteratorBase<T>();
+            } else {
+                delete impl;
+            }
+            impl = nullptr;
+        }
+    }
+    template <typename F>
+    bool batched_try_for_each(F &f) {
+        if constexpr (stack_batch) {
+            T buf[BATCH_SIZE];
+            for (;;) {
+                size_t n = impl->next_chunk(buf, BATCH_SIZE);
+                for (size_t i = 0; i < n; ++i) {
+                    if (!f(std::move(buf[i]))) {
+                        // Keep the rest of the batch
+                        if (!batch) {
+                            batch = std::make_unique<T[]>(BATCH_SIZE);
+                        }
+                        batch_len = n - i - 1;
+                        batch_pos = 0;
+                        std::copy_n(buf + i + 1, batch_len, batch.get());
+                        return false;
+                    }
+                }
+                if (n < BATCH_SIZE) {
+                    return true;
+                }
+            }
+        } else {
+            if (!batch) {
+                batch = std::make_unique<T[]>(BATCH_SIZE);
+            }
+            for (;;) {
+                size_t n = impl->next_chunk(batch.get(), BATCH_SIZE);
+                batch_pos = 0;
+                batch_len = n;
+                while (batch_pos < batch_len) {
+                    T x = std::move(batch[batch_pos]);
+                    batch_pos += 1;
+                    if (!f(std::move(x))) {
+                        return false;
+                    }
+                }
+                if (n < BATCH_SIZE) {
+                    return true;
+                }
+            }
+        }
+    }
+    void take(DynIterator &other) {
+        if (other.impl != nullptr) {
+            if (other.inline_) {
+                impl = other.impl->move_to(storage);
+                other.impl->~__DynIteratorBase<T>();
+            } else {
+                impl = other.impl;
+            }
+            inline_ = other.inline_;
+            other.impl = nullptr;
+        }
+        batch = std::move(other.batch);
+        batch_pos = other.batch_pos;
+        batch_len = other.batch_len;
+        other.batch_pos = other.batch_len = 0;
+    }
+
+public:
+    // Empty iterator
+    DynIterator() = default;
+
+    template <
+        typename I,
+        typename X=std::enable_if_t<
+            iter::__is_iterator<std::remove_reference_t<I>> &&
+            !std::is_same_v<std::decay_t<I>, DynIterator>,
+            void
+        >
+    >
+    DynIterator(I &&iter) {
+        typedef std::decay_t<I> J;
+        static_assert(std::is_same_v<iterator_item<J>, T>);
+        typedef __DynIteratorImpl<T, J> Impl;
+        if constexpr (sizeof(Impl) <= INLINE_SIZE && alignof(Impl) <= alignof(std::max_align_t)) {
+            impl = new (storage) Impl(std::move(iter));
+            inline_ = true;
+        } else {
+            impl = new Impl(std::move(iter));
+            inline_ = false;
+        }
+    }
+
+    DynIterator(const DynIterator &) = delete;
+    DynIterator &operator=(const DynIterator &) = delete;
+
+    DynIterator(DynIterator &&other) {
+        take(other);
+    }
+    DynIterator &operator=(DynIterator &&other) {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+    ~DynIterator() {
+        release();
+    }
+
+    // Whether the wrapped iterator is stored without heap allocation
+    bool is_inline() const {
+        return impl == nullptr || inline_;
+    }
+
+    Option<T> next() {
+        if (batch_pos < batch_len) {
+            T x = std::move(batch[batch_pos]);
+            batch_pos += 1;
+            return Option<T>::Some(std::move(x));
+        }
+        if (impl == nullptr) {
+            return None();
+        }
+        return impl->next();
+    }
+    // Move-assigns up to `n` items to `buf` with a single virtual call, returns their number
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = 0;
+        for (; k < n && batch_pos < batch_len; ++k) {
+            buf[k] = std::move(batch[batch_pos]);
+            batch_pos += 1;
+        }
+        if (k < n && impl != nullptr) {
+            k += impl->next_chunk(buf + k, n - k);
+        }
+        return k;
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        for (; batch_pos < batch_len; ) {
+            T x = std::move(batch[batch_pos]);
+            batch_pos += 1;
+            if (!f(std::move(x))) {
+                return false;
+            }
+        }
+        if (impl == nullptr) {
+            return true;
+        }
+        if constexpr (batched) {
+            return batched_try_for_each(f);
+        } else {
+            return Iterator<T, DynIterator>::try_for_each(f);
+        }
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, batch_len - batch_pos);
+        batch_pos += k;
+        if (k < n && impl != nullptr) {
+            k += impl->advance_by(n - k);
+        }
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        size_t b = batch_len - batch_pos;
+        if (impl == nullptr) {
+            return iter::SizeHint::exact(b);
+        }
+        iter::SizeHint sh = impl->size_hint();
+        return iter::SizeHint(
+            iter::__saturating_add(sh.lower, b),
+            iter::__checked_add(sh.upper, Option<size_t>::Some(b))
+        );
+    }
+    typedef void Rev;
+};
+
+} // namespace rstd
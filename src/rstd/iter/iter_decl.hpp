@@ -1,12 +1,50 @@
 #pragma once
 
+#include <cstdint>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <rstd/prelude.hpp>
 
 
 namespace rstd {
 namespace iter {
 
+// Bounds of the remaining length of an iterator.
+// `upper` is `None` if the length is unknown or exceeds `size_t`.
+struct SizeHint {
+    size_t lower = 0;
+    Option<size_t> upper;
+
+    SizeHint() = default;
+    SizeHint(size_t l, Option<size_t> &&u) : lower(l), upper(std::move(u)) {}
+    SizeHint(size_t l, const Option<size_t> &u) : lower(l), upper(u) {}
+
+    static SizeHint exact(size_t n) {
+        return SizeHint(n, Option<size_t>::Some(n));
+    }
+    static SizeHint unknown() {
+        return SizeHint();
+    }
+    bool is_exact() const {
+        return upper.is_some() && upper.get() == lower;
+    }
+};
+
+// Buffer-owning iterator at the start of an adapter chain which can be collected in place,
+// i.e. every adapter yields at most one item per consumed element of the source.
+// Iterators declare it with `typedef ... InPlaceSource`, it is `void` otherwise.
+template <typename I, typename=void>
+struct InPlaceSource {
+    typedef void type;
+};
+template <typename I>
+struct InPlaceSource<I, std::void_t<typename I::InPlaceSource>> {
+    typedef typename I::InPlaceSource type;
+};
+template <typename I>
+using in_place_source = typename InPlaceSource<I>::type;
+
 template <
     typename T, typename I, typename F,
     typename R=std::invoke_result_t<F, T &&>
@@ -49,6 +87,39 @@ class Zip;
 template <typename T, typename I>
 class StepBy;
 
+template <typename T, typename I>
+class Take;
+
+template <typename T, typename I>
+class Enumerate;
+
+template <typename T, typename I>
+class Cloned;
+
+template <typename T, typename I>
+class Peekable;
+
+template <
+    typename T, typename I, typename F,
+    typename J=std::invoke_result_t<F, T &&>
+>
+class FlatMap;
+
+template <typename T, typename I, typename F>
+class TakeWhile;
+
+template <typename T, typename I, typename F>
+class SkipWhile;
+
+template <typename T, typename I, typename F>
+class Inspect;
+
+template <typename T, typename I, typename F>
+class Dedup;
+
+template <typename T, typename I>
+class Batch;
+
 template <typename T>
 class Empty;
 template <typename T>
@@ -85,9 +156,83 @@ Successors<T, F> successors(Option<T> &&init, F &&f);
 
 template <typename I>
 struct IteratorItem {
-    typedef decltype(((I*)nullptr)->next().unwrap()) type;
+    typedef decltype(std::declval<I &>().next().unwrap()) type;
 };
 template <typename I>
 using iterator_item = typename IteratorItem<I>::type;
 
+template <typename T>
+class IntoIter;
+template <typename T>
+class DynIterator;
+
+namespace vec {
+struct DefaultGrowth;
+} // namespace vec
+template <typename T, typename G=vec::DefaultGrowth>
+class Vec;
+template <
+    template <typename...> typename C,
+    typename T,
+    typename I=IntoIter<T>
+>
+I into_iter(C<T> &&cont);
+template <typename T>
+IntoIter<T> into_iter(std::vector<T> &&cont);
+
+template <typename T, typename Self>
+class Iterator;
+
+namespace iter {
+
+template <typename I, typename=void>
+struct IsIterator : std::false_type {};
+template <typename I>
+struct IsIterator<I, std::void_t<decltype(std::declval<I &>().next().unwrap())>> : std::true_type {};
+template <typename I>
+inline constexpr bool __is_iterator = IsIterator<I>::value;
+
+// Element type of `rcore::simd` kernels for `V`, `void` if there are none
+template <typename V, typename=void>
+struct __SimdElem {
+    typedef void type;
+};
+template <typename V>
+struct __SimdElem<V, std::enable_if_t<
+    std::is_integral_v<V> && !std::is_same_v<V, bool> && (sizeof(V) == 4 || sizeof(V) == 8)
+>> {
+    typedef std::conditional_t<
+        sizeof(V) == 4,
+        std::conditional_t<std::is_signed_v<V>, int32_t, uint32_t>,
+        std::conditional_t<std::is_signed_v<V>, int64_t, uint64_t>
+    > type;
+};
+template <>
+struct __SimdElem<float> {
+    typedef float type;
+};
+template <>
+struct __SimdElem<double> {
+    typedef double type;
+};
+
+// Iterators over a single array declare `static constexpr bool contiguous = true`
+// and provide `__data()` pointing to the next element
+template <typename I, typename=void>
+struct __IsContiguous : std::false_type {};
+template <typename I>
+struct __IsContiguous<I, std::void_t<decltype(I::contiguous)>> : std::bool_constant<I::contiguous> {};
+
+// Whether `I` overrides `next_chunk` instead of using the default one of `Iterator`
+template <typename I>
+inline constexpr bool __native_chunks = !std::is_same_v<
+    decltype(&I::next_chunk),
+    size_t (Iterator<typename I::Item, I>::*)(typename I::Item *, size_t)
+>;
+
+// Number of items requested at once by the sinks consuming chunks
+inline constexpr size_t CHUNK_SIZE = 256;
+
+} // namespace iter
+
 } // namespace rstd
@@ -1,22 +1,59 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <rcore/simd.hpp>
 #include "iter_trait.hpp"
 
 namespace rstd {
 namespace iter {
 
+inline size_t __saturating_add(size_t a, size_t b) {
+    size_t c = a + b;
+    return c < a ? SIZE_MAX : c;
+}
+inline Option<size_t> __checked_add(const Option<size_t> &a, const Option<size_t> &b) {
+    if (a.is_some() && b.is_some() && a.get() + b.get() >= a.get()) {
+        return Option<size_t>::Some(a.get() + b.get());
+    } else {
+        return None();
+    }
+}
+inline Option<size_t> __min_upper(const Option<size_t> &a, const Option<size_t> &b) {
+    if (a.is_some() && b.is_some()) {
+        return Option<size_t>::Some(std::min(a.get(), b.get()));
+    } else if (a.is_some()) {
+        return a;
+    } else {
+        return b;
+    }
+}
+
 template <typename T, typename I, typename F, typename R>
 class Map final : public Iterator<R, Map<T, I, F, R>> {
 private:
     I iter;
     F func;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     Map(I &&i, F &&f) :
         iter(std::move(i)), func(std::move(f))
     {}
     Option<R> next() {
         return iter.next().map(func);
     }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            return f(func(std::move(x)));
+        });
+    }
+    SizeHint size_hint() const {
+        return iter.size_hint();
+    }
     typedef Map<T, typename I::Rev, F> Rev;
     Rev rev() {
         return Rev(iter.rev(), std::move(func));
@@ -29,6 +66,10 @@ private:
     I iter;
     F func;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     MapWhile(I &&i, F &&f) :
         iter(std::move(i)), func(std::move(f))
     {}
@@ -46,6 +87,9 @@ public:
             return None();
         }
     }
+    SizeHint size_hint() const {
+        return SizeHint(0, iter.size_hint().upper);
+    }
     typedef void Rev;
 };
 
@@ -55,12 +99,28 @@ private:
     I iter;
     F func;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     Filter(I &&i, F &&f) :
         iter(std::move(i)), func(std::move(f))
     {}
     Option<T> next() {
         return iter.find(func);
     }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            if (func(x)) {
+                return f(std::move(x));
+            }
+            return true;
+        });
+    }
+    SizeHint size_hint() const {
+        return SizeHint(0, iter.size_hint().upper);
+    }
     typedef Filter<T, typename I::Rev, F> Rev;
     Rev rev() {
         return Rev(iter.rev(), std::move(func));
@@ -73,12 +133,29 @@ private:
     I iter;
     F func;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     FilterMap(I &&i, F &&f) :
         iter(std::move(i)), func(std::move(f))
     {}
     Option<R> next() {
         return iter.find_map(func);
     }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            Option<R> res = func(std::move(x));
+            if (res.is_some()) {
+                return f(res.unwrap());
+            }
+            return true;
+        });
+    }
+    SizeHint size_hint() const {
+        return SizeHint(0, iter.size_hint().upper);
+    }
     typedef FilterMap<T, typename I::Rev, F> Rev;
     Rev rev() {
         return Rev(iter.rev(), std::move(func));
@@ -119,6 +196,31 @@ public:
     Option<T> next() {
         return first.next().or_else([&]() { return second.next(); });
     }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        return first.try_for_each(f) && second.try_for_each(f);
+    }
+    SizeHint size_hint() const {
+        SizeHint a = first.size_hint(), b = second.size_hint();
+        return SizeHint(__saturating_add(a.lower, b.lower), __checked_add(a.upper, b.upper));
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = first.next_chunk(buf, n);
+        if (k < n) {
+            k += second.next_chunk(buf + k, n - k);
+        }
+        return k;
+    }
+    size_t advance_by(size_t n) {
+        size_t k = first.advance_by(n);
+        if (k < n) {
+            k += second.advance_by(n - k);
+        }
+        return k;
+    }
+    size_t count() {
+        return first.count() + second.count();
+    }
     typedef Chain<T, typename J::Rev, typename I::Rev> Rev;
     Rev rev() {
         return Rev(second.rev(), first.rev());
@@ -132,6 +234,10 @@ private:
     S state;
     F func;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     Scan(I &&i, S &&s, F &&f) :
         iter(std::move(i)),
         state(std::move(s)),
@@ -151,6 +257,9 @@ public:
             return None();
         }
     }
+    SizeHint size_hint() const {
+        return SizeHint(0, iter.size_hint().upper);
+    }
     typedef void Rev;
 };
 
@@ -159,6 +268,10 @@ class Fuse final : public Iterator<T, Fuse<T, I>> {
 private:
     I iter;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     Fuse(I &&i) :
         iter(std::move(i))
     {}
@@ -171,6 +284,9 @@ public:
             return None();
         }
     }
+    SizeHint size_hint() const {
+        return iter.size_hint();
+    }
     typedef void Rev;
 };
 
@@ -196,6 +312,10 @@ public:
         }
         return ret;
     }
+    SizeHint size_hint() const {
+        SizeHint a = first.size_hint(), b = second.size_hint();
+        return SizeHint(std::min(a.lower, b.lower), __min_upper(a.upper, b.upper));
+    }
     typedef void Rev;
 };
 
@@ -205,6 +325,10 @@ private:
     I iter;
     size_t step;
 public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
     StepBy(I &&i, size_t s) :
         iter(std::move(i)),
         step(s)
@@ -213,15 +337,620 @@ public:
     }
     Option<T> next() {
         Option<T> ret = iter.next();
-        if (ret.is_none()) {
+        if (ret.is_some()) {
+            iter.advance_by(step - 1);
+        }
+        return ret;
+    }
+    SizeHint size_hint() const {
+        // First element is yielded and then every `step`-th
+        auto div_ceil = [this](size_t n) { return n / step + (n % step != 0 ? 1 : 0); };
+        SizeHint sh = iter.size_hint();
+        return SizeHint(div_ceil(sh.lower), sh.upper.map(div_ceil));
+    }
+    typedef void Rev;
+};
+
+template <typename T, typename I>
+class Take final : public Iterator<T, Take<T, I>> {
+private:
+    I iter;
+    size_t remaining;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+    Take(I &&i, size_t n) :
+        iter(std::move(i)),
+        remaining(n)
+    {}
+    Option<T> next() {
+        if (remaining == 0) {
             return None();
         }
-        for (size_t i = 1; i < step; ++i) {
-            if (iter.next().is_some()) {
-                break;
+        remaining -= 1;
+        return iter.next();
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        if (remaining == 0) {
+            return true;
+        }
+        bool stopped = false;
+        iter.try_for_each([this, &f, &stopped](T &&x) {
+            remaining -= 1;
+            if (!f(std::move(x))) {
+                stopped = true;
+                return false;
             }
+            return remaining != 0;
+        });
+        return !stopped;
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = iter.next_chunk(buf, std::min(n, remaining));
+        remaining -= k;
+        return k;
+    }
+    size_t advance_by(size_t n) {
+        size_t k = iter.advance_by(std::min(n, remaining));
+        remaining -= k;
+        return k;
+    }
+    size_t count() {
+        return advance_by(remaining);
+    }
+    SizeHint size_hint() const {
+        if (remaining == 0) {
+            return SizeHint::exact(0);
         }
-        return ret;
+        SizeHint sh = iter.size_hint();
+        return SizeHint(
+            std::min(sh.lower, remaining),
+            Option<size_t>::Some(sh.upper.is_some() ? std::min(sh.upper.get(), remaining) : remaining)
+        );
+    }
+    typedef void Rev;
+};
+
+template <typename T, typename I>
+class Enumerate final : public Iterator<Tuple<size_t, T>, Enumerate<T, I>> {
+private:
+    I iter;
+    size_t index = 0;
+public:
+    Enumerate(I &&i) :
+        iter(std::move(i))
+    {}
+    Option<Tuple<size_t, T>> next() {
+        return iter.next().map([this](T &&x) {
+            return Tuple<size_t, T>(index++, std::move(x));
+        });
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            return f(Tuple<size_t, T>(index++, std::move(x)));
+        });
+    }
+    size_t advance_by(size_t n) {
+        size_t k = iter.advance_by(n);
+        index += k;
+        return k;
+    }
+    size_t count() {
+        return iter.count();
+    }
+    SizeHint size_hint() const {
+        return iter.size_hint();
+    }
+    typedef void Rev;
+};
+
+// Dereferences pointers yielded by `iter`.
+// Sums over contiguous arrays of arithmetic types use `rcore::simd` kernels,
+// as well as `min` and `max` of integers (floats are compared one by one because of NaNs).
+template <typename T, typename I>
+class Cloned final : public Iterator<std::remove_cv_t<std::remove_pointer_t<T>>, Cloned<T, I>> {
+private:
+    typedef std::remove_cv_t<std::remove_pointer_t<T>> V;
+    typedef typename __SimdElem<V>::type E;
+    static constexpr bool simd = __IsContiguous<I>::value && !std::is_void_v<E>;
+
+    I iter;
+public:
+    Cloned(I &&i) :
+        iter(std::move(i))
+    {}
+    Option<V> next() {
+        return iter.next().map([](T x) { return V(*x); });
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        return iter.try_for_each([&f](T &&x) {
+            return f(V(*x));
+        });
+    }
+    // Copies contiguous arrays at once
+    size_t next_chunk(V *buf, size_t n) {
+        if constexpr (__IsContiguous<I>::value) {
+            size_t k = std::min(n, iter.len());
+            if (k > 0) {
+                std::copy_n(iter.__data(), k, buf);
+                iter.advance_by(k);
+            }
+            return k;
+        } else {
+            return Iterator<V, Cloned>::next_chunk(buf, n);
+        }
+    }
+    size_t advance_by(size_t n) {
+        return iter.advance_by(n);
+    }
+    size_t count() {
+        return iter.count();
+    }
+    SizeHint size_hint() const {
+        return iter.size_hint();
+    }
+
+    V sum() {
+        if constexpr (simd) {
+            size_t n = iter.len();
+            if (n == 0) {
+                return V(0);
+            }
+            V r = V(rcore::simd::sum(reinterpret_cast<const E *>(iter.__data()), n));
+            iter.advance_by(n);
+            return r;
+        } else {
+            return Iterator<V, Cloned>::sum();
+        }
+    }
+    V product() {
+        if constexpr (simd) {
+            size_t n = iter.len();
+            if (n == 0) {
+                return V(1);
+            }
+            V r = V(rcore::simd::product(reinterpret_cast<const E *>(iter.__data()), n));
+            iter.advance_by(n);
+            return r;
+        } else {
+            return Iterator<V, Cloned>::product();
+        }
+    }
+    Option<V> min() {
+        if constexpr (simd && std::is_integral_v<V>) {
+            size_t n = iter.len();
+            if (n == 0) {
+                return None();
+            }
+            V r = V(rcore::simd::min(reinterpret_cast<const E *>(iter.__data()), n));
+            iter.advance_by(n);
+            return Option<V>::Some(r);
+        } else {
+            return Iterator<V, Cloned>::min();
+        }
+    }
+    Option<V> max() {
+        if constexpr (simd && std::is_integral_v<V>) {
+            size_t n = iter.len();
+            if (n == 0) {
+                return None();
+            }
+            V r = V(rcore::simd::max(reinterpret_cast<const E *>(iter.__data()), n));
+            iter.advance_by(n);
+            return Option<V>::Some(r);
+        } else {
+            return Iterator<V, Cloned>::max();
+        }
+    }
+
+    typedef Cloned<T, typename I::Rev> Rev;
+    Rev rev() {
+        return Rev(iter.rev());
+    }
+};
+
+// Allows to look at the next element without consuming it.
+// Only the peeked element is stored.
+template <typename T, typename I>
+class Peekable final : public Iterator<T, Peekable<T, I>> {
+private:
+    I iter;
+    // `Some(None)` means the iterator is exhausted
+    Option<Option<T>> peeked;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+
+    Peekable(I &&i) :
+        iter(std::move(i))
+    {}
+    Option<T> next() {
+        if (peeked.is_some()) {
+            return peeked.take().unwrap();
+        }
+        return iter.next();
+    }
+    // Returns pointer to the next element that stays valid until the iterator is advanced
+    Option<T *> peek() {
+        if (peeked.is_none()) {
+            peeked = Option<Option<T>>::Some(iter.next());
+        }
+        Option<T> &p = peeked.get();
+        if (p.is_some()) {
+            return Option<T *>::Some(&p.get());
+        } else {
+            return None();
+        }
+    }
+    // Consumes the next element only if `f(&x)` returns `true`
+    template <typename F>
+    Option<T> next_if(F &&f) {
+        Option<T *> p = peek();
+        if (p.is_some() && f(*p.get())) {
+            return next();
+        }
+        return None();
+    }
+    Option<T> next_if_eq(const T &value) {
+        return next_if([&value](const T &x) { return x == value; });
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        if (peeked.is_some()) {
+            Option<T> p = peeked.take().unwrap();
+            if (p.is_none()) {
+                return true;
+            }
+            if (!f(p.unwrap())) {
+                return false;
+            }
+        }
+        return iter.try_for_each(f);
+    }
+    size_t advance_by(size_t n) {
+        size_t k = 0;
+        if (n > 0 && peeked.is_some()) {
+            if (peeked.take().unwrap().is_none()) {
+                return 0;
+            }
+            k = 1;
+        }
+        return k + iter.advance_by(n - k);
+    }
+    SizeHint size_hint() const {
+        if (peeked.is_some()) {
+            if (peeked.get().is_none()) {
+                return SizeHint::exact(0);
+            }
+            SizeHint sh = iter.size_hint();
+            return SizeHint(__saturating_add(sh.lower, 1), __checked_add(sh.upper, Option<size_t>::Some(1)));
+        }
+        return iter.size_hint();
+    }
+    typedef void Rev;
+};
+
+// Yields items of the iterators returned by `func` for each element.
+// Holds only the current inner iterator.
+template <typename T, typename I, typename F, typename J>
+class FlatMap final : public Iterator<iterator_item<J>, FlatMap<T, I, F, J>> {
+private:
+    typedef iterator_item<J> U;
+
+    I iter;
+    F func;
+    Option<J> front;
+public:
+    FlatMap(I &&i, F &&f) :
+        iter(std::move(i)), func(std::move(f))
+    {}
+    Option<U> next() {
+        for (;;) {
+            if (front.is_some()) {
+                Option<U> x = front.get().next();
+                if (x.is_some()) {
+                    return x;
+                }
+                front = None();
+            }
+            Option<T> ox = iter.next();
+            if (ox.is_none()) {
+                return None();
+            }
+            front = Option<J>::Some(func(ox.unwrap()));
+        }
+    }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        if (front.is_some()) {
+            if (!front.get().try_for_each(f)) {
+                return false;
+            }
+            front = None();
+        }
+        return iter.try_for_each([this, &f](T &&x) {
+            J inner = func(std::move(x));
+            if (!inner.try_for_each(f)) {
+                front = Option<J>::Some(std::move(inner));
+                return false;
+            }
+            return true;
+        });
+    }
+    SizeHint size_hint() const {
+        SizeHint fh = front.is_some() ? front.get().size_hint() : SizeHint::exact(0);
+        SizeHint sh = iter.size_hint();
+        if (sh.upper.is_some() && sh.upper.get() == 0) {
+            return fh;
+        }
+        return SizeHint(fh.lower, None());
+    }
+    typedef void Rev;
+};
+
+template <typename T, typename I, typename F>
+class TakeWhile final : public Iterator<T, TakeWhile<T, I, F>> {
+private:
+    I iter;
+    F func;
+    bool done = false;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+
+    TakeWhile(I &&i, F &&f) :
+        iter(std::move(i)), func(std::move(f))
+    {}
+    Option<T> next() {
+        if (done) {
+            return None();
+        }
+        Option<T> ox = iter.next();
+        if (ox.is_some() && func(ox.get())) {
+            return ox;
+        }
+        done = true;
+        return None();
+    }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        if (done) {
+            return true;
+        }
+        bool stopped = false;
+        iter.try_for_each([this, &f, &stopped](T &&x) {
+            if (!func(x)) {
+                done = true;
+                return false;
+            }
+            if (!f(std::move(x))) {
+                stopped = true;
+                return false;
+            }
+            return true;
+        });
+        return !stopped;
+    }
+    SizeHint size_hint() const {
+        if (done) {
+            return SizeHint::exact(0);
+        }
+        return SizeHint(0, iter.size_hint().upper);
+    }
+    typedef void Rev;
+};
+
+template <typename T, typename I, typename F>
+class SkipWhile final : public Iterator<T, SkipWhile<T, I, F>> {
+private:
+    I iter;
+    F func;
+    bool skipping = true;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+
+    SkipWhile(I &&i, F &&f) :
+        iter(std::move(i)), func(std::move(f))
+    {}
+    Option<T> next() {
+        if (skipping) {
+            skipping = false;
+            return iter.find([this](const T &x) { return !func(x); });
+        }
+        return iter.next();
+    }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            if (skipping) {
+                if (func(x)) {
+                    return true;
+                }
+                skipping = false;
+            }
+            return f(std::move(x));
+        });
+    }
+    SizeHint size_hint() const {
+        SizeHint sh = iter.size_hint();
+        return skipping ? SizeHint(0, sh.upper) : sh;
+    }
+    typedef void Rev;
+};
+
+template <typename T, typename I, typename F>
+class Inspect final : public Iterator<T, Inspect<T, I, F>> {
+private:
+    I iter;
+    F func;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+
+    Inspect(I &&i, F &&f) :
+        iter(std::move(i)), func(std::move(f))
+    {}
+    Option<T> next() {
+        Option<T> ox = iter.next();
+        if (ox.is_some()) {
+            func(static_cast<const T &>(ox.get()));
+        }
+        return ox;
+    }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        return iter.try_for_each([this, &f](T &&x) {
+            func(static_cast<const T &>(x));
+            return f(std::move(x));
+        });
+    }
+    SizeHint size_hint() const {
+        return iter.size_hint();
+    }
+    typedef Inspect<T, typename I::Rev, F> Rev;
+    Rev rev() {
+        return Rev(iter.rev(), std::move(func));
+    }
+};
+
+// Keeps only the pending element which is yielded when a different one arrives
+template <typename T, typename I, typename F>
+class Dedup final : public Iterator<T, Dedup<T, I, F>> {
+private:
+    I iter;
+    F func;
+    Option<T> pending;
+public:
+    typedef in_place_source<I> InPlaceSource;
+    decltype(auto) __in_place_source() {
+        return iter.__in_place_source();
+    }
+
+    Dedup(I &&i, F &&f) :
+        iter(std::move(i)), func(std::move(f))
+    {}
+    Option<T> next() {
+        if (pending.is_none()) {
+            pending = iter.next();
+            if (pending.is_none()) {
+                return None();
+            }
+        }
+        for (;;) {
+            Option<T> ox = iter.next();
+            if (ox.is_none()) {
+                return pending.take();
+            }
+            if (!func(static_cast<const T &>(pending.get()), static_cast<const T &>(ox.get()))) {
+                Option<T> ret = pending.take();
+                pending = std::move(ox);
+                return ret;
+            }
+        }
+    }
+    template <typename G>
+    bool try_for_each(G &&f) {
+        bool stopped = false;
+        iter.try_for_each([this, &f, &stopped](T &&x) {
+            if (pending.is_none()) {
+                pending = Option<T>::Some(std::move(x));
+                return true;
+            }
+            if (func(static_cast<const T &>(pending.get()), static_cast<const T &>(x))) {
+                return true;
+            }
+            T prev = pending.take().unwrap();
+            pending = Option<T>::Some(std::move(x));
+            if (!f(std::move(prev))) {
+                stopped = true;
+                return false;
+            }
+            return true;
+        });
+        if (stopped) {
+            return false;
+        }
+        if (pending.is_some()) {
+            return f(pending.take().unwrap());
+        }
+        return true;
+    }
+    SizeHint size_hint() const {
+        SizeHint sh = iter.size_hint();
+        size_t p = pending.is_some() ? 1 : 0;
+        return SizeHint(
+            std::min(__saturating_add(sh.lower, p), size_t(1)),
+            __checked_add(sh.upper, Option<size_t>::Some(p))
+        );
+    }
+    typedef void Rev;
+};
+
+// Groups items into vectors of up to `n` elements filled with `next_chunk`.
+// A vector passed back with `recycle` is reused for the next batch instead of allocating a new one.
+template <typename T, typename I>
+class Batch final : public Iterator<std::vector<T>, Batch<T, I>> {
+private:
+    I iter;
+    size_t size;
+    std::vector<T> spare;
+
+    static size_t div_ceil(size_t a, size_t b) {
+        return a / b + (a % b != 0 ? 1 : 0);
+    }
+public:
+    Batch(I &&i, size_t n) :
+        iter(std::move(i)),
+        size(n)
+    {
+        assert_(n > 0);
+    }
+    Option<std::vector<T>> next() {
+        std::vector<T> v = std::move(spare);
+        spare = std::vector<T>();
+        v.clear();
+        if constexpr (std::is_default_constructible_v<T>) {
+            v.resize(size);
+            v.resize(iter.next_chunk(v.data(), size));
+        } else {
+            v.reserve(size);
+            iter.try_for_each([this, &v](T &&x) {
+                v.push_back(std::move(x));
+                return v.size() < size;
+            });
+        }
+        if (v.empty()) {
+            spare = std::move(v);
+            return None();
+        }
+        return Option<std::vector<T>>::Some(std::move(v));
+    }
+    // Gives back a consumed batch so that its buffer is reused
+    void recycle(std::vector<T> &&v) {
+        if (v.capacity() > spare.capacity()) {
+            spare = std::move(v);
+        }
+    }
+    SizeHint size_hint() const {
+        SizeHint sh = iter.size_hint();
+        return SizeHint(
+            div_ceil(sh.lower, size),
+            sh.upper.is_some() ? Option<size_t>::Some(div_ceil(sh.upper.get(), size)) : Option<size_t>::None()
+        );
     }
     typedef void Rev;
 };
@@ -230,6 +959,9 @@ template <typename T>
 class Empty final : public Iterator<T, Empty<T>> {
 public:
     Option<T> next() { return None(); }
+    template <typename F>
+    bool try_for_each(F &&) { return true; }
+    SizeHint size_hint() const { return SizeHint::exact(0); }
     typedef Empty<T> Rev;
     Rev rev() { return std::move(*this); }
 };
@@ -246,6 +978,7 @@ private:
 public:
     Once(T &&e) : Once(Some(std::move(e))) {}
     Option<T> next() { return std::move(elem); }
+    SizeHint size_hint() const { return SizeHint::exact(elem.is_some() ? 1 : 0); }
     typedef Once<T> Rev;
     Rev rev() { return Rev(std::move(elem)); }
 };
@@ -262,6 +995,7 @@ private:
 public:
     OnceWith(F &&f) : OnceWith(Some(std::move(f))) {}
     Option<R> next() { return func.map([](F &&f) { return f(); }); }
+    SizeHint size_hint() const { return SizeHint::exact(func.is_some() ? 1 : 0); }
     typedef OnceWith<F> Rev;
     Rev rev() { return Rev(std::move(func)); }
 };
@@ -279,6 +1013,7 @@ public:
     Repeat(T &&e) : Repeat(Some(std::move(e))) {}
     Repeat(const T &e) : Repeat(clone(e)) {}
     Option<T> next() { return clone(elem); }
+    SizeHint size_hint() const { return SizeHint(SIZE_MAX, None()); }
     typedef Repeat<T> Rev;
     Rev rev() { return Rev(std::move(elem)); }
 };
@@ -299,6 +1034,7 @@ private:
 public:
     RepeatWith(F &&f) : RepeatWith(Some(std::move(f))) {}
     Option<R> next() { return clone(func).map([](F &&f) { return f(); }); }
+    SizeHint size_hint() const { return SizeHint(SIZE_MAX, None()); }
     typedef RepeatWith<F> Rev;
     Rev rev() { return Rev(std::move(func)); }
 };
@@ -322,6 +1058,13 @@ public:
         prev = prev.and_then([&](T &&x) { return func(x); });
         return ret;
     }
+    SizeHint size_hint() const {
+        if (prev.is_some()) {
+            return SizeHint(1, None());
+        } else {
+            return SizeHint::exact(0);
+        }
+    }
     typedef void Rev;
 };
 template <typename T, typename F>
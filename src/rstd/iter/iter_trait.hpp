@@ -1,23 +1,93 @@
 #pragma once
 
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <rcore/simd.hpp>
 #include "iter_decl.hpp"
 
 
 namespace rstd {
 
+template <typename C, typename=void>
+struct _HasReserve : std::false_type {};
+template <typename C>
+struct _HasReserve<C, std::void_t<decltype(std::declval<C &>().reserve(size_t(0)))>> : std::true_type {};
+
+// Reserves space for `n` elements if the container supports it
+template <typename C>
+void __reserve(C &cont, size_t n) {
+    if constexpr (_HasReserve<C>::value) {
+        cont.reserve(n);
+    }
+}
+
+template <typename C, typename T, typename=void>
+struct _HasExtendOne : std::false_type {};
+template <typename C, typename T>
+struct _HasExtendOne<C, T, std::void_t<decltype(std::declval<C &>().extend_one(std::declval<T>()))>> : std::true_type {};
+
+// Adds an element with `extend_one` if the container has it (e.g. maps and sets), otherwise with `push_back`
+template <typename C, typename T>
+void __extend_one(C &cont, T &&x) {
+    if constexpr (_HasExtendOne<C, T>::value) {
+        cont.extend_one(std::move(x));
+    } else {
+        cont.push_back(std::move(x));
+    }
+}
+
 template <template <typename...> typename Cont>
 struct FromIterator {
     template <typename T, typename I> 
     static Cont<T> from_iter(I &&iter) {
-        Cont<T> cont;
-        for (;;) {
-            Option<T> ne = iter.next();
-            if (ne.is_some()) {
-                cont.push_back(ne.unwrap());
-            } else {
-                break;
+        typedef iter::in_place_source<std::remove_reference_t<I>> S;
+        if constexpr (!std::is_void_v<S>) {
+            typedef decltype(std::declval<S &>().__into_buffer(size_t(0))) B;
+            if constexpr (std::is_same_v<typename S::Item, T> && std::is_same_v<B, Cont<T>>) {
+                // Each item is written over an already consumed element of the source buffer
+                auto &src = iter.__in_place_source();
+                if (src.__in_place_ok()) {
+                    T *buf = src.__buffer();
+                    size_t len = 0;
+                    iter.for_each([buf, &len](T &&x) {
+                        buf[len] = std::move(x);
+                        len += 1;
+                    });
+                    return src.__into_buffer(len);
+                }
             }
         }
+        typedef std::remove_reference_t<I> J;
+        if constexpr (
+            (std::is_same_v<Cont<T>, std::vector<T>> || std::is_same_v<Cont<T>, Vec<T>>) &&
+            iter::__native_chunks<J> && std::is_default_constructible_v<T>
+        ) {
+            // Items are written directly to the vector storage a chunk at a time
+            Cont<T> vec;
+            iter::SizeHint sh = iter.size_hint();
+            if (sh.is_exact()) {
+                vec.resize(sh.lower);
+                vec.resize(iter.next_chunk(vec.data(), sh.lower));
+                return vec;
+            }
+            size_t n = std::max(sh.lower, iter::CHUNK_SIZE);
+            for (;;) {
+                size_t len = vec.size();
+                vec.resize(len + n);
+                size_t k = iter.next_chunk(vec.data() + len, n);
+                if (k < n) {
+                    vec.resize(len + k);
+                    return vec;
+                }
+                n = iter::CHUNK_SIZE;
+            }
+        }
+        Cont<T> cont;
+        __reserve(cont, iter.size_hint().lower);
+        iter.for_each([&cont](T &&x) {
+            cont.push_back(std::move(x));
+        });
         return cont;
     }
 };
@@ -32,7 +102,44 @@ private:
 public:
     typedef T Item;
 
-    
+    // Bounds of the remaining length. Should be overridden by iterators that know them.
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::unknown();
+    }
+    // Exact remaining length. Panics if the iterator doesn't know it.
+    size_t len() const {
+        iter::SizeHint sh = self().size_hint();
+        assert_(sh.is_exact());
+        return sh.lower;
+    }
+
+    // Skips up to `n` elements and returns the number of skipped ones,
+    // which is less than `n` only if the iterator is exhausted.
+    // Should be overridden by iterators that can skip in O(1).
+    size_t advance_by(size_t n) {
+        size_t k = 0;
+        if (n > 0) {
+            self().try_for_each([&k, n](T &&) {
+                k += 1;
+                return k < n;
+            });
+        }
+        return k;
+    }
+    Option<T> nth(size_t n) {
+        if (self().advance_by(n) < n) {
+            return None();
+        }
+        return self().next();
+    }
+    Option<T> last() {
+        Option<T> res;
+        self().for_each([&res](T &&x) {
+            res = Option<T>::Some(std::move(x));
+        });
+        return res;
+    }
+
     template <typename F>
     iter::Map<T, Self, F> map(F &&f) {
         return iter::Map<T, Self, F>(std::move(self()), std::move(f));
@@ -71,111 +178,230 @@ public:
         return iter::StepBy<T, Self>(std::move(self()), step);
     }
     template <typename T_=T, typename X=std::enable_if_t<std::is_pointer_v<T_>, void>>
-    decltype(auto) cloned() {
-        return self().map([](T_ x) { return *x; });
+    iter::Cloned<T_, Self> cloned() {
+        return iter::Cloned<T_, Self>(std::move(self()));
     }
-    decltype(auto) enumerate() {
-        auto endless = iter::successors(Some<size_t>(0), [](size_t x) {
-            return Option<size_t>::Some(x + 1);
-        });
-        return endless.zip(std::move(self()));
+    iter::Enumerate<T, Self> enumerate() {
+        return iter::Enumerate<T, Self>(std::move(self()));
+    }
+    iter::Take<T, Self> take(size_t n) {
+        return iter::Take<T, Self>(std::move(self()), n);
     }
-    decltype(auto) take(size_t n) {
-        return self().scan((size_t)0, [n](size_t *p, T &&x) -> Option<T> {
-            if (*p < n) {
-                *p += 1;
-                return Some(std::move(x));
+    // Type-erased iterator, see `DynIterator`
+    DynIterator<T> boxed() {
+        return DynIterator<T>(std::move(self()));
+    }
+    iter::Peekable<T, Self> peekable() {
+        return iter::Peekable<T, Self>(std::move(self()));
+    }
+    // `f` returns an iterator for each element, their items are yielded one by one
+    template <typename F>
+    iter::FlatMap<T, Self, F> flat_map(F &&f) {
+        return iter::FlatMap<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // Elements must be iterators or containers that can be passed to `into_iter`
+    decltype(auto) flatten() {
+        return self().flat_map([](T &&x) {
+            if constexpr (iter::__is_iterator<T>) {
+                return std::move(x);
             } else {
-                return None();
+                return into_iter(std::move(x));
             }
         });
     }
+    template <typename F>
+    iter::TakeWhile<T, Self, F> take_while(F &&f) {
+        return iter::TakeWhile<T, Self, F>(std::move(self()), std::move(f));
+    }
+    template <typename F>
+    iter::SkipWhile<T, Self, F> skip_while(F &&f) {
+        return iter::SkipWhile<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // Calls `f` with a reference to each element before passing it on
+    template <typename F>
+    iter::Inspect<T, Self, F> inspect(F &&f) {
+        return iter::Inspect<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // Removes consecutive repeated elements
+    iter::Dedup<T, Self, std::equal_to<T>> dedup() {
+        return iter::Dedup<T, Self, std::equal_to<T>>(std::move(self()), std::equal_to<T>());
+    }
+    // Removes consecutive elements for which `f(&prev, &next)` returns `true`
+    template <typename F>
+    iter::Dedup<T, Self, F> dedup_by(F &&f) {
+        return iter::Dedup<T, Self, F>(std::move(self()), std::move(f));
+    }
+    // Vectors of up to `n` elements, see `iter::Batch`
+    iter::Batch<T, Self> batch(size_t n) {
+        return iter::Batch<T, Self>(std::move(self()), n);
+    }
     decltype(auto) skip(size_t n) {
-        for (size_t i = 0; i < n; ++i) {
-            if (self().next().is_none()) {
-                break;
-            }
-        }
+        self().advance_by(n);
         return std::move(self());
     }
 
+    // Internal iteration: calls `f(x)` for each element until it returns `false`.
+    // Returns `true` if the iterator is exhausted and `false` if it was stopped by `f`.
+    // Adapters override it to avoid constructing `Option` for each element,
+    // so that all the sinks below compile to a plain loop.
     template <typename F>
-    Option<T> find(F &&f) {
-        static_assert(std::is_same_v<std::invoke_result_t<F, T>, bool>);
+    bool try_for_each(F &&f) {
         for (;;) {
-            Option<T> res = self().next();
-            if (res.is_some()) {
-                T x = res.unwrap();
-                if (f(x)) {
-                    return Some(std::move(x));
-                }
-            } else {
-                return None();
+            Option<T> ox = self().next();
+            if (ox.is_none()) {
+                return true;
+            }
+            if (!f(ox.unwrap())) {
+                return false;
             }
         }
     }
-    template <typename F, typename U=option_some_type<std::invoke_result_t<F, T>>>
-    Option<T> find_map(F &&f) {
-        static_assert(std::is_same_v<std::invoke_result_t<F, T>, Option<U>>);
-        for (;;) {
-            Option<T> res = self().next();
-            if (res.is_some()) {
-                Option<U> ox = f(res.unwrap());
-                if (ox.is_some()) {
-                    return ox;
-                }
-            } else {
-                return None();
-            }
+    // Batched iteration: move-assigns up to `n` items to `buf` and returns their number,
+    // which is less than `n` only if the iterator is exhausted.
+    // Should be overridden by iterators that can produce items in bulk,
+    // `collect` into a vector and `sum` then consume whole chunks.
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = 0;
+        if (n > 0) {
+            self().try_for_each([buf, n, &k](T &&x) {
+                buf[k] = std::move(x);
+                k += 1;
+                return k < n;
+            });
         }
+        return k;
+    }
+    template <typename F>
+    void for_each(F &&f) {
+        self().try_for_each([&f](T &&x) {
+            f(std::move(x));
+            return true;
+        });
+    }
+    // Folds elements into `acc` while `f(acc, x)` returns `true`.
+    // Returns `true` if the iterator is exhausted.
+    template <typename B, typename F>
+    bool try_fold(B &acc, F &&f) {
+        return self().try_for_each([&acc, &f](T &&x) {
+            return bool(f(acc, std::move(x)));
+        });
     }
     template <typename B, typename F>
     B fold(B &&init, F &&f) {
-        for (;;) {
-            Option<T> ox = self().next();
-            if (ox.is_some()) {
-                init = f(std::move(init), ox.unwrap());
-            } else {
-                return std::move(init);
+        B acc(std::move(init));
+        self().try_for_each([&acc, &f](T &&x) {
+            acc = f(std::move(acc), std::move(x));
+            return true;
+        });
+        return acc;
+    }
+
+    template <typename F>
+    Option<T> find(F &&f) {
+        static_assert(std::is_same_v<std::invoke_result_t<F, T>, bool>);
+        Option<T> res;
+        self().try_for_each([&res, &f](T &&x) {
+            if (f(x)) {
+                res = Option<T>::Some(std::move(x));
+                return false;
             }
-        }
+            return true;
+        });
+        return res;
     }
-    template <template <typename...> typename C>
+    template <typename F, typename U=option_some_type<std::invoke_result_t<F, T>>>
+    Option<U> find_map(F &&f) {
+        static_assert(std::is_same_v<std::invoke_result_t<F, T>, Option<U>>);
+        Option<U> res;
+        self().try_for_each([&res, &f](T &&x) {
+            res = f(std::move(x));
+            return res.is_none();
+        });
+        return res;
+    }
+    // Collects into `Vec` by default
+    template <template <typename...> typename C=Vec>
     C<T> collect() {
         return FromIterator<C>::template from_iter<T>(std::move(self()));
     }
+    // Collects into a container type with `push_back` or `extend_one`, e.g. `SmallVec<T, 8>` or `HashMap<K, V>`
+    template <typename C, typename X=std::enable_if_t<std::is_same_v<typename C::value_type, T>, void>>
+    C collect() {
+        C cont;
+        __reserve(cont, self().size_hint().lower);
+        self().for_each([&cont](T &&x) {
+            __extend_one(cont, std::move(x));
+        });
+        return cont;
+    }
+    // Collects elements for which `f` returns `true` into the first container and the rest into the second
+    template <template <typename...> typename C, typename F>
+    Tuple<C<T>, C<T>> partition(F &&f) {
+        C<T> yes, no;
+        self().for_each([&](T &&x) {
+            if (f(x)) {
+                yes.push_back(std::move(x));
+            } else {
+                no.push_back(std::move(x));
+            }
+        });
+        return Tuple<C<T>, C<T>>(std::move(yes), std::move(no));
+    }
     size_t count() {
-        return self().fold((size_t)0, [](size_t a, auto) { return a + 1; });
+        size_t n = 0;
+        self().for_each([&n](T &&) { n += 1; });
+        return n;
     }
     template <typename F>
     bool any(F f=[](bool x) { return x; }) {
-        return self().find(f).is_some();
+        return !self().try_for_each([&f](T &&x) { return !f(x); });
     }
     template <typename F>
     bool all(F f=[](bool x) { return x; }) {
-        return self().find([&f](const T &x) { return !f(x); }).is_none();
+        return self().try_for_each([&f](T &&x) { return bool(f(x)); });
     }
+    // Returns the first minimal element
     Option<T> min() {
-        return self().fold(Option<T>::None(), [](Option<T> op, T &&x) {
-            return Option<T>::Some(op.match(
-                [&](T &&w) { return w <= x ? w : x; },
-                [&]() { return x; }
-            ));
+        Option<T> res;
+        self().for_each([&res](T &&x) {
+            if (res.is_none() || x < res.get()) {
+                res = Option<T>::Some(std::move(x));
+            }
         });
+        return res;
     }
+    // Returns the first maximal element
     Option<T> max() {
-        return self().fold(Option<T>::None(), [](Option<T> op, T &&x) {
-            return Option<T>::Some(op.match(
-                [&](T &&w) { return w >= x ? w : x; },
-                [&]() { return x; }
-            ));
+        Option<T> res;
+        self().for_each([&res](T &&x) {
+            if (res.is_none() || x > res.get()) {
+                res = Option<T>::Some(std::move(x));
+            }
         });
+        return res;
     }
+    // Chunks of native batched iterators are summed with `rcore::simd` kernels
     T sum() {
-        return self().fold(T(0), [](T &&x, T &&y) { return x + y; });
+        typedef typename iter::__SimdElem<T>::type E;
+        T acc(0);
+        if constexpr (iter::__native_chunks<Self> && !std::is_void_v<E>) {
+            T buf[iter::CHUNK_SIZE];
+            for (;;) {
+                size_t k = self().next_chunk(buf, iter::CHUNK_SIZE);
+                acc = acc + T(rcore::simd::sum(reinterpret_cast<const E *>(buf), k));
+                if (k < iter::CHUNK_SIZE) {
+                    return acc;
+                }
+            }
+        } else {
+            self().for_each([&acc](T &&x) { acc = acc + x; });
+            return acc;
+        }
     }
     T product() {
-        return self().fold(T(1), [](T &&x, T &&y) { return x * y; });
+        T acc(1);
+        self().for_each([&acc](T &&x) { acc = acc * x; });
+        return acc;
     }
 
 private:
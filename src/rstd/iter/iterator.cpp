@@ -280,4 +280,281 @@ rtest_module_(iterator) {
         }
         assert_(iter.next().is_none());
     }
+    rtest_(size_hint) {
+        auto exact = [](const iter::SizeHint &sh, size_t n) {
+            return sh.is_exact() && sh.lower == n;
+        };
+        assert_(exact(Range(10).size_hint(), 10));
+        assert_(exact(Range(5, 3).size_hint(), 0));
+        assert_(exact(Range(10).map([](int x) { return x; }).size_hint(), 10));
+        assert_(exact(Range(10).chain(Range(5)).size_hint(), 15));
+        assert_(exact(Range(10).zip(Range(3)).size_hint(), 3));
+        assert_(exact(Range(10).step_by(3).size_hint(), 4));
+        assert_(exact(Range(10).take(4).size_hint(), 4));
+        assert_(exact(Range(3).take(4).size_hint(), 3));
+        assert_(exact(Range(10).skip(4).size_hint(), 6));
+        assert_(exact(iter::once(1).size_hint(), 1));
+        assert_(exact(iter::empty<int>().size_hint(), 0));
+
+        auto filtered = Range(10).filter([](int x) { return x % 2 == 0; }).size_hint();
+        assert_eq_(filtered.lower, size_t(0));
+        assert_eq_(filtered.upper.get(), size_t(10));
+
+        auto infinite = iter::repeat(1).take(5).size_hint();
+        assert_(exact(infinite, 5));
+        assert_(iter::repeat(1).size_hint().upper.is_none());
+    }
+    rtest_(len) {
+        auto iter = Range(10).map([](int x) { return x*x; });
+        assert_eq_(iter.len(), size_t(10));
+        iter.next().unwrap();
+        assert_eq_(iter.len(), size_t(9));
+    }
+    rtest_should_panic_(len_unknown) {
+        Range(10).filter([](int x) { return x % 2 == 0; }).len();
+    }
+    rtest_(collect_reserve) {
+        // Single allocation of exact size
+        std::vector<int> vec = Range(1000).map([](int x) { return 2*x; }).collect<std::vector>();
+        assert_eq_(vec.size(), size_t(1000));
+        assert_eq_(vec.capacity(), size_t(1000));
+    }
+    rtest_(try_for_each) {
+        auto iter = Range(10);
+        std::vector<int> seen;
+        assert_(!iter.try_for_each([&](int x) {
+            seen.push_back(x);
+            return x < 3;
+        }));
+        assert_eq_(seen.size(), size_t(4));
+        // Iteration continues after the stopping element
+        assert_eq_(iter.next().unwrap(), 4);
+        assert_(iter.try_for_each([](int) { return true; }));
+        iter.next().unwrap_none();
+    }
+    rtest_(try_fold) {
+        auto iter = Range(10).rev();
+        int acc = 0;
+        assert_(!iter.try_fold(acc, [](int &a, int x) {
+            a += x;
+            return a < 20;
+        }));
+        assert_eq_(acc, 9 + 8 + 7);
+        assert_eq_(iter.next().unwrap(), 6);
+    }
+    rtest_(internal_adapters) {
+        // Chain, map, filter, filter_map and take stop at the same element as `next()` would
+        auto iter = Range(5).chain(Range(10, 20))
+            .map([](int x) { return 2*x; })
+            .filter([](int x) { return x % 3 != 0; })
+            .filter_map([](int x) {
+                return x != 22 ? Option<int>::Some(x + 1) : Option<int>::None();
+            })
+            .take(6);
+        auto copy = clone(iter);
+        std::vector<int> ext;
+        for (int x : copy) {
+            ext.push_back(x);
+        }
+        std::vector<int> in;
+        iter.for_each([&](int x) { in.push_back(x); });
+        assert_eq_(in.size(), ext.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            assert_eq_(in[i], ext[i]);
+        }
+        assert_eq_(in.size(), size_t(6));
+        iter.next().unwrap_none();
+    }
+    rtest_(take_stops_inner) {
+        auto iter = Range(10);
+        auto take = iter.take(3);
+        assert_(take.try_for_each([](int) { return true; }));
+        assert_(take.next().is_none());
+    }
+    rtest_(sinks) {
+        assert_eq_(Range(1, 5).sum(), 10);
+        assert_eq_(Range(1, 5).product(), 24);
+        assert_eq_(Range(10).filter([](int x) { return x % 3 == 0; }).count(), size_t(4));
+        assert_eq_(Range(10).map([](int x) { return (x - 4)*(x - 4); }).min().unwrap(), 0);
+        assert_eq_(Range(10).map([](int x) { return (x - 4)*(x - 4); }).max().unwrap(), 25);
+        assert_(Range(0).min().is_none());
+        assert_(Range(10).any([](int x) { return x == 7; }));
+        assert_(!Range(10).any([](int x) { return x == 10; }));
+        assert_(Range(10).all([](int x) { return x < 10; }));
+        assert_(!Range(10).all([](int x) { return x < 9; }));
+        assert_eq_(Range(10).fold(std::string(), [](std::string s, int x) {
+            return s + std::to_string(x);
+        }), std::string("0123456789"));
+    }
+    rtest_(step_by_large) {
+        auto iter = Range(0, 10).step_by(3);
+        assert_eq_(iter.next().unwrap(), 0);
+        assert_eq_(iter.next().unwrap(), 3);
+        assert_eq_(iter.next().unwrap(), 6);
+        assert_eq_(iter.next().unwrap(), 9);
+        assert_(iter.next().is_none());
+    }
+    rtest_(skip_large) {
+        // Skips in O(1) for random-access sources
+        auto skipped = Range<uint64_t>(1ull << 40).skip((1ull << 40) - 2);
+        assert_eq_(skipped.next().unwrap(), (1ull << 40) - 2);
+        auto chained = Range(5).chain(Range(100, 200)).skip(10);
+        assert_eq_(chained.next().unwrap(), 105);
+        auto taken = Range<uint64_t>(1ull << 40).take(1000).skip(998);
+        assert_eq_(taken.count(), size_t(2));
+    }
+    rtest_(enumerate_nth) {
+        auto iter = Range(100, 200).enumerate();
+        auto x = iter.nth(10).unwrap();
+        assert_eq_(x.get<0>(), size_t(10));
+        assert_eq_(x.get<1>(), 110);
+        assert_eq_(iter.size_hint().lower, size_t(89));
+        auto sum = iter.map([](Tuple<size_t, int> t) { return t.get<0>(); }).take(2).sum();
+        assert_eq_(sum, size_t(11 + 12));
+    }
+    rtest_(nth_last) {
+        auto iter = Range(10).filter([](int x) { return x % 2 == 1; });
+        assert_eq_(iter.nth(1).unwrap(), 3);
+        assert_eq_(iter.last().unwrap(), 9);
+        iter.nth(0).unwrap_none();
+    }
+    rtest_(peekable) {
+        auto iter = Range(5).peekable();
+        assert_eq_(*iter.peek().unwrap(), 0);
+        assert_eq_(*iter.peek().unwrap(), 0);
+        assert_eq_(iter.size_hint().lower, size_t(5));
+        assert_eq_(iter.next().unwrap(), 0);
+        assert_(iter.next_if([](int x) { return x > 3; }).is_none());
+        assert_eq_(iter.next_if_eq(1).unwrap(), 1);
+        assert_eq_(*iter.peek().unwrap(), 2);
+        assert_eq_(iter.sum(), 2 + 3 + 4);
+        assert_(iter.peek().is_none());
+        assert_eq_(iter.size_hint().upper.get(), size_t(0));
+        iter.next().unwrap_none();
+
+        auto skipped = Range(10).peekable();
+        skipped.peek().unwrap();
+        assert_eq_(skipped.nth(3).unwrap(), 3);
+    }
+    rtest_(flat_map) {
+        auto iter = Range(1, 4).flat_map([](int x) { return Range(x); });
+        std::vector<int> ext;
+        for (int x : clone(iter)) {
+            ext.push_back(x);
+        }
+        std::vector<int> expected = {0, 0, 1, 0, 1, 2};
+        assert_(ext == expected);
+        assert_eq_(iter.next().unwrap(), 0);
+        assert_eq_(iter.next().unwrap(), 0);
+        // Internal iteration resumes inside the current inner iterator
+        assert_eq_(iter.find([](int x) { return x == 0; }).unwrap(), 0);
+        assert_eq_(iter.count(), size_t(2));
+        assert_eq_(Range(0).flat_map([](int x) { return Range(x); }).size_hint().upper.get(), size_t(0));
+    }
+    rtest_(flatten) {
+        std::vector<std::vector<std::string>> nested = {{"a", "b"}, {}, {"c"}};
+        auto flat = into_iter(std::move(nested)).flatten().collect<std::vector>();
+        assert_eq_(flat.size(), size_t(3));
+        assert_eq_(flat[2], std::string("c"));
+        auto ranges = Range(3).map([](int x) { return Range(x, 3); }).flatten();
+        assert_eq_(ranges.sum(), (0 + 1 + 2) + (1 + 2) + 2);
+    }
+    rtest_(take_skip_while) {
+        auto small = Range(10).take_while([](int x) { return x < 4; });
+        assert_eq_(small.size_hint().upper.get(), size_t(10));
+        assert_eq_(small.next().unwrap(), 0);
+        assert_eq_(small.sum(), 1 + 2 + 3);
+        small.next().unwrap_none();
+
+        auto iter = Range(10).take_while([](int x) { return x < 6; });
+        assert_eq_(iter.find([](int x) { return x == 2; }).unwrap(), 2);
+        assert_eq_(iter.next().unwrap(), 3);
+        assert_eq_(iter.count(), size_t(2));
+
+        auto large = Range(10).skip_while([](int x) { return x < 7; });
+        assert_eq_(large.next().unwrap(), 7);
+        assert_eq_(large.size_hint().lower, size_t(2));
+        assert_eq_(Range(10).skip_while([](int x) { return x % 3 != 2; }).sum(), 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9);
+    }
+    rtest_(inspect) {
+        int seen = 0;
+        auto sum = Range(5).inspect([&seen](const int &) { seen += 1; }).take(3).sum();
+        assert_eq_(sum, 3);
+        assert_eq_(seen, 3);
+        std::vector<int> order;
+        Range(3).inspect([&order](const int &x) { order.push_back(x); }).rev().for_each([](int) {});
+        assert_eq_(order[0], 2);
+    }
+    rtest_(dedup) {
+        std::vector<int> data = {1, 1, 2, 3, 3, 3, 1, 4, 4};
+        auto deduped = into_iter(clone(data)).dedup().collect<std::vector>();
+        std::vector<int> expected = {1, 2, 3, 1, 4};
+        assert_(deduped == expected);
+
+        auto iter = into_iter(clone(data)).dedup();
+        std::vector<int> ext;
+        for (int x : iter) {
+            ext.push_back(x);
+        }
+        assert_(ext == expected);
+
+        auto by = Range(10).dedup_by([](const int &a, const int &b) { return a / 3 == b / 3; });
+        assert_eq_(by.next().unwrap(), 0);
+        assert_eq_(by.find([](int x) { return x > 3; }).unwrap(), 6);
+        assert_eq_(by.next().unwrap(), 9);
+        by.next().unwrap_none();
+        assert_(iter::empty<int>().dedup().next().is_none());
+    }
+    rtest_(partition) {
+        auto parts = Range(10).partition<std::vector>([](int x) { return x % 3 == 0; });
+        assert_eq_(parts.get<0>().size(), size_t(4));
+        assert_eq_(parts.get<1>().size(), size_t(6));
+        assert_eq_(parts.get<1>()[0], 1);
+    }
+    rtest_(next_chunk) {
+        auto iter = Range(10).map([](int x) { return x * x; }).chain(Range(3));
+        int buf[8];
+        assert_eq_(iter.next_chunk(buf, 8), size_t(8));
+        assert_eq_(buf[7], 49);
+        assert_eq_(iter.next_chunk(buf, 8), size_t(5));
+        assert_eq_(buf[1], 81);
+        assert_eq_(buf[4], 2);
+        assert_eq_(iter.next_chunk(buf, 8), size_t(0));
+
+        auto take = Range(100).take(5);
+        assert_eq_(take.next_chunk(buf, 8), size_t(5));
+        take.next().unwrap_none();
+    }
+    rtest_(batch) {
+        auto batches = Range(10).map([](int x) { return x + 1; }).batch(4);
+        assert_eq_(batches.len(), size_t(3));
+        auto first = batches.next().unwrap();
+        assert_eq_(first.size(), size_t(4));
+        assert_eq_(first[0], 1);
+        const int *buffer = first.data();
+        batches.recycle(std::move(first));
+        auto second = batches.next().unwrap();
+        assert_eq_(second.data(), buffer);
+        assert_eq_(second[3], 8);
+        auto third = batches.next().unwrap();
+        assert_eq_(third.size(), size_t(2));
+        batches.next().unwrap_none();
+
+        auto strs = into_iter(std::vector<std::string>{"a", "b", "c"}).batch(2).collect<std::vector>();
+        assert_eq_(strs.size(), size_t(2));
+        assert_eq_(strs[1][0], std::string("c"));
+    }
+    rtest_(chunk_sinks) {
+        auto squares = Range(1000).take(600).collect<std::vector>();
+        assert_eq_(squares.size(), size_t(600));
+        assert_eq_(squares[599], 599);
+
+        auto chained = Range(300).chain(Range(200)).collect<std::vector>();
+        assert_eq_(chained.size(), size_t(500));
+        assert_eq_(chained[300], 0);
+
+        assert_eq_(Range(1000).chain(Range(10)).sum(), 999 * 500 + 45);
+        assert_eq_(Range(0.0, 4.0).chain(Range(0.0, 2.0)).sum(), 7.0);
+        assert_eq_(Range<int64_t>(0, 1000).boxed().sum(), int64_t(999 * 500));
+    }
 }
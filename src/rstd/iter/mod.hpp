@@ -3,3 +3,4 @@
 #include "iterator.hpp"
 #include "container.hpp"
 #include "range.hpp"
+#include "dyn_iter.hpp"
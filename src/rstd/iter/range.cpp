@@ -1,5 +1,9 @@
 #include <rtest.hpp>
 
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <vector>
 #include "range.hpp"
 
 using namespace rstd;
@@ -37,4 +41,147 @@ rtest_module_(iter_range) {
         assert_(iter_rev.next().is_none());
         assert_(iter_rev.rev().next().is_none());
     }
+    rtest_(range_nth) {
+        auto iter = Range<size_t>(10000000000);
+        assert_eq_(iter.nth(5000000000).unwrap(), size_t(5000000000));
+        assert_eq_(iter.advance_by(4999999998), size_t(4999999998));
+        assert_eq_(iter.count(), size_t(1));
+        iter.nth(0).unwrap_none();
+
+        auto rev = Range(10).rev();
+        assert_eq_(rev.nth(2).unwrap(), 7);
+        assert_eq_(rev.advance_by(10), size_t(7));
+    }
+    rtest_(range_size_hint) {
+        assert_eq_(Range(3, 8).size_hint().lower, size_t(5));
+        assert_eq_(Range(8, 3).size_hint().lower, size_t(0));
+        assert_eq_(Range<int8_t>(-100, 100).size_hint().lower, size_t(200));
+        // The difference doesn't fit into the signed type
+        assert_eq_(Range<int32_t>(INT32_MIN, INT32_MAX).size_hint().lower, size_t(UINT32_MAX));
+        assert_eq_(Range<int64_t>(INT64_MIN, INT64_MAX).size_hint().lower, size_t(UINT64_MAX));
+        auto half = Range<int64_t>(INT64_MIN, 0);
+        assert_eq_(half.size_hint().lower, size_t(1) << 63);
+        half.advance_by(size_t(1) << 62);
+        assert_eq_(half.next().unwrap(), INT64_MIN / 2);
+
+        // Fractional ranges include the partial step
+        assert_eq_(Range<double>(0, 2.5).size_hint().lower, size_t(3));
+        assert_eq_(Range<double>(0, 2.0).size_hint().lower, size_t(2));
+        assert_eq_(Range<float>(0.5f, 1.0f).size_hint().lower, size_t(1));
+        auto iter = Range<double>(0, 2.5);
+        size_t n = 0;
+        while (iter.next().is_some()) {
+            n += 1;
+        }
+        assert_eq_(n, size_t(3));
+    }
+    rtest_(range_full_width) {
+        // Offsets don't fit into `int`
+        auto iter = Range<int>(INT_MIN, INT_MAX);
+        assert_eq_(iter.advance_by(3000000000), size_t(3000000000));
+        assert_eq_(iter.next().unwrap(), 852516352);
+        auto rev = Range<int>(INT_MIN, INT_MAX).rev();
+        assert_eq_(rev.advance_by(3000000000), size_t(3000000000));
+        assert_eq_(rev.next().unwrap(), -852516354);
+        assert_eq_(rev.count(), size_t(UINT32_MAX) - 3000000001);
+
+        auto small = Range<int8_t>(-128, 127);
+        int8_t buf[200];
+        assert_eq_(small.next_chunk(buf, 200), size_t(200));
+        assert_eq_(buf[199], int8_t(71));
+        assert_eq_(small.next().unwrap(), int8_t(72));
+        auto small_rev = Range<int8_t>(-128, 127).rev();
+        assert_eq_(small_rev.next_chunk(buf, 200), size_t(200));
+        assert_eq_(buf[0], int8_t(126));
+        assert_eq_(buf[199], int8_t(-73));
+        assert_eq_(small_rev.next().unwrap(), int8_t(-74));
+    }
+    rtest_(range_last) {
+        assert_eq_(Range(3, 8).last().unwrap(), 7);
+        assert_eq_(Range(3, 8).rev().last().unwrap(), 3);
+        Range(3, 3).last().unwrap_none();
+    }
+    rtest_(range_fractional) {
+        assert_eq_(Range<double>(0, 2.5).count(), size_t(3));
+        assert_eq_(Range<double>(0, 2.5).last().unwrap(), 2.0);
+        assert_eq_(Range<double>(0, 2.5).rev().last().unwrap(), -0.5);
+        assert_eq_(Range<double>(0, 2.5).rev().min().unwrap(), -0.5);
+        assert_eq_(Range<double>(0, 2.5).max().unwrap(), 2.0);
+        assert_eq_(Range<double>(0.5, 3.0).last().unwrap(), 2.5);
+
+        auto iter = Range<double>(0, 2.5);
+        assert_eq_(iter.advance_by(2), size_t(2));
+        assert_eq_(iter.next().unwrap(), 2.0);
+        iter.next().unwrap_none();
+        auto all = Range<double>(0, 2.5);
+        assert_eq_(all.advance_by(10), size_t(3));
+        all.next().unwrap_none();
+        assert_eq_(Range<double>(0, 2.5).nth(2).unwrap(), 2.0);
+    }
+    rtest_(range_fractional_chunks) {
+        // Exact size hint fills the vector with a single chunk
+        auto v = Range<double>(0, 2.5).collect<std::vector>();
+        assert_eq_(v.size(), size_t(3));
+        assert_eq_(v[2], 2.0);
+        auto rev = Range<double>(0, 2.5).rev().collect<std::vector>();
+        assert_eq_(rev.size(), size_t(3));
+        assert_eq_(rev[2], -0.5);
+        assert_eq_(Range<double>(0, 2.5).sum(), 3.0);
+        assert_eq_(Range<float>(0.5f, 2.0f).sum(), 2.0f);
+
+        // Several chunks, and chunks of adapters
+        auto big = Range<double>(0, 1000.5).collect<std::vector>();
+        assert_eq_(big.size(), size_t(1001));
+        assert_eq_(big[1000], 1000.0);
+        assert_eq_(Range<double>(0, 1000.5).sum(), 500500.0);
+        auto chained = Range<double>(0, 2.5).chain(Range<double>(0, 1.5)).collect<std::vector>();
+        assert_eq_(chained.size(), size_t(5));
+        assert_eq_(chained[4], 1.0);
+        assert_eq_(Range<double>(0, 2.5).chain(Range<double>(0, 1.5)).sum(), 4.0);
+        assert_eq_(Range<double>(0, 2.5).take(5).sum(), 3.0);
+        double buf[8];
+        auto iter = Range<double>(0, 2.5);
+        assert_eq_(iter.next_chunk(buf, 8), size_t(3));
+        assert_eq_(buf[2], 2.0);
+    }
+    rtest_(range_sum) {
+        assert_eq_(Range(0).sum(), 0);
+        assert_eq_(Range(1, 101).sum(), 5050);
+        assert_eq_(Range(-10, 5).sum(), -45);
+        assert_eq_(Range(1, 101).rev().sum(), 5050);
+        assert_eq_(Range<int64_t>(1000000000).sum(), int64_t(499999999500000000));
+        // Wraps around like the loop
+        uint32_t wrapped = 0;
+        for (uint32_t i = 1000; i < 200000; ++i) {
+            wrapped += i;
+        }
+        assert_eq_(Range<uint32_t>(1000, 200000).sum(), wrapped);
+        auto iter = Range(10);
+        iter.next().unwrap();
+        assert_eq_(iter.sum(), 45);
+        iter.next().unwrap_none();
+    }
+    rtest_(range_min_max) {
+        assert_eq_(Range(-3, 8).min().unwrap(), -3);
+        assert_eq_(Range(-3, 8).max().unwrap(), 7);
+        assert_eq_(Range(-3, 8).rev().max().unwrap(), 7);
+        assert_(Range(3, 3).min().is_none());
+        assert_(Range(3, 3).max().is_none());
+    }
+    rtest_(range_next_chunk) {
+        auto iter = Range(3, 10);
+        int buf[4];
+        assert_eq_(iter.next_chunk(buf, 4), size_t(4));
+        assert_eq_(buf[0], 3);
+        assert_eq_(buf[3], 6);
+        assert_eq_(iter.next_chunk(buf, 4), size_t(3));
+        assert_eq_(buf[2], 9);
+        assert_eq_(iter.next_chunk(buf, 4), size_t(0));
+
+        auto rev = Range<uint8_t>(0, 5).rev();
+        uint8_t rb[8];
+        assert_eq_(rev.next_chunk(rb, 8), size_t(5));
+        assert_eq_(rb[0], uint8_t(4));
+        assert_eq_(rb[4], uint8_t(0));
+    }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include "iterator.hpp"
 
 
@@ -11,6 +14,25 @@ private:
     T start_ = 0, end_ = 0;
     bool rev_ = false;
 
+    // `x + k` and `x - k` for `k` up to the length. Integers are shifted as unsigned,
+    // because `k` may not fit into a signed `T` for the full range of the type.
+    static T shifted_up(T x, size_t k) {
+        if constexpr (std::is_integral_v<T>) {
+            typedef std::make_unsigned_t<T> U;
+            return T(U(U(x) + U(k)));
+        } else {
+            return T(x + T(k));
+        }
+    }
+    static T shifted_down(T x, size_t k) {
+        if constexpr (std::is_integral_v<T>) {
+            typedef std::make_unsigned_t<T> U;
+            return T(U(U(x) - U(k)));
+        } else {
+            return T(x - T(k));
+        }
+    }
+
 public:
     explicit Range(T e) : Range(0, e) {}
     Range(T s, T e) : start_(s), end_(e) {}
@@ -45,6 +67,135 @@ public:
             return Option<T>::None();
         }
     }
+    // Works on local copies of the bounds so that the loop can be vectorized
+    template <typename F>
+    bool try_for_each(F &&f) {
+        T s = start_, e = end_;
+        bool done = true;
+        if (!rev_) {
+            while (s < e) {
+                T i = s;
+                ++s;
+                if (!f(std::move(i))) {
+                    done = false;
+                    break;
+                }
+            }
+        } else {
+            while (s < e) {
+                --e;
+                T i = e;
+                if (!f(std::move(i))) {
+                    done = false;
+                    break;
+                }
+            }
+        }
+        start_ = s;
+        end_ = e;
+        return done;
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = std::min(n, this->len());
+        if (!rev_) {
+            for (size_t i = 0; i < k; ++i) {
+                buf[i] = shifted_up(start_, i);
+            }
+            start_ = shifted_up(start_, k);
+        } else {
+            for (size_t i = 0; i < k; ++i) {
+                buf[i] = shifted_down(end_, i + 1);
+            }
+            end_ = shifted_down(end_, k);
+        }
+        return k;
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, this->len());
+        if (!rev_) {
+            start_ = shifted_up(start_, k);
+        } else {
+            end_ = shifted_down(end_, k);
+        }
+        return k;
+    }
+    Option<T> last() {
+        if (start_ < end_) {
+            T i;
+            if constexpr (std::is_integral_v<T>) {
+                i = !rev_ ? T(end_ - 1) : start_;
+            } else {
+                // The last step may not reach the opposite bound
+                size_t n = this->len();
+                i = !rev_ ? T(start_ + T(n - 1)) : T(end_ - T(n));
+            }
+            start_ = end_;
+            return Option<T>::Some(i);
+        } else {
+            return Option<T>::None();
+        }
+    }
+    size_t count() {
+        size_t n = this->len();
+        start_ = end_;
+        return n;
+    }
+    // Closed form of the arithmetic series, wraps around on overflow like the loop would
+    T sum() {
+        if constexpr (std::is_integral_v<T> && sizeof(T) >= sizeof(int)) {
+            typedef std::make_unsigned_t<T> U;
+            size_t n = this->len();
+            if (n == 0) {
+                return T(0);
+            }
+            // n * (n - 1) / 2 without overflowing the product
+            U tri = n % 2 == 0 ? U(n / 2) * U(n - 1) : U(n) * U((n - 1) / 2);
+            U s = U(n) * U(start_) + tri;
+            start_ = end_;
+            return T(s);
+        } else {
+            return Iterator<T, Range>::sum();
+        }
+    }
+    Option<T> min() {
+        if (start_ < end_) {
+            T m = std::is_integral_v<T> || !rev_ ? start_ : T(end_ - T(this->len()));
+            start_ = end_;
+            return Option<T>::Some(m);
+        } else {
+            return Option<T>::None();
+        }
+    }
+    Option<T> max() {
+        if constexpr (std::is_integral_v<T>) {
+            if (start_ < end_) {
+                T m = T(end_ - 1);
+                start_ = end_;
+                return Option<T>::Some(m);
+            } else {
+                return Option<T>::None();
+            }
+        } else {
+            return Iterator<T, Range>::max();
+        }
+    }
+    // Items are `start_ + i` (or `end_ - 1 - i` when reversed) while they are in the range.
+    // Integers are subtracted as unsigned so that the full range of a signed type doesn't overflow,
+    // fractional ranges yield the partial step as well.
+    iter::SizeHint size_hint() const {
+        if (start_ < end_) {
+            if constexpr (std::is_integral_v<T>) {
+                typedef std::make_unsigned_t<T> U;
+                return iter::SizeHint::exact(size_t(U(U(end_) - U(start_))));
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return iter::SizeHint::exact(size_t(std::ceil(end_ - start_)));
+            } else {
+                return iter::SizeHint::exact(size_t(end_ - start_));
+            }
+        } else {
+            return iter::SizeHint::exact(0);
+        }
+    }
     typedef Range Rev;
     Range rev() {
         Range r = clone(*this);
@@ -0,0 +1,57 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "latch.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(latch) {
+    rtest_(count_down) {
+        Latch latch(3);
+        assert_(!latch.try_wait());
+        latch.count_down();
+        latch.count_down(2);
+        assert_(latch.try_wait());
+        latch.wait();
+    }
+    rtest_should_panic_(count_down_below_zero) {
+        Latch latch(1);
+        latch.count_down(2);
+    }
+    rtest_(wait_for_workers) {
+        const int threads = 8;
+        Latch done(threads);
+        std::atomic<int> finished(0);
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&]() {
+                finished += 1;
+                done.count_down();
+            }));
+        }
+        done.wait();
+        assert_eq_(finished.load(), threads);
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+    }
+    rtest_(arrive_and_wait) {
+        const int threads = 4;
+        Latch start(threads);
+        std::atomic<int> arrived(0);
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&]() {
+                arrived += 1;
+                start.arrive_and_wait();
+                assert_eq_(arrived.load(), threads);
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <rcore/futex.hpp>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+// Single-use countdown. Threads waiting for the latch are released when the counter reaches zero.
+class Latch final {
+private:
+    std::atomic<uint32_t> counter;
+
+public:
+    explicit Latch(uint32_t n) : counter(n) {}
+    ~Latch() = default;
+
+    Latch(const Latch &) = delete;
+    Latch &operator=(const Latch &) = delete;
+
+    void count_down(uint32_t n = 1) {
+        uint32_t prev = counter.fetch_sub(n, std::memory_order_release);
+        assert_(prev >= n);
+        if (prev == n) {
+            rcore::futex::wake_all(&counter);
+        }
+    }
+    bool try_wait() const {
+        return counter.load(std::memory_order_acquire) == 0;
+    }
+    void wait() const {
+        if (rcore::futex::spin([&]() { return try_wait(); })) {
+            return;
+        }
+        for (;;) {
+            uint32_t c = counter.load(std::memory_order_acquire);
+            if (c == 0) {
+                break;
+            }
+            rcore::futex::wait(&counter, c);
+        }
+    }
+    void arrive_and_wait(uint32_t n = 1) {
+        count_down(n);
+        wait();
+    }
+};
+
+} // namespace rstd
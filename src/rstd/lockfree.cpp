@@ -0,0 +1,94 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "lockfree.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(lockfree) {
+    const int THREADS = 4, COUNT = 10000;
+
+    // Pushes `COUNT` distinct values from each of `THREADS` producers
+    // and pops them concurrently by the same amount of consumers.
+    template <typename C>
+    void stress(C &container) {
+        std::vector<std::atomic<int>> seen(THREADS*COUNT);
+        for (auto &s : seen) {
+            s = 0;
+        }
+        std::atomic<int> popped(0);
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.push_back(thread::spawn([&container, t]() {
+                for (int i = 0; i < COUNT; ++i) {
+                    container.push(t*COUNT + i);
+                }
+            }));
+            workers.push_back(thread::spawn([&]() {
+                while (popped.load() < THREADS*COUNT) {
+                    container.pop().match(
+                        [&](int x) {
+                            seen[x] += 1;
+                            popped += 1;
+                        },
+                        []() {}
+                    );
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        for (auto &s : seen) {
+            assert_eq_(s.load(), 1);
+        }
+        assert_(container.is_empty());
+    }
+
+    rtest_(stack) {
+        TreiberStack<int> stack;
+        assert_(stack.is_empty());
+        for (int i = 0; i < 10; ++i) {
+            stack.push(i);
+        }
+        for (int i = 9; i >= 0; --i) {
+            assert_eq_(stack.pop().unwrap(), i);
+        }
+        assert_(stack.pop().is_none());
+    }
+    rtest_(stack_non_empty_drop) {
+        TreiberStack<std::unique_ptr<int>> stack;
+        stack.push(std::make_unique<int>(1));
+        stack.push(std::make_unique<int>(2));
+        assert_eq_(*stack.pop().unwrap(), 2);
+    }
+    rtest_(stack_stress) {
+        TreiberStack<int> stack;
+        stress(stack);
+    }
+    rtest_(queue) {
+        MsQueue<int> queue;
+        assert_(queue.is_empty());
+        for (int i = 0; i < 10; ++i) {
+            queue.push(i);
+        }
+        for (int i = 0; i < 10; ++i) {
+            assert_eq_(queue.pop().unwrap(), i);
+        }
+        assert_(queue.pop().is_none());
+        assert_(queue.is_empty());
+    }
+    rtest_(queue_non_empty_drop) {
+        MsQueue<std::unique_ptr<int>> queue;
+        queue.push(std::make_unique<int>(1));
+        queue.push(std::make_unique<int>(2));
+        assert_eq_(*queue.pop().unwrap(), 1);
+    }
+    rtest_(queue_stress) {
+        MsQueue<int> queue;
+        stress(queue);
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include "prelude.hpp"
+#include "epoch.hpp"
+
+
+namespace rstd {
+
+// Lock-free LIFO stack (Treiber stack).
+// Popped nodes are released using epoch-based reclamation.
+template <typename T>
+class TreiberStack final {
+private:
+    struct Node {
+        T value;
+        Node *next;
+    };
+    std::atomic<Node *> head{nullptr};
+
+public:
+    TreiberStack() = default;
+    ~TreiberStack() {
+        Node *node = head.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    TreiberStack(const TreiberStack &) = delete;
+    TreiberStack &operator=(const TreiberStack &) = delete;
+
+    void push(T &&value) {
+        Node *node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(
+            node->next, node,
+            std::memory_order_release, std::memory_order_relaxed
+        )) {}
+    }
+    void push(const T &value) {
+        push(clone(value));
+    }
+
+    Option<T> pop() {
+        epoch::Guard guard = epoch::pin();
+        Node *node = head.load(std::memory_order_acquire);
+        for (;;) {
+            if (node == nullptr) {
+                return Option<T>::None();
+            }
+            // `node` cannot be freed while we're pinned, so reading `next` is safe
+            if (head.compare_exchange_weak(
+                node, node->next,
+                std::memory_order_acquire, std::memory_order_acquire
+            )) {
+                Option<T> ret = Option<T>::Some(std::move(node->value));
+                guard.defer_destroy(node);
+                return ret;
+            }
+        }
+    }
+
+    bool is_empty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+// Lock-free FIFO queue (Michael-Scott queue).
+// Dequeued nodes are released using epoch-based reclamation.
+template <typename T>
+class MsQueue final {
+private:
+    struct Node {
+        Option<T> value;
+        std::atomic<Node *> next{nullptr};
+
+        Node() = default;
+        explicit Node(T &&v) : value(Option<T>::Some(std::move(v))) {}
+    };
+    // `head` always points to sentinel node which value is already taken
+    alignas(cache_line_size) std::atomic<Node *> head;
+    alignas(cache_line_size) std::atomic<Node *> tail;
+
+public:
+    MsQueue() {
+        Node *sentinel = new Node();
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+    ~MsQueue() {
+        Node *node = head.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            Node *next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    MsQueue(const MsQueue &) = delete;
+    MsQueue &operator=(const MsQueue &) = delete;
+
+    void push(T &&value) {
+        Node *node = new Node(std::move(value));
+        epoch::Guard guard = epoch::pin();
+        for (;;) {
+            Node *t = tail.load(std::memory_order_acquire);
+            Node *next = t->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                if (t->next.compare_exchange_weak(
+                    next, node,
+                    std::memory_order_release, std::memory_order_relaxed
+                )) {
+                    tail.compare_exchange_strong(t, node, std::memory_order_release, std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                // Help to move lagging tail
+                tail.compare_exchange_weak(t, next, std::memory_order_release, std::memory_order_relaxed);
+            }
+        }
+    }
+    void push(const T &value) {
+        push(clone(value));
+    }
+
+    Option<T> pop() {
+        epoch::Guard guard = epoch::pin();
+        for (;;) {
+            Node *h = head.load(std::memory_order_acquire);
+            Node *next = h->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return Option<T>::None();
+            }
+            Node *t = tail.load(std::memory_order_acquire);
+            if (h == t) {
+                // Tail must not point to the node being released
+                tail.compare_exchange_weak(t, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_weak(
+                h, next,
+                std::memory_order_acquire, std::memory_order_relaxed
+            )) {
+                // `next` is the new sentinel, only we can access its value
+                Option<T> ret = next->value.take();
+                guard.defer_destroy(h);
+                return ret;
+            }
+        }
+    }
+
+    bool is_empty() const {
+        epoch::Guard guard = epoch::pin();
+        return head.load(std::memory_order_acquire)->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+} // namespace rstd
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <thread>
+#include <sstream>
 #include "thread.hpp"
 #include "mutex.hpp"
 
@@ -93,4 +94,62 @@ rtest_module_(mutex) {
         }
         assert_eq_(y.into_inner(), 567);
     }
+    rtest_(stats) {
+        Mutex<int> x(0);
+        x.set_name("mutex::stats");
+        mutex_stats::reset();
+        auto t = thread::spawn([&x]() {
+            for (int i = 0; i < 100; ++i) {
+                *x.lock() += 1;
+            }
+        });
+        {
+            auto guard = x.lock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            *guard += 1;
+        }
+        t.join().unwrap();
+
+        Option<mutex_stats::Snapshot> found;
+        for (auto &s : mutex_stats::snapshot()) {
+            if (s.name == "mutex::stats") {
+                found = Option<mutex_stats::Snapshot>::Some(s);
+            }
+        }
+        if (mutex_stats::enabled) {
+            auto s = found.unwrap();
+            assert_eq_(s.acquisitions, uint64_t(101));
+            assert_(s.hold_max_ns >= uint64_t(10000000));
+            assert_(s.wait_max_ns <= s.wait_total_ns);
+
+            std::stringstream json;
+            mutex_stats::dump_json(json);
+            assert_(json.str().find("\"name\":\"mutex::stats\"") != std::string::npos);
+        } else {
+            assert_(found.is_none());
+        }
+    }
+    rtest_(try_lock_for) {
+        Mutex<int> x(0);
+        auto guard = x.lock();
+        auto t = thread::spawn([&x]() {
+            auto start = time::Instant::now();
+            auto res = x.try_lock_for(time::Duration::from_millis(10));
+            assert_(res.is_err());
+            res.clear();
+            assert_(start.elapsed() >= time::Duration::from_millis(10));
+
+            *x.try_lock_for(time::Duration::from_secs(10)).unwrap() += 1;
+        });
+        auto u = thread::spawn([&x]() {
+            // Deadline saturates instead of overflowing
+            *x.try_lock_for(time::Duration::max()).unwrap() += 1;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        *guard += 1;
+        drop(guard);
+        t.join().unwrap();
+        u.join().unwrap();
+        assert_eq_(x.into_inner(), 3);
+    }
 }
@@ -1,17 +1,26 @@
 #pragma once
 
 #include <pthread.h>
+#include <rcore/lock_stats.hpp>
 #include "prelude.hpp"
+#include "time.hpp"
 
 
 namespace rstd {
 
+// When `RSTD_MUTEX_STATS` is defined each mutex records its contention statistics,
+// see `mutex_stats` below. Otherwise no overhead is added.
 class _Mutex final {
 private:
     Option<pthread_mutex_t> raw;
 #ifdef DEBUG
     bool locked = false;
 #endif // DEBUG
+#ifdef RSTD_MUTEX_STATS
+    std::shared_ptr<rcore::lock_stats::Stats> stats = rcore::lock_stats::register_();
+    // Written only by the thread that holds the mutex
+    uint64_t acquired_at = 0;
+#endif // RSTD_MUTEX_STATS
 
 public:
     _Mutex() {
@@ -36,7 +45,18 @@ public:
     _Mutex &operator=(_Mutex &&) = default;
 
     void lock() {
+#ifdef RSTD_MUTEX_STATS
+        if (pthread_mutex_trylock(&raw.get()) == 0) {
+            stats->record_acquire(false, 0);
+        } else {
+            uint64_t start = rcore::lock_stats::now_ns();
+            assert_(pthread_mutex_lock(&raw.get()) == 0);
+            stats->record_acquire(true, rcore::lock_stats::now_ns() - start);
+        }
+        acquired_at = rcore::lock_stats::now_ns();
+#else // RSTD_MUTEX_STATS
         assert_(pthread_mutex_lock(&raw.get()) == 0);
+#endif // RSTD_MUTEX_STATS
 #ifdef DEBUG
         assert_(!locked);
         locked = true;
@@ -49,6 +69,10 @@ public:
             assert_(!locked);
             locked = true;
 #endif // DEBUG
+#ifdef RSTD_MUTEX_STATS
+            stats->record_acquire(false, 0);
+            acquired_at = rcore::lock_stats::now_ns();
+#endif // RSTD_MUTEX_STATS
             return true;
         } else if (r == EBUSY) {
 #ifdef DEBUG
@@ -61,13 +85,69 @@ public:
             return false;
         }
     }
+    // Tries to lock the mutex until `deadline`. Returns `false` if the time has expired.
+    // Waits on `CLOCK_MONOTONIC` with glibc 2.30+, otherwise on `CLOCK_REALTIME`.
+    bool try_lock_until(const time::Instant &deadline) {
+        int r = pthread_mutex_trylock(&raw.get());
+        if (r == EBUSY) {
+#ifdef RSTD_MUTEX_STATS
+            uint64_t start = rcore::lock_stats::now_ns();
+#endif // RSTD_MUTEX_STATS
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+            timespec ts = deadline.__as_monotonic();
+            r = pthread_mutex_clocklock(&raw.get(), CLOCK_MONOTONIC, &ts);
+#else
+            // No monotonic timed lock, so changes of the wall clock shift the deadline
+            timespec ts = deadline.__as_realtime();
+            r = pthread_mutex_timedlock(&raw.get(), &ts);
+#endif
+#ifdef RSTD_MUTEX_STATS
+            if (r == 0) {
+                stats->record_acquire(true, rcore::lock_stats::now_ns() - start);
+            }
+        } else if (r == 0) {
+            stats->record_acquire(false, 0);
+#endif // RSTD_MUTEX_STATS
+        }
+        if (r == 0) {
+#ifdef DEBUG
+            assert_(!locked);
+            locked = true;
+#endif // DEBUG
+#ifdef RSTD_MUTEX_STATS
+            acquired_at = rcore::lock_stats::now_ns();
+#endif // RSTD_MUTEX_STATS
+            return true;
+        } else if (r == ETIMEDOUT) {
+            return false;
+        } else {
+            panic_("Mutex timedlock error");
+            // Unreachable
+            return false;
+        }
+    }
+    bool try_lock_for(const time::Duration &timeout) {
+        return try_lock_until(time::Instant::now().saturating_add(timeout));
+    }
     void unlock() {
 #ifdef DEBUG
         assert_(locked);
         locked = false;
 #endif // DEBUG
+#ifdef RSTD_MUTEX_STATS
+        stats->record_release(rcore::lock_stats::now_ns() - acquired_at);
+#endif // RSTD_MUTEX_STATS
         assert_(pthread_mutex_unlock(&raw.get()) == 0);
     }
+
+    // Name shown in the contention statistics
+    void set_name(const std::string &name) {
+#ifdef RSTD_MUTEX_STATS
+        stats->set_name(name);
+#else // RSTD_MUTEX_STATS
+        (void)name;
+#endif // RSTD_MUTEX_STATS
+    }
 };
 
 
@@ -159,6 +239,21 @@ public:
             return Result<Guard>::Err(Tuple<>());
         }
     }
+    Result<Guard, time::TimedOut> try_lock_until(const time::Instant &deadline) const {
+        if (mutex.try_lock_until(deadline)) {
+            return Result<Guard, time::TimedOut>::Ok(Guard(*this));
+        } else {
+            return Result<Guard, time::TimedOut>::Err(time::TimedOut());
+        }
+    }
+    Result<Guard, time::TimedOut> try_lock_for(const time::Duration &timeout) const {
+        return try_lock_until(time::Instant::now().saturating_add(timeout));
+    }
+
+    // Name shown in the contention statistics
+    void set_name(const std::string &name) {
+        mutex.set_name(name);
+    }
 
     T into_inner() {
         this->check_free();
@@ -171,4 +266,32 @@ public:
     }
 };
 
+// Contention statistics of all alive mutexes.
+// Collected only when `RSTD_MUTEX_STATS` is defined, otherwise they are empty.
+namespace mutex_stats {
+
+typedef rcore::lock_stats::Snapshot Snapshot;
+
+#ifdef RSTD_MUTEX_STATS
+inline constexpr bool enabled = true;
+#else // RSTD_MUTEX_STATS
+inline constexpr bool enabled = false;
+#endif // RSTD_MUTEX_STATS
+
+// Sorted by total wait time, so the most contended mutexes come first
+inline std::vector<Snapshot> snapshot() {
+    return rcore::lock_stats::snapshot();
+}
+inline void reset() {
+    rcore::lock_stats::reset();
+}
+inline void dump(std::ostream &o) {
+    rcore::lock_stats::dump(o);
+}
+inline void dump_json(std::ostream &o) {
+    rcore::lock_stats::dump_json(o);
+}
+
+} // namespace mutex_stats
+
 } // namespace rstd
@@ -280,4 +280,7 @@ public:
     }
 };
 
+template <typename T>
+struct TriviallyRelocatable<Option<T>> : TriviallyRelocatable<T> {};
+
 } // namespace rstd2
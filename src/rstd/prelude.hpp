@@ -16,12 +16,28 @@
 #include "hash.hpp"
 #include "iter/mod.hpp"
 #include "string.hpp"
+#include "slice.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include "small_vec.hpp"
+#include "hash_map.hpp"
 
 #include "box.hpp"
 #include "rc.hpp"
+#include "arc.hpp"
 
+#include "time.hpp"
 #include "thread.hpp"
 #include "mutex.hpp"
+#include "rwlock.hpp"
+#include "concurrent_hash_map.hpp"
+#include "arc_swap.hpp"
+#include "epoch.hpp"
+#include "lockfree.hpp"
+#include "barrier.hpp"
+#include "latch.hpp"
+#include "semaphore.hpp"
+#include "cancellation.hpp"
 
 // Shorter namespace alias
 namespace rs = rstd;
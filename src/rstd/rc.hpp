@@ -55,4 +55,7 @@ public:
     }
 };
 
+template <typename T>
+struct TriviallyRelocatable<Rc<T>> : std::true_type {};
+
 } // namespace rstd
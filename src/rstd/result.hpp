@@ -383,6 +383,10 @@ public:
     }
 };
 
+template <typename T, typename E>
+struct TriviallyRelocatable<Result<T, E>> :
+    std::bool_constant<is_trivially_relocatable_v<T> && is_trivially_relocatable_v<E>> {};
+
 } // namespace rstd
 
 #define try_assign_(ok, res) do { \
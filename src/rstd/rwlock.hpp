@@ -0,0 +1,62 @@
+#pragma once
+
+#include <pthread.h>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+// POSIX-thread readers-writer lock.
+// Unlike `_Mutex` it cannot be moved because it is intended to be placed
+// in-line into other synchronization structures.
+class _RwLock final {
+private:
+    pthread_rwlock_t raw;
+
+public:
+    _RwLock() {
+        assert_(pthread_rwlock_init(&raw, nullptr) == 0);
+    }
+    ~_RwLock() {
+        assert_(pthread_rwlock_destroy(&raw) == 0);
+    }
+
+    _RwLock(const _RwLock &) = delete;
+    _RwLock &operator=(const _RwLock &) = delete;
+
+    void read() {
+        assert_(pthread_rwlock_rdlock(&raw) == 0);
+    }
+    bool try_read() {
+        int r = pthread_rwlock_tryrdlock(&raw);
+        if (r == 0) {
+            return true;
+        } else if (r == EBUSY) {
+            return false;
+        } else {
+            panic_("RwLock try_read error");
+            // Unreachable
+            return false;
+        }
+    }
+    void write() {
+        assert_(pthread_rwlock_wrlock(&raw) == 0);
+    }
+    bool try_write() {
+        int r = pthread_rwlock_trywrlock(&raw);
+        if (r == 0) {
+            return true;
+        } else if (r == EBUSY) {
+            return false;
+        } else {
+            panic_("RwLock try_write error");
+            // Unreachable
+            return false;
+        }
+    }
+    void unlock() {
+        assert_(pthread_rwlock_unlock(&raw) == 0);
+    }
+};
+
+} // namespace rstd
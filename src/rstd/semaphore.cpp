@@ -0,0 +1,56 @@
+#include <rtest.hpp>
+
+#include <atomic>
+#include <vector>
+#include "thread.hpp"
+#include "semaphore.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(semaphore) {
+    rtest_(acquire_release) {
+        Semaphore sem(2);
+        assert_(sem.try_acquire());
+        sem.acquire();
+        assert_eq_(sem.available(), uint32_t(0));
+        assert_(!sem.try_acquire());
+        sem.release(2);
+        assert_eq_(sem.available(), uint32_t(2));
+    }
+    rtest_(guard) {
+        Semaphore sem(1);
+        {
+            auto guard = sem.access();
+            auto res = sem.try_access();
+            assert_(res.is_err());
+            res.clear();
+        }
+        auto guard = sem.try_access().unwrap();
+        assert_eq_(sem.available(), uint32_t(0));
+        drop(guard);
+        assert_eq_(sem.available(), uint32_t(1));
+    }
+    rtest_(limit_concurrency) {
+        const int threads = 8, permits = 3, count = 1000;
+        Semaphore sem(permits);
+        std::atomic<int> inside(0), max_inside(0);
+        std::vector<JoinHandle<>> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.push_back(thread::spawn([&]() {
+                for (int i = 0; i < count; ++i) {
+                    auto guard = sem.access();
+                    int n = inside.fetch_add(1) + 1;
+                    int m = max_inside.load();
+                    while (n > m && !max_inside.compare_exchange_weak(m, n)) {}
+                    inside -= 1;
+                }
+            }));
+        }
+        for (auto &w : workers) {
+            w.join().unwrap();
+        }
+        assert_(max_inside.load() <= permits);
+        assert_eq_(sem.available(), uint32_t(permits));
+    }
+}
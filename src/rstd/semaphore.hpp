@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <rcore/futex.hpp>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+// Counting semaphore.
+class Semaphore final {
+public:
+    class Guard final {
+    private:
+        Option<Semaphore *> origin;
+
+        void release() {
+            if (origin.is_some()) {
+                origin.take().unwrap()->release();
+            }
+        }
+
+    public:
+        Guard() = default;
+        explicit Guard(Semaphore &s) : origin(Option<Semaphore *>::Some(&s)) {}
+
+        Guard(Guard &&) = default;
+        Guard &operator=(Guard &&other) {
+            this->release();
+            origin = std::move(other.origin);
+            return *this;
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard() {
+            this->release();
+        }
+    };
+
+private:
+    std::atomic<uint32_t> permits;
+    std::atomic<uint32_t> waiters{0};
+
+public:
+    explicit Semaphore(uint32_t n) : permits(n) {}
+    ~Semaphore() = default;
+
+    Semaphore(const Semaphore &) = delete;
+    Semaphore &operator=(const Semaphore &) = delete;
+
+    bool try_acquire() {
+        uint32_t p = permits.load(std::memory_order_relaxed);
+        while (p > 0) {
+            if (permits.compare_exchange_weak(
+                p, p - 1,
+                std::memory_order_acquire, std::memory_order_relaxed
+            )) {
+                return true;
+            }
+        }
+        return false;
+    }
+    void acquire() {
+        if (rcore::futex::spin([&]() { return try_acquire(); })) {
+            return;
+        }
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        while (!try_acquire()) {
+            rcore::futex::wait(&permits, 0);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    void release(uint32_t n = 1) {
+        permits.fetch_add(n, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) > 0) {
+            if (n == 1) {
+                rcore::futex::wake_one(&permits);
+            } else {
+                rcore::futex::wake_all(&permits);
+            }
+        }
+    }
+
+    Guard access() {
+        acquire();
+        return Guard(*this);
+    }
+    Result<Guard> try_access() {
+        if (try_acquire()) {
+            return Result<Guard>::Ok(Guard(*this));
+        } else {
+            return Result<Guard>::Err(Tuple<>());
+        }
+    }
+
+    // Amount of currently available permits. May be outdated in case of concurrent access.
+    uint32_t available() const {
+        return permits.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace rstd
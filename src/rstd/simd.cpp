@@ -0,0 +1,137 @@
+#include <rtest.hpp>
+
+#include <vector>
+#include <cmath>
+#include "simd.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(simd) {
+    rtest_(arithmetic) {
+        auto a = i32x4::from_array({1, 2, 3, 4});
+        auto b = i32x4::splat(10);
+        assert_((a + b).equals(i32x4::from_array({11, 12, 13, 14})));
+        assert_((b - a).equals(i32x4::from_array({9, 8, 7, 6})));
+        assert_((a * a).equals(i32x4::from_array({1, 4, 9, 16})));
+        assert_((b / a).equals(i32x4::from_array({10, 5, 3, 2})));
+        assert_((-a).equals(i32x4::from_array({-1, -2, -3, -4})));
+        assert_((a << 2).equals(i32x4::from_array({4, 8, 12, 16})));
+        assert_(((a ^ a) | (a & b)).equals(i32x4::from_array({0, 2, 2, 0})));
+        a += b;
+        assert_eq_(a[3], 14);
+
+        auto f = f32x8::splat(1.5f) * f32x8::splat(2.0f);
+        assert_eq_(f.reduce_sum(), 24.0f);
+
+        // Wraps around like scalar arithmetic
+        auto u = u8x16::splat(200) + u8x16::splat(100);
+        assert_eq_(u[0], uint8_t(44));
+    }
+    rtest_(compare_select) {
+        auto a = i32x4::from_array({1, 5, 3, 7});
+        auto b = i32x4::splat(4);
+        auto m = a > b;
+        assert_eq_(m.to_bitmask(), uint64_t(0b1010));
+        assert_eq_(m.count(), size_t(2));
+        assert_(m.any() && !m.all());
+        assert_((!m).test(0));
+        assert_((m | !m).all());
+        assert_(!(m & !m).any());
+        assert_(m.select(a, b).equals(i32x4::from_array({4, 5, 4, 7})));
+        assert_(a.min(b).equals(i32x4::from_array({1, 4, 3, 4})));
+        assert_(a.max(b).equals(i32x4::from_array({4, 5, 4, 7})));
+        assert_(a.clamp(i32x4::splat(2), i32x4::splat(6)).equals(i32x4::from_array({2, 5, 3, 6})));
+        assert_(i32x4::from_array({-3, 3, 0, -1}).abs().equals(i32x4::from_array({3, 3, 0, 1})));
+        assert_((f64x2::from_array({0.5, 2.0}) < f64x2::splat(1.0)).to_bitmask() == 0b01);
+        assert_eq_((Mask<float, 4>::splat(true).count()), size_t(4));
+
+        // Byte lanes are converted with a single movemask where available
+        i8x16 bytes = i8x16::splat(0);
+        bytes.set(0, -1);
+        bytes.set(9, 7);
+        bytes.set(15, -128);
+        assert_eq_((bytes < i8x16::splat(0)).to_bitmask(), uint64_t(0x8001));
+        assert_eq_((bytes == i8x16::splat(7)).to_bitmask(), uint64_t(1 << 9));
+    }
+    rtest_(reduce) {
+        auto a = i64x4::from_array({3, -8, 5, 2});
+        assert_eq_(a.reduce_sum(), int64_t(2));
+        assert_eq_(a.reduce_product(), int64_t(-240));
+        assert_eq_(a.reduce_min(), int64_t(-8));
+        assert_eq_(a.reduce_max(), int64_t(5));
+    }
+    rtest_(shuffle) {
+        auto a = i32x4::from_array({0, 1, 2, 3});
+        auto shuffled = a.shuffle<3, 3, 0, 1>();
+        assert_(shuffled.equals(i32x4::from_array({3, 3, 0, 1})));
+        assert_(a.reverse().equals(i32x4::from_array({3, 2, 1, 0})));
+        assert_(a.rotate_lanes_left<1>().equals(i32x4::from_array({1, 2, 3, 0})));
+        auto f = a.cast<float>() * f32x4::splat(0.5f);
+        assert_eq_(f[3], 1.5f);
+        assert_eq_(f.cast<int32_t>()[3], 1);
+    }
+    rtest_(load_store) {
+        std::vector<float> data = {1, 2, 3, 4, 5, 6};
+        auto a = f32x4::from_slice(Slice<float>(data).slice(2, 6));
+        assert_eq_(a[0], 3.0f);
+        (a * f32x4::splat(2.0f)).store(SliceMut<float>(data).slice(0, 4));
+        assert_eq_(data[0], 6.0f);
+        assert_eq_(data[3], 12.0f);
+        assert_eq_(data[4], 5.0f);
+        auto p = f32x4::load_or(data.data() + 4, 2, -1.0f);
+        assert_eq_(p[1], 6.0f);
+        assert_eq_(p[2], -1.0f);
+        assert_eq_(a.to_array()[3], 6.0f);
+    }
+    rtest_should_panic_(load_short_slice) {
+        std::vector<int32_t> data = {1, 2, 3};
+        i32x4::from_slice(Slice<int32_t>(data));
+    }
+    rtest_(simd_chunks) {
+        std::vector<int32_t> data;
+        for (int32_t i = 0; i < 35; ++i) {
+            data.push_back(i);
+        }
+        auto chunks = Slice<int32_t>(data).simd_chunks<8>();
+        assert_eq_(chunks.len(), size_t(4));
+        assert_eq_(chunks.remainder().len(), size_t(3));
+        int32_t tail = chunks.remainder().iter().cloned().sum();
+        auto acc = chunks.fold(i32x8(), [](i32x8 a, i32x8 x) { return a + x; });
+        assert_eq_(acc.reduce_sum() + tail, 35 * 34 / 2);
+
+        auto first = Slice<int32_t>(data).simd_chunks<4>().nth(2).unwrap();
+        assert_eq_(first[0], 8);
+    }
+    rtest_(dot_product) {
+        std::vector<float> a, b;
+        for (int i = 0; i < 103; ++i) {
+            a.push_back(float(i % 7));
+            b.push_back(float(i % 5));
+        }
+        float scalar = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) {
+            scalar += a[i] * b[i];
+        }
+        auto ca = Slice<float>(a).simd_chunks<8>();
+        auto cb = Slice<float>(b).simd_chunks<8>();
+        float tail = 0.0f;
+        for (size_t i = 0; i < ca.remainder().len(); ++i) {
+            tail += ca.remainder()[i] * cb.remainder()[i];
+        }
+        auto acc = ca.zip(std::move(cb)).fold(f32x8(), [](f32x8 s, Tuple<f32x8, f32x8> p) {
+            return s + p.get<0>() * p.get<1>();
+        });
+        assert_eq_(acc.reduce_sum() + tail, scalar);
+    }
+    rtest_(native_lanes) {
+        typedef Simd<float, simd_lanes<float>> native;
+        assert_eq_(native::lanes() * sizeof(float), simd_native_bytes);
+        assert_eq_(simd_lanes<double> * 2, simd_lanes<float>);
+    }
+    rtest_(display) {
+        assert_eq_((format_("{}", Simd<int8_t, 2>::splat(-1))), std::string("[-1, -1]"));
+        assert_eq_(format_("{}", i32x4::from_array({1, 2, 3, 4})), std::string("[1, 2, 3, 4]"));
+        assert_eq_(format_("{}", i32x4::splat(1) < i32x4::from_array({0, 2, 0, 2})), std::string("[false, true, false, true]"));
+    }
+}
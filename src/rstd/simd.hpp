@@ -0,0 +1,523 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <type_traits>
+#include "prelude.hpp"
+#include "slice.hpp"
+
+
+// Lanes are stored in GCC vector extension types, which are lowered at compile time
+// to the best instruction set enabled for the target (SSE2, AVX2 with `-mavx2`, NEON, ...).
+// Defining `RSTD_SIMD_SCALAR` switches to plain arrays processed lane by lane.
+#if defined(__GNUC__) && !defined(RSTD_SIMD_SCALAR)
+#define RSTD_SIMD_VECTOR_EXTENSIONS
+#endif
+
+#if defined(RSTD_SIMD_VECTOR_EXTENSIONS) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+namespace rstd {
+
+template <typename T, size_t N>
+class Simd;
+template <typename T, size_t N>
+class Mask;
+
+// Size of the widest vector registers enabled at compile time.
+// Wider `Simd` types are split into several registers by the compiler, which is often slower.
+inline constexpr size_t simd_native_bytes =
+#if defined(__AVX2__) && !defined(RSTD_SIMD_SCALAR)
+    32;
+#else
+    16;
+#endif
+// Number of `T` lanes that fit into a native vector register, e.g. `Simd<float, simd_lanes<float>>`
+template <typename T>
+inline constexpr size_t simd_lanes = simd_native_bytes / sizeof(T);
+
+// Signed integer of the same size as `T`, used for mask lanes and shuffle indices
+template <typename T>
+using __simd_int = std::conditional_t<sizeof(T) == 1, int8_t,
+    std::conditional_t<sizeof(T) == 2, int16_t,
+    std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>;
+
+template <typename T, size_t N>
+struct __SimdStorage {
+#ifdef RSTD_SIMD_VECTOR_EXTENSIONS
+    typedef T type __attribute__((vector_size(N * sizeof(T))));
+#else // RSTD_SIMD_VECTOR_EXTENSIONS
+    struct type {
+        T lanes[N];
+        T &operator[](size_t i) { return lanes[i]; }
+        const T &operator[](size_t i) const { return lanes[i]; }
+    };
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS
+};
+
+#ifdef RSTD_SIMD_VECTOR_EXTENSIONS
+#define __RSTD_SIMD_BINARY_OP(op) \
+    Simd operator op(const Simd &other) const { \
+        return Simd(Vector(v op other.v)); \
+    } \
+    Simd &operator op##=(const Simd &other) { \
+        v = v op other.v; \
+        return *this; \
+    }
+#define __RSTD_SIMD_COMPARE_OP(op) \
+    Mask<T, N> operator op(const Simd &other) const { \
+        return Mask<T, N>(typename Mask<T, N>::Vector(v op other.v)); \
+    }
+#else // RSTD_SIMD_VECTOR_EXTENSIONS
+#define __RSTD_SIMD_BINARY_OP(op) \
+    Simd operator op(const Simd &other) const { \
+        Simd r; \
+        for (size_t i = 0; i < N; ++i) { \
+            r.v[i] = T(v[i] op other.v[i]); \
+        } \
+        return r; \
+    } \
+    Simd &operator op##=(const Simd &other) { \
+        return *this = *this op other; \
+    }
+#define __RSTD_SIMD_COMPARE_OP(op) \
+    Mask<T, N> operator op(const Simd &other) const { \
+        Mask<T, N> r; \
+        for (size_t i = 0; i < N; ++i) { \
+            r.set(i, v[i] op other.v[i]); \
+        } \
+        return r; \
+    }
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS
+
+// Result of lane-wise comparison of `Simd<T, N>`
+template <typename T, size_t N>
+class Mask final {
+    friend class Simd<T, N>;
+
+public:
+    typedef __simd_int<T> Lane;
+    typedef typename __SimdStorage<Lane, N>::type Vector;
+
+private:
+    // Every lane is either -1 or 0
+    Vector m;
+
+    explicit Mask(const Vector &m) : m(m) {}
+
+public:
+    Mask() : m() {}
+
+    static Mask splat(bool value) {
+        Mask r;
+        for (size_t i = 0; i < N; ++i) {
+            r.set(i, value);
+        }
+        return r;
+    }
+
+    bool test(size_t i) const {
+        return m[i] != 0;
+    }
+    void set(size_t i, bool value) {
+        m[i] = value ? Lane(-1) : Lane(0);
+    }
+
+    bool all() const {
+        return count() == N;
+    }
+    bool any() const {
+        return count() != 0;
+    }
+    size_t count() const {
+        size_t n = 0;
+        for (size_t i = 0; i < N; ++i) {
+            n += test(i) ? 1 : 0;
+        }
+        return n;
+    }
+    // Bit `i` is set if lane `i` is set, requires `N <= 64`
+    uint64_t to_bitmask() const {
+        static_assert(N <= 64);
+#if defined(RSTD_SIMD_VECTOR_EXTENSIONS) && defined(__SSE2__)
+        // Byte lanes map directly to `pmovmskb`
+        if constexpr (sizeof(Lane) == 1 && N == 16) {
+            return uint64_t(uint32_t(_mm_movemask_epi8(__m128i(m))));
+        }
+#if defined(__AVX2__)
+        if constexpr (sizeof(Lane) == 1 && N == 32) {
+            return uint64_t(uint32_t(_mm256_movemask_epi8(__m256i(m))));
+        }
+#endif // __AVX2__
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS && __SSE2__
+        uint64_t bits = 0;
+        for (size_t i = 0; i < N; ++i) {
+            bits |= uint64_t(test(i) ? 1 : 0) << i;
+        }
+        return bits;
+    }
+
+    Mask operator&(const Mask &other) const {
+        Mask r;
+        for (size_t i = 0; i < N; ++i) {
+            r.m[i] = m[i] & other.m[i];
+        }
+        return r;
+    }
+    Mask operator|(const Mask &other) const {
+        Mask r;
+        for (size_t i = 0; i < N; ++i) {
+            r.m[i] = m[i] | other.m[i];
+        }
+        return r;
+    }
+    Mask operator!() const {
+        Mask r;
+        for (size_t i = 0; i < N; ++i) {
+            r.m[i] = Lane(~m[i]);
+        }
+        return r;
+    }
+    bool operator==(const Mask &other) const {
+        return to_bitmask() == other.to_bitmask();
+    }
+    bool operator!=(const Mask &other) const {
+        return !(*this == other);
+    }
+
+    // Takes lanes of `a` where the mask is set and lanes of `b` otherwise
+    Simd<T, N> select(const Simd<T, N> &a, const Simd<T, N> &b) const {
+#ifdef RSTD_SIMD_VECTOR_EXTENSIONS
+        return Simd<T, N>(typename Simd<T, N>::Vector(m ? a.v : b.v));
+#else // RSTD_SIMD_VECTOR_EXTENSIONS
+        Simd<T, N> r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = test(i) ? a.v[i] : b.v[i];
+        }
+        return r;
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS
+    }
+};
+
+// Vector of `N` lanes of arithmetic type `T`.
+// Integer arithmetic wraps around the same way as the scalar one,
+// bitwise operations and shifts are available for integers only.
+template <typename T, size_t N>
+class Simd final {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Number of lanes must be a power of two");
+
+    friend class Mask<T, N>;
+    template <typename U, size_t M>
+    friend class Simd;
+
+public:
+    typedef T Lane;
+    typedef typename __SimdStorage<T, N>::type Vector;
+
+    static constexpr size_t lanes() {
+        return N;
+    }
+
+private:
+    Vector v;
+
+    explicit Simd(const Vector &v) : v(v) {}
+
+    Simd permute(const std::array<size_t, N> &idx) const {
+#ifdef RSTD_SIMD_VECTOR_EXTENSIONS
+        typename Mask<T, N>::Vector iv;
+        for (size_t i = 0; i < N; ++i) {
+            iv[i] = __simd_int<T>(idx[i]);
+        }
+        return Simd(Vector(__builtin_shuffle(v, iv)));
+#else // RSTD_SIMD_VECTOR_EXTENSIONS
+        Simd r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = v[idx[i]];
+        }
+        return r;
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS
+    }
+
+public:
+    // All lanes are zero
+    Simd() : v() {}
+
+    static Simd splat(T x) {
+        Simd r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = x;
+        }
+        return r;
+    }
+    static Simd from_array(const std::array<T, N> &a) {
+        return load(a.data());
+    }
+    std::array<T, N> to_array() const {
+        std::array<T, N> a;
+        store(a.data());
+        return a;
+    }
+
+    // Unaligned load of `N` elements
+    static Simd load(const T *data) {
+        Simd r;
+        memcpy(&r.v, data, sizeof(Vector));
+        return r;
+    }
+    // Loads first `N` elements of the slice, panics if it is shorter
+    static Simd from_slice(Slice<T> s) {
+        assert_(s.len() >= N);
+        return load(s.data());
+    }
+    // Loads `min(len, N)` elements and fills the rest of lanes with `fill`
+    static Simd load_or(const T *data, size_t len, T fill) {
+        if (len >= N) {
+            return load(data);
+        }
+        Simd r = splat(fill);
+        for (size_t i = 0; i < len; ++i) {
+            r.v[i] = data[i];
+        }
+        return r;
+    }
+    // Unaligned store of `N` elements
+    void store(T *data) const {
+        memcpy(data, &v, sizeof(Vector));
+    }
+    // Stores to the first `N` elements of the slice, panics if it is shorter
+    void store(SliceMut<T> s) const {
+        assert_(s.len() >= N);
+        store(s.data());
+    }
+
+    T operator[](size_t i) const {
+        return v[i];
+    }
+    void set(size_t i, T x) {
+        v[i] = x;
+    }
+
+    __RSTD_SIMD_BINARY_OP(+)
+    __RSTD_SIMD_BINARY_OP(-)
+    __RSTD_SIMD_BINARY_OP(*)
+    __RSTD_SIMD_BINARY_OP(/)
+    __RSTD_SIMD_BINARY_OP(&)
+    __RSTD_SIMD_BINARY_OP(|)
+    __RSTD_SIMD_BINARY_OP(^)
+
+    Simd operator-() const {
+        return Simd() - *this;
+    }
+    Simd operator<<(unsigned s) const {
+        Simd r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = T(v[i] << s);
+        }
+        return r;
+    }
+    Simd operator>>(unsigned s) const {
+        Simd r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = T(v[i] >> s);
+        }
+        return r;
+    }
+
+    __RSTD_SIMD_COMPARE_OP(==)
+    __RSTD_SIMD_COMPARE_OP(!=)
+    __RSTD_SIMD_COMPARE_OP(<)
+    __RSTD_SIMD_COMPARE_OP(<=)
+    __RSTD_SIMD_COMPARE_OP(>)
+    __RSTD_SIMD_COMPARE_OP(>=)
+
+    // Lane-wise minimum and maximum
+    Simd min(const Simd &other) const {
+        return (other < *this).select(other, *this);
+    }
+    Simd max(const Simd &other) const {
+        return (other > *this).select(other, *this);
+    }
+    Simd clamp(const Simd &lo, const Simd &hi) const {
+        return max(lo).min(hi);
+    }
+    Simd abs() const {
+        if constexpr (std::is_signed_v<T>) {
+            return (*this < Simd()).select(-*this, *this);
+        } else {
+            return *this;
+        }
+    }
+
+    // Horizontal reductions
+    T reduce_sum() const {
+        T s = v[0];
+        for (size_t i = 1; i < N; ++i) {
+            s = T(s + v[i]);
+        }
+        return s;
+    }
+    T reduce_product() const {
+        T p = v[0];
+        for (size_t i = 1; i < N; ++i) {
+            p = T(p * v[i]);
+        }
+        return p;
+    }
+    T reduce_min() const {
+        T m = v[0];
+        for (size_t i = 1; i < N; ++i) {
+            m = v[i] < m ? v[i] : m;
+        }
+        return m;
+    }
+    T reduce_max() const {
+        T m = v[0];
+        for (size_t i = 1; i < N; ++i) {
+            m = v[i] > m ? v[i] : m;
+        }
+        return m;
+    }
+
+    // Lane `i` of the result is lane `I[i]` of `self`
+    template <size_t ...I>
+    Simd shuffle() const {
+        static_assert(sizeof...(I) == N);
+        static_assert(((I < N) && ...), "Shuffle index is out of range");
+        return permute(std::array<size_t, N>{I...});
+    }
+    Simd reverse() const {
+        std::array<size_t, N> idx;
+        for (size_t i = 0; i < N; ++i) {
+            idx[i] = N - 1 - i;
+        }
+        return permute(idx);
+    }
+    // Lane `i` of the result is lane `(i + K) % N` of `self`
+    template <size_t K>
+    Simd rotate_lanes_left() const {
+        std::array<size_t, N> idx;
+        for (size_t i = 0; i < N; ++i) {
+            idx[i] = (i + K) % N;
+        }
+        return permute(idx);
+    }
+
+    // Lane-wise conversion like `static_cast<U>`
+    template <typename U>
+    Simd<U, N> cast() const {
+#ifdef RSTD_SIMD_VECTOR_EXTENSIONS
+        return Simd<U, N>(__builtin_convertvector(v, typename Simd<U, N>::Vector));
+#else // RSTD_SIMD_VECTOR_EXTENSIONS
+        Simd<U, N> r;
+        for (size_t i = 0; i < N; ++i) {
+            r.v[i] = U(v[i]);
+        }
+        return r;
+#endif // RSTD_SIMD_VECTOR_EXTENSIONS
+    }
+
+    // Whole vector comparison, `==` and `!=` are lane-wise
+    bool equals(const Simd &other) const {
+        return (*this == other).all();
+    }
+};
+
+#undef __RSTD_SIMD_BINARY_OP
+#undef __RSTD_SIMD_COMPARE_OP
+
+typedef Simd<int8_t, 16> i8x16;
+typedef Simd<uint8_t, 16> u8x16;
+typedef Simd<int16_t, 8> i16x8;
+typedef Simd<uint16_t, 8> u16x8;
+typedef Simd<int32_t, 4> i32x4;
+typedef Simd<int32_t, 8> i32x8;
+typedef Simd<uint32_t, 4> u32x4;
+typedef Simd<uint32_t, 8> u32x8;
+typedef Simd<int64_t, 2> i64x2;
+typedef Simd<int64_t, 4> i64x4;
+typedef Simd<uint64_t, 2> u64x2;
+typedef Simd<uint64_t, 4> u64x4;
+typedef Simd<float, 4> f32x4;
+typedef Simd<float, 8> f32x8;
+typedef Simd<double, 2> f64x2;
+typedef Simd<double, 4> f64x4;
+
+namespace slice {
+
+// Consecutive `Simd<T, N>` loaded from a slice, the tail is available via `remainder()`
+template <typename T, size_t N>
+class SimdChunks final : public Iterator<Simd<T, N>, SimdChunks<T, N>> {
+private:
+    Slice<T> rest, rem;
+public:
+    explicit SimdChunks(Slice<T> s) {
+        auto parts = s.split_at(s.len() - s.len() % N);
+        rest = parts.template get<0>();
+        rem = parts.template get<1>();
+    }
+    Option<Simd<T, N>> next() {
+        if (rest.is_empty()) {
+            return None();
+        }
+        auto r = Simd<T, N>::load(rest.data());
+        rest = rest.slice(N, rest.len());
+        return Option<Simd<T, N>>::Some(r);
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        const T *p = rest.data();
+        size_t n = rest.len() / N;
+        for (size_t i = 0; i < n; ++i) {
+            if (!f(Simd<T, N>::load(p + i * N))) {
+                rest = rest.slice((i + 1) * N, rest.len());
+                return false;
+            }
+        }
+        rest = rest.slice(rest.len(), rest.len());
+        return true;
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, rest.len() / N);
+        rest = rest.slice(k * N, rest.len());
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(rest.len() / N);
+    }
+    Slice<T> remainder() const {
+        return rem;
+    }
+    typedef void Rev;
+};
+
+} // namespace slice
+
+template <typename T, size_t N>
+struct fmt::Display<Simd<T, N>> {
+    static void fmt(const Simd<T, N> &s, std::ostream &o) {
+        o << "[";
+        for (size_t i = 0; i < N; ++i) {
+            // Print 8-bit lanes as numbers rather than characters
+            write_(o, "{}{}", i == 0 ? "" : ", ", +s[i]);
+        }
+        o << "]";
+    }
+};
+
+template <typename T, size_t N>
+struct fmt::Display<Mask<T, N>> {
+    static void fmt(const Mask<T, N> &m, std::ostream &o) {
+        o << "[";
+        for (size_t i = 0; i < N; ++i) {
+            write_(o, "{}{}", i == 0 ? "" : ", ", m.test(i) ? "true" : "false");
+        }
+        o << "]";
+    }
+};
+
+} // namespace rstd
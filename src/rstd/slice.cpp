@@ -0,0 +1,120 @@
+#include <rtest.hpp>
+
+#include <vector>
+#include <array>
+#include "slice.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(slice) {
+    rtest_(index) {
+        std::vector<int> data = {0, 1, 2, 3, 4};
+        Slice<int> s(data);
+        assert_eq_(s.len(), size_t(5));
+        assert_eq_(s[3], 3);
+        assert_eq_(*s.get(4).unwrap(), 4);
+        assert_(s.get(5).is_none());
+        assert_eq_(*s.first().unwrap(), 0);
+        assert_eq_(*s.last().unwrap(), 4);
+        assert_(Slice<int>().last().is_none());
+    }
+#ifndef RSTD_NO_BOUNDS_CHECK
+    rtest_should_panic_(index_out_of_bounds) {
+        std::array<int, 3> data = {0, 1, 2};
+        Slice<int> s(data);
+        s[3];
+    }
+    rtest_should_panic_(slice_out_of_bounds) {
+        int data[] = {0, 1, 2};
+        Slice<int>(data).slice(2, 4);
+    }
+#endif // RSTD_NO_BOUNDS_CHECK
+    rtest_(split_at) {
+        int data[] = {0, 1, 2, 3, 4};
+        auto parts = Slice<int>(data).split_at(2);
+        assert_eq_(parts.get<0>().len(), size_t(2));
+        assert_eq_(parts.get<1>().len(), size_t(3));
+        assert_eq_(parts.get<1>()[0], 2);
+        assert_(Slice<int>(data).slice(1, 3) == Slice<int>(data + 1, 2));
+    }
+    rtest_(iter) {
+        std::vector<int> data = {1, 2, 3, 4};
+        assert_eq_(Slice<int>(data).iter().cloned().sum(), 10);
+        int sum = 0;
+        for (int x : Slice<int>(data).slice(2, 4)) {
+            sum += x;
+        }
+        assert_eq_(sum, 7);
+    }
+    rtest_(chunks) {
+        std::vector<int> data = {0, 1, 2, 3, 4, 5, 6};
+        auto chunks = Slice<int>(data).chunks(3);
+        assert_eq_(chunks.len(), size_t(3));
+        assert_eq_(chunks.next().unwrap()[0], 0);
+        auto c = chunks.next().unwrap();
+        assert_eq_(c.len(), size_t(3));
+        assert_eq_(c[2], 5);
+        auto tail = chunks.next().unwrap();
+        assert_eq_(tail.len(), size_t(1));
+        assert_eq_(tail[0], 6);
+        assert_(chunks.next().is_none());
+
+        auto skipped = Slice<int>(data).chunks(2).nth(3).unwrap();
+        assert_eq_(skipped.len(), size_t(1));
+        assert_eq_(skipped[0], 6);
+    }
+    rtest_(chunks_exact) {
+        std::vector<int> data = {0, 1, 2, 3, 4, 5, 6};
+        auto chunks = Slice<int>(data).chunks_exact(3);
+        assert_eq_(chunks.remainder().len(), size_t(1));
+        assert_eq_(chunks.remainder()[0], 6);
+        size_t n = chunks.map([](Slice<int> c) {
+            assert_eq_(c.len(), size_t(3));
+            return c[0];
+        }).sum();
+        assert_eq_(n, size_t(3));
+    }
+    rtest_(rchunks) {
+        std::vector<int> data = {0, 1, 2, 3, 4};
+        auto chunks = Slice<int>(data).rchunks(2);
+        assert_eq_(chunks.next().unwrap()[0], 3);
+        assert_eq_(chunks.next().unwrap()[0], 1);
+        auto head = chunks.next().unwrap();
+        assert_eq_(head.len(), size_t(1));
+        assert_eq_(head[0], 0);
+        assert_(chunks.next().is_none());
+    }
+    rtest_(windows) {
+        std::vector<int> data = {1, 2, 3, 4, 5};
+        auto windows = Slice<int>(data).windows(3);
+        assert_eq_(windows.len(), size_t(3));
+        auto sums = windows.map([](Slice<int> w) {
+            return w[0] + w[1] + w[2];
+        }).collect<std::vector>();
+        assert_eq_(sums.size(), size_t(3));
+        assert_eq_(sums[0], 6);
+        assert_eq_(sums[2], 12);
+        assert_(Slice<int>(data).windows(6).next().is_none());
+    }
+    rtest_(slice_mut) {
+        std::vector<int> data(6, 0);
+        SliceMut<int> s(data);
+        s.slice(0, 3).fill(1);
+        s[5] = 7;
+        int i = 0;
+        for (SliceMut<int> c : s.chunks(2)) {
+            c[0] += i;
+            i += 1;
+        }
+        assert_eq_(data[0], 1);
+        assert_eq_(data[2], 2);
+        assert_eq_(data[4], 2);
+        s.reverse();
+        assert_eq_(data[0], 7);
+        s.copy_from(Slice<int>(std::vector<int>{5, 4, 3, 2, 1, 0}));
+        assert_eq_(data[1], 4);
+        Slice<int> view = s;
+        assert_eq_(view[5], 0);
+    }
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cstdlib>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+template <typename T>
+class Slice;
+template <typename T>
+class SliceMut;
+
+namespace slice {
+
+template <typename S>
+class Chunks;
+template <typename S>
+class ChunksExact;
+template <typename S>
+class RChunks;
+template <typename S>
+class Windows;
+template <typename T, size_t N>
+class SimdChunks;
+
+} // namespace slice
+
+// Common part of `Slice` and `SliceMut`.
+// `E` is the element type as seen through the view, i.e. `const T` for `Slice<T>`.
+//
+// Indexing is bounds-checked unless `RSTD_NO_BOUNDS_CHECK` is defined,
+// `_get_unchecked` never checks.
+template <typename E, typename Self>
+class __SliceBase {
+protected:
+    E *ptr_ = nullptr;
+    size_t len_ = 0;
+
+    void __check_index(size_t i) const {
+#ifndef RSTD_NO_BOUNDS_CHECK
+        if (i >= len_) {
+            panic_("Index {} is out of bounds of slice of length {}", i, len_);
+        }
+#else // RSTD_NO_BOUNDS_CHECK
+        (void)i;
+#endif // RSTD_NO_BOUNDS_CHECK
+    }
+    void __check_range(size_t from, size_t to) const {
+#ifndef RSTD_NO_BOUNDS_CHECK
+        if (from > to || to > len_) {
+            panic_("Range {}..{} is out of bounds of slice of length {}", from, to, len_);
+        }
+#else // RSTD_NO_BOUNDS_CHECK
+        (void)from;
+        (void)to;
+#endif // RSTD_NO_BOUNDS_CHECK
+    }
+
+public:
+    typedef E *iterator;
+
+    __SliceBase() = default;
+    __SliceBase(E *ptr, size_t len) : ptr_(ptr), len_(len) {}
+
+    size_t len() const { return len_; }
+    bool is_empty() const { return len_ == 0; }
+    E *data() const { return ptr_; }
+
+    E *begin() const { return ptr_; }
+    E *end() const { return ptr_ + len_; }
+
+    E &operator[](size_t i) const {
+        __check_index(i);
+        return ptr_[i];
+    }
+    E &_get_unchecked(size_t i) const {
+        return ptr_[i];
+    }
+    Option<E *> get(size_t i) const {
+        if (i < len_) {
+            return Option<E *>::Some(ptr_ + i);
+        } else {
+            return Option<E *>::None();
+        }
+    }
+    Option<E *> first() const {
+        return get(0);
+    }
+    Option<E *> last() const {
+        return len_ > 0 ? get(len_ - 1) : Option<E *>::None();
+    }
+
+    // Elements in `from..to`
+    Self slice(size_t from, size_t to) const {
+        __check_range(from, to);
+        return Self(ptr_ + from, to - from);
+    }
+    // Divides into `0..mid` and `mid..len()`
+    Tuple<Self, Self> split_at(size_t mid) const {
+        __check_range(mid, len_);
+        return Tuple<Self, Self>(Self(ptr_, mid), Self(ptr_ + mid, len_ - mid));
+    }
+
+    Iter<Slice, std::remove_const_t<E>, E *, E *> iter() const {
+        return Iter<Slice, std::remove_const_t<E>, E *, E *>(begin(), end());
+    }
+
+    // Consecutive sub-slices of `n` elements, the last one may be shorter
+    rstd::slice::Chunks<Self> chunks(size_t n) const {
+        return rstd::slice::Chunks<Self>(self(), n);
+    }
+    // Consecutive sub-slices of exactly `n` elements, the rest is available via `remainder()`
+    rstd::slice::ChunksExact<Self> chunks_exact(size_t n) const {
+        return rstd::slice::ChunksExact<Self>(self(), n);
+    }
+    // Same as `chunks` but starting from the end, so that the first one may be shorter
+    rstd::slice::RChunks<Self> rchunks(size_t n) const {
+        return rstd::slice::RChunks<Self>(self(), n);
+    }
+    // Consecutive `Simd<T, N>` vectors, see `simd.hpp`
+    template <size_t N>
+    rstd::slice::SimdChunks<std::remove_const_t<E>, N> simd_chunks() const {
+        typedef std::remove_const_t<E> T;
+        return rstd::slice::SimdChunks<T, N>(Slice<T>(ptr_, len_));
+    }
+
+private:
+    Self self() const { return Self(ptr_, len_); }
+};
+
+// Immutable view of contiguous elements
+template <typename T>
+class Slice final : public __SliceBase<const T, Slice<T>> {
+public:
+    typedef Slice Self;
+
+    Slice() = default;
+    Slice(const T *ptr, size_t len) : __SliceBase<const T, Slice<T>>(ptr, len) {}
+    Slice(const std::vector<T> &v) : Slice(v.data(), v.size()) {}
+    template <size_t N>
+    Slice(const std::array<T, N> &a) : Slice(a.data(), N) {}
+    template <size_t N>
+    Slice(const T (&a)[N]) : Slice(a, N) {}
+
+    // Overlapping sub-slices of `n` elements
+    rstd::slice::Windows<Slice> windows(size_t n) const {
+        return rstd::slice::Windows<Slice>(*this, n);
+    }
+
+    bool operator==(const Slice &other) const {
+        return this->len_ == other.len_ && std::equal(this->begin(), this->end(), other.begin());
+    }
+    bool operator!=(const Slice &other) const {
+        return !(*this == other);
+    }
+};
+
+// Mutable view of contiguous elements
+template <typename T>
+class SliceMut final : public __SliceBase<T, SliceMut<T>> {
+public:
+    typedef SliceMut Self;
+
+    SliceMut() = default;
+    SliceMut(T *ptr, size_t len) : __SliceBase<T, SliceMut<T>>(ptr, len) {}
+    SliceMut(std::vector<T> &v) : SliceMut(v.data(), v.size()) {}
+    template <size_t N>
+    SliceMut(std::array<T, N> &a) : SliceMut(a.data(), N) {}
+    template <size_t N>
+    SliceMut(T (&a)[N]) : SliceMut(a, N) {}
+
+    operator Slice<T>() const {
+        return Slice<T>(this->ptr_, this->len_);
+    }
+    Slice<T> as_slice() const {
+        return Slice<T>(*this);
+    }
+
+    void fill(const T &value) const {
+        std::fill(this->begin(), this->end(), value);
+    }
+    // Copies elements from `src` which must be of the same length
+    void copy_from(Slice<T> src) const {
+        assert_eq_(this->len_, src.len());
+        std::copy(src.begin(), src.end(), this->begin());
+    }
+    void swap(size_t a, size_t b) const {
+        std::swap((*this)[a], (*this)[b]);
+    }
+    void reverse() const {
+        std::reverse(this->begin(), this->end());
+    }
+};
+
+namespace slice {
+
+inline size_t __div_ceil(size_t a, size_t b) {
+    return a / b + (a % b != 0 ? 1 : 0);
+}
+
+template <typename S>
+class Chunks final : public Iterator<S, Chunks<S>> {
+private:
+    S rest;
+    size_t size;
+public:
+    Chunks(S s, size_t n) : rest(s), size(n) {
+        assert_(n > 0);
+    }
+    Option<S> next() {
+        if (rest.is_empty()) {
+            return None();
+        }
+        auto parts = rest.split_at(std::min(size, rest.len()));
+        rest = parts.template get<1>();
+        return Option<S>::Some(parts.template get<0>());
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, __div_ceil(rest.len(), size));
+        rest = rest.slice(std::min(k * size, rest.len()), rest.len());
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(__div_ceil(rest.len(), size));
+    }
+    typedef void Rev;
+};
+
+template <typename S>
+class ChunksExact final : public Iterator<S, ChunksExact<S>> {
+private:
+    S rest, rem;
+    size_t size;
+public:
+    ChunksExact(S s, size_t n) : size(n) {
+        assert_(n > 0);
+        auto parts = s.split_at(s.len() - s.len() % n);
+        rest = parts.template get<0>();
+        rem = parts.template get<1>();
+    }
+    Option<S> next() {
+        if (rest.is_empty()) {
+            return None();
+        }
+        auto parts = rest.split_at(size);
+        rest = parts.template get<1>();
+        return Option<S>::Some(parts.template get<0>());
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, rest.len() / size);
+        rest = rest.slice(k * size, rest.len());
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(rest.len() / size);
+    }
+    // Last `len() % n` elements that don't form a whole chunk
+    S remainder() const {
+        return rem;
+    }
+    typedef void Rev;
+};
+
+template <typename S>
+class RChunks final : public Iterator<S, RChunks<S>> {
+private:
+    S rest;
+    size_t size;
+public:
+    RChunks(S s, size_t n) : rest(s), size(n) {
+        assert_(n > 0);
+    }
+    Option<S> next() {
+        if (rest.is_empty()) {
+            return None();
+        }
+        auto parts = rest.split_at(rest.len() - std::min(size, rest.len()));
+        rest = parts.template get<0>();
+        return Option<S>::Some(parts.template get<1>());
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(__div_ceil(rest.len(), size));
+    }
+    typedef void Rev;
+};
+
+template <typename S>
+class Windows final : public Iterator<S, Windows<S>> {
+private:
+    S rest;
+    size_t size;
+public:
+    Windows(S s, size_t n) : rest(s), size(n) {
+        assert_(n > 0);
+    }
+    Option<S> next() {
+        if (rest.len() < size) {
+            return None();
+        }
+        S w = rest.slice(0, size);
+        rest = rest.slice(1, rest.len());
+        return Option<S>::Some(w);
+    }
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, rest.len() >= size ? rest.len() - size + 1 : 0);
+        rest = rest.slice(k, rest.len());
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(rest.len() >= size ? rest.len() - size + 1 : 0);
+    }
+    typedef void Rev;
+};
+
+} // namespace slice
+
+} // namespace rstd
@@ -0,0 +1,133 @@
+#include <rtest.hpp>
+
+#include <string>
+#include <vector>
+#include "small_vec.hpp"
+
+using namespace rstd;
+
+
+rtest_module_(small_vec) {
+    rtest_(spill) {
+        SmallVec<std::string, 4> v;
+        assert_eq_(v.capacity(), size_t(4));
+        const std::string *inline_ptr = v.data();
+        for (int i = 0; i < 4; ++i) {
+            v.push(std::to_string(i));
+        }
+        assert_(!v.spilled());
+        assert_eq_(v.data(), inline_ptr);
+        v.push(std::string("4"));
+        assert_(v.spilled());
+        assert_(v.data() != inline_ptr);
+        assert_eq_(v.capacity(), size_t(8));
+        assert_eq_(v.len(), size_t(5));
+        assert_eq_(v[0], std::string("0"));
+        assert_eq_(v[4], std::string("4"));
+
+        v.truncate(3);
+        v.shrink_to_fit();
+        assert_(!v.spilled());
+        assert_eq_(v[2], std::string("2"));
+        assert_eq_(v.pop().unwrap(), std::string("2"));
+    }
+    rtest_(move) {
+        SmallVec<Box<int>, 2> a;
+        a.push(Box<int>(1));
+        SmallVec<Box<int>, 2> b = std::move(a);
+        assert_(a.is_empty());
+        assert_eq_(*b[0], 1);
+        b.push(Box<int>(2));
+        b.push(Box<int>(3));
+        const Box<int> *heap = b.data();
+        a = std::move(b);
+        assert_eq_(a.data(), heap);
+        assert_eq_(*a[2], 3);
+        assert_(!b.spilled());
+        SmallVec<Box<int>, 2> c;
+        c.push(Box<int>(5));
+        a = std::move(c);
+        assert_eq_(a.len(), size_t(1));
+        assert_eq_(*a[0], 5);
+    }
+    rtest_(try_reserve) {
+        SmallVec<int, 8> v = {1, 2, 3};
+        v.try_reserve(8).unwrap();
+        assert_(v.spilled());
+        auto overflow = v.try_reserve(SIZE_MAX);
+        assert_eq_(overflow.take_err().kind, AllocError::CAPACITY_OVERFLOW);
+        v.try_push(4).unwrap();
+        assert_(v == (SmallVec<int, 8>{1, 2, 3, 4}));
+    }
+    rtest_(insert_remove) {
+        SmallVec<int, 3> v = {1, 3};
+        v.insert(1, 2);
+        v.insert(3, 4);
+        assert_(v.spilled());
+        assert_(v == (SmallVec<int, 3>{1, 2, 3, 4}));
+        assert_eq_(v.remove(0), 1);
+        assert_eq_(v.swap_remove(0), 2);
+        v.retain([](const int &x) { return x != 3; });
+        assert_(v == (SmallVec<int, 3>{4}));
+    }
+    rtest_(iter) {
+        SmallVec<int, 4> v;
+        v.extend_from_iter(Range(6));
+        assert_eq_(iter_ref(v).cloned().sum(), 15);
+        iter_ref(v).for_each([](int *x) { *x *= 2; });
+        assert_eq_(v.as_slice()[5], 10);
+        assert_eq_(v.iter().count(), size_t(6));
+        assert_eq_(format_("{}", v), std::string("[0, 2, 4, 6, 8, 10]"));
+
+        auto small = Range(3).map([](int x) { return std::to_string(x); }).collect<SmallVec<std::string, 4>>();
+        assert_(!small.spilled());
+        auto iter = into_iter(std::move(small));
+        assert_eq_(iter.next().unwrap(), std::string("0"));
+        auto moved = std::move(iter);
+        assert_eq_(moved.len(), size_t(2));
+        assert_eq_(moved.fold(std::string(), [](std::string a, std::string b) { return a + b; }), std::string("12"));
+
+        auto big = Range(10).collect<SmallVec<int, 4>>();
+        assert_(big.spilled());
+        assert_eq_(into_iter(std::move(big)).skip(5).sum(), 5 + 6 + 7 + 8 + 9);
+    }
+}
+
+rtest_module_(array_vec) {
+    rtest_(push_full) {
+        ArrayVec<int, 3> v;
+        assert_eq_(v.capacity(), size_t(3));
+        v.push(1);
+        v.try_push(2).unwrap();
+        v.push(3);
+        assert_(v.is_full());
+        assert_eq_(v.try_push(4).unwrap_err(), 4);
+        assert_eq_(v.pop().unwrap(), 3);
+        assert_eq_(v.remaining_capacity(), size_t(1));
+        v.insert(0, 0);
+        assert_(v == (ArrayVec<int, 3>{0, 1, 2}));
+    }
+    rtest_(strings) {
+        ArrayVec<std::string, 4> v = {"a", "b"};
+        ArrayVec<std::string, 4> c = v;
+        c.push(std::string("c"));
+        v = std::move(c);
+        assert_eq_(v.len(), size_t(3));
+        assert_(c.is_empty());
+        assert_eq_(v.remove(1), std::string("b"));
+        assert_eq_(format_("{}", v), std::string("[a, c]"));
+    }
+    rtest_(iter) {
+        auto v = Range(5).collect<ArrayVec<int, 8>>();
+        assert_eq_(v.len(), size_t(5));
+        assert_eq_(iter_ref(v).cloned().max().unwrap(), 4);
+        const ArrayVec<int, 8> &cv = v;
+        assert_eq_(*iter_ref(cv).nth(2).unwrap(), 2);
+        auto slice = v.as_mut_slice();
+        slice.reverse();
+        assert_eq_(v[0], 4);
+        auto collected = into_iter(std::move(v)).collect();
+        assert_eq_(collected.len(), size_t(5));
+        assert_eq_(collected[4], 0);
+    }
+}
@@ -0,0 +1,585 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+template <typename T, size_t N>
+class ArrayVec;
+template <typename T, size_t N>
+class SmallVec;
+
+namespace small_vec {
+
+template <typename V>
+class IntoIter;
+
+} // namespace small_vec
+
+// Common part of `ArrayVec` and `SmallVec` that doesn't change capacity.
+// `Self` provides `data()`, `len()` and `__set_len(n)`.
+template <typename T, typename Self>
+class __InlineVecBase {
+private:
+    Self &self() { return *static_cast<Self *>(this); }
+    const Self &self() const { return *static_cast<const Self *>(this); }
+
+protected:
+    void __check_index(size_t i, size_t len) const {
+#ifndef RSTD_NO_BOUNDS_CHECK
+        if (i >= len) {
+            panic_("Index {} is out of bounds of vector of length {}", i, len);
+        }
+#else // RSTD_NO_BOUNDS_CHECK
+        (void)i;
+        (void)len;
+#endif // RSTD_NO_BOUNDS_CHECK
+    }
+    // Shifts elements from `i` one step right and constructs `x` at `i`, capacity must allow it
+    void __insert(size_t i, T &&x) {
+        size_t len = self().len();
+        __check_index(i, len + 1);
+        T *p = self().data();
+        vec::__relocate(p + i + 1, p + i, len - i);
+        new (p + i) T(std::move(x));
+        self().__set_len(len + 1);
+    }
+
+public:
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef T value_type;
+
+    size_t size() const { return self().len(); }
+    bool is_empty() const { return self().len() == 0; }
+
+    T *begin() { return self().data(); }
+    T *end() { return self().data() + self().len(); }
+    const T *begin() const { return self().data(); }
+    const T *end() const { return self().data() + self().len(); }
+
+    T &operator[](size_t i) {
+        __check_index(i, self().len());
+        return self().data()[i];
+    }
+    const T &operator[](size_t i) const {
+        __check_index(i, self().len());
+        return self().data()[i];
+    }
+    Option<T *> get(size_t i) {
+        return i < self().len() ? Option<T *>::Some(self().data() + i) : Option<T *>::None();
+    }
+    Option<const T *> get(size_t i) const {
+        return i < self().len() ? Option<const T *>::Some(self().data() + i) : Option<const T *>::None();
+    }
+
+    Slice<T> as_slice() const {
+        return Slice<T>(self().data(), self().len());
+    }
+    SliceMut<T> as_mut_slice() {
+        return SliceMut<T>(self().data(), self().len());
+    }
+    decltype(auto) iter() const {
+        return as_slice().iter();
+    }
+
+    Option<T> pop() {
+        size_t len = self().len();
+        if (len == 0) {
+            return None();
+        }
+        T *p = self().data() + len - 1;
+        T x = std::move(*p);
+        p->~T();
+        self().__set_len(len - 1);
+        return Option<T>::Some(std::move(x));
+    }
+    // Removes the element at position `i` shifting the following ones
+    T remove(size_t i) {
+        size_t len = self().len();
+        __check_index(i, len);
+        T *p = self().data();
+        T x = std::move(p[i]);
+        p[i].~T();
+        vec::__relocate(p + i, p + i + 1, len - i - 1);
+        self().__set_len(len - 1);
+        return x;
+    }
+    // Removes the element at position `i` replacing it with the last one
+    T swap_remove(size_t i) {
+        size_t len = self().len();
+        __check_index(i, len);
+        T *p = self().data();
+        T x = std::move(p[i]);
+        p[i].~T();
+        if (i != len - 1) {
+            vec::__relocate(p + i, p + len - 1, 1);
+        }
+        self().__set_len(len - 1);
+        return x;
+    }
+    void truncate(size_t n) {
+        size_t len = self().len();
+        if (n < len) {
+            vec::__destroy(self().data() + n, len - n);
+            self().__set_len(n);
+        }
+    }
+    void clear() {
+        truncate(0);
+    }
+    // Keeps only elements for which `f(&x)` returns `true` preserving their order
+    template <typename F>
+    void retain(F &&f) {
+        T *p = self().data();
+        size_t len = self().len(), w = 0;
+        for (size_t r = 0; r < len; ++r) {
+            if (f(const_cast<const T &>(p[r]))) {
+                if (w != r) {
+                    vec::__relocate(p + w, p + r, 1);
+                }
+                w += 1;
+            } else {
+                p[r].~T();
+            }
+        }
+        self().__set_len(w);
+    }
+
+    bool operator==(const Self &other) const {
+        return size() == other.size() && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const Self &other) const {
+        return !(*this == other);
+    }
+};
+
+// Vector with fixed capacity of `N` elements stored inline, it never allocates.
+// `try_push` returns the element back if the vector is full, other growing methods panic.
+template <typename T, size_t N>
+class ArrayVec final : public __InlineVecBase<T, ArrayVec<T, N>> {
+private:
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    size_t len_ = 0;
+
+    void check_space(size_t additional) const {
+        if (additional > N - len_) {
+            panic_("ArrayVec of capacity {} is full", N);
+        }
+    }
+
+public:
+    static_assert(N > 0);
+
+    ArrayVec() = default;
+    ArrayVec(std::initializer_list<T> list) {
+        check_space(list.size());
+        for (const T &x : list) {
+            new (data() + len_) T(x);
+            len_ += 1;
+        }
+    }
+    ArrayVec(const ArrayVec &other) {
+        for (const T &x : other) {
+            new (data() + len_) T(x);
+            len_ += 1;
+        }
+    }
+    ArrayVec &operator=(const ArrayVec &other) {
+        if (this != &other) {
+            ArrayVec copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    ArrayVec(ArrayVec &&other) {
+        vec::__relocate(data(), other.data(), other.len_);
+        len_ = other.len_;
+        other.len_ = 0;
+    }
+    ArrayVec &operator=(ArrayVec &&other) {
+        if (this != &other) {
+            this->clear();
+            vec::__relocate(data(), other.data(), other.len_);
+            len_ = other.len_;
+            other.len_ = 0;
+        }
+        return *this;
+    }
+    ~ArrayVec() {
+        this->clear();
+    }
+
+    static constexpr size_t capacity() { return N; }
+    size_t len() const { return len_; }
+    bool is_full() const { return len_ == N; }
+    size_t remaining_capacity() const { return N - len_; }
+
+    T *data() { return reinterpret_cast<T *>(storage); }
+    const T *data() const { return reinterpret_cast<const T *>(storage); }
+    // Sets length without constructing or dropping elements
+    void __set_len(size_t n) { len_ = n; }
+
+    void push(T &&x) {
+        check_space(1);
+        new (data() + len_) T(std::move(x));
+        len_ += 1;
+    }
+    void push(const T &x) {
+        push(T(x));
+    }
+    void push_back(T &&x) {
+        push(std::move(x));
+    }
+    void push_back(const T &x) {
+        push(T(x));
+    }
+    // Returns `x` back if the vector is full
+    Result<Tuple<>, T> try_push(T &&x) {
+        if (len_ == N) {
+            return Result<Tuple<>, T>::Err(std::move(x));
+        }
+        new (data() + len_) T(std::move(x));
+        len_ += 1;
+        return Result<Tuple<>, T>::Ok();
+    }
+    Result<Tuple<>, T> try_push(const T &x) {
+        return try_push(T(x));
+    }
+    void insert(size_t i, T &&x) {
+        check_space(1);
+        this->__insert(i, std::move(x));
+    }
+    // Only checks that there is space for `additional` elements
+    void reserve(size_t additional) {
+        check_space(additional);
+    }
+    template <typename I>
+    void extend_from_iter(I &&iter) {
+        iter.for_each([this](T &&x) {
+            push(std::move(x));
+        });
+    }
+};
+
+// Vector that stores up to `N` elements inline and moves them to the heap when it grows beyond that.
+// The heap buffer is grown like `Vec` and reported allocation failures by `try_*` methods.
+template <typename T, size_t N>
+class SmallVec final : public __InlineVecBase<T, SmallVec<T, N>> {
+private:
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    // Null while the elements are stored inline
+    T *heap = nullptr;
+    size_t len_ = 0, cap_ = N;
+
+    static constexpr size_t max_capacity = size_t(PTRDIFF_MAX) / sizeof(T);
+
+    T *inline_data() { return reinterpret_cast<T *>(storage); }
+
+    Result<Tuple<>, AllocError> set_capacity(size_t cap) {
+        if (cap <= N) {
+            // Moves back inline
+            if (heap != nullptr) {
+                vec::__relocate(inline_data(), heap, len_);
+                vec::__deallocate(heap);
+                heap = nullptr;
+                cap_ = N;
+            }
+            return Result<Tuple<>, AllocError>::Ok();
+        }
+        if (cap > max_capacity) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        T *ptr = nullptr;
+        if constexpr (vec::__reallocatable<T>) {
+            if (heap != nullptr) {
+                ptr = static_cast<T *>(std::realloc(static_cast<void *>(heap), cap * sizeof(T)));
+            }
+        }
+        if (ptr == nullptr) {
+            ptr = vec::__allocate<T>(cap);
+            if (ptr == nullptr) {
+                return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::OUT_OF_MEMORY, cap * sizeof(T)));
+            }
+            vec::__relocate(ptr, data(), len_);
+            if (heap != nullptr) {
+                vec::__deallocate(heap);
+            }
+        }
+        heap = ptr;
+        cap_ = cap;
+        return Result<Tuple<>, AllocError>::Ok();
+    }
+    Result<Tuple<>, AllocError> grow(size_t additional) {
+        if (additional <= cap_ - len_) {
+            return Result<Tuple<>, AllocError>::Ok();
+        }
+        if (additional > max_capacity - len_) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        size_t required = len_ + additional;
+        return set_capacity(std::max(std::min(2 * cap_, max_capacity), required));
+    }
+    static void expect(Result<Tuple<>, AllocError> &&res) {
+        if (res.is_err()) {
+            const AllocError &e = res.get_err();
+            if (e.kind == AllocError::CAPACITY_OVERFLOW) {
+                panic_("Capacity overflow");
+            } else {
+                panic_("Allocation of {} bytes failed", e.size);
+            }
+        }
+        res.clear();
+    }
+    void take(SmallVec &other) {
+        if (other.heap != nullptr) {
+            heap = other.heap;
+            cap_ = other.cap_;
+        } else {
+            vec::__relocate(inline_data(), other.inline_data(), other.len_);
+        }
+        len_ = other.len_;
+        other.heap = nullptr;
+        other.len_ = 0;
+        other.cap_ = N;
+    }
+    void release() {
+        this->clear();
+        if (heap != nullptr) {
+            vec::__deallocate(heap);
+            heap = nullptr;
+            cap_ = N;
+        }
+    }
+
+public:
+    static_assert(N > 0);
+
+    SmallVec() = default;
+    SmallVec(std::initializer_list<T> list) {
+        reserve(list.size());
+        for (const T &x : list) {
+            new (data() + len_) T(x);
+            len_ += 1;
+        }
+    }
+    SmallVec(const SmallVec &other) {
+        reserve(other.len_);
+        for (const T &x : other) {
+            new (data() + len_) T(x);
+            len_ += 1;
+        }
+    }
+    SmallVec &operator=(const SmallVec &other) {
+        if (this != &other) {
+            SmallVec copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    SmallVec(SmallVec &&other) {
+        take(other);
+    }
+    SmallVec &operator=(SmallVec &&other) {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+    ~SmallVec() {
+        release();
+    }
+
+    static constexpr size_t inline_capacity() { return N; }
+    size_t capacity() const { return cap_; }
+    size_t len() const { return len_; }
+    // Whether the elements were moved to the heap
+    bool spilled() const { return heap != nullptr; }
+
+    T *data() { return heap != nullptr ? heap : inline_data(); }
+    const T *data() const { return const_cast<SmallVec *>(this)->data(); }
+    // Sets length without constructing or dropping elements
+    void __set_len(size_t n) { len_ = n; }
+
+    // Reserves space for at least `additional` more elements
+    void reserve(size_t additional) {
+        expect(grow(additional));
+    }
+    Result<Tuple<>, AllocError> try_reserve(size_t additional) {
+        return grow(additional);
+    }
+    // Moves the elements back inline if they fit, otherwise reallocates the heap buffer to fit them
+    void shrink_to_fit() {
+        if (cap_ > std::max(len_, N)) {
+            set_capacity(len_).clear();
+        }
+    }
+
+    void push(T &&x) {
+        if (len_ == cap_) {
+            reserve(1);
+        }
+        new (data() + len_) T(std::move(x));
+        len_ += 1;
+    }
+    void push(const T &x) {
+        push(T(x));
+    }
+    void push_back(T &&x) {
+        push(std::move(x));
+    }
+    void push_back(const T &x) {
+        push(T(x));
+    }
+    // Drops `x` if there is no memory for it
+    Result<Tuple<>, AllocError> try_push(T &&x) {
+        if (len_ == cap_) {
+            auto res = grow(1);
+            if (res.is_err()) {
+                return res;
+            }
+            res.clear();
+        }
+        new (data() + len_) T(std::move(x));
+        len_ += 1;
+        return Result<Tuple<>, AllocError>::Ok();
+    }
+    Result<Tuple<>, AllocError> try_push(const T &x) {
+        return try_push(T(x));
+    }
+    void insert(size_t i, T &&x) {
+        if (len_ == cap_) {
+            reserve(1);
+        }
+        this->__insert(i, std::move(x));
+    }
+    // Appends all items of `iter` reserving space for the lower bound of its length first
+    template <typename I>
+    void extend_from_iter(I &&iter) {
+        reserve(iter.size_hint().lower);
+        iter.for_each([this](T &&x) {
+            push(std::move(x));
+        });
+    }
+};
+
+namespace small_vec {
+
+// Owning iterator over elements of `ArrayVec` or `SmallVec`.
+// Consumed elements are left moved-from until the iterator is dropped.
+template <typename V>
+class IntoIter final : public Iterator<typename V::value_type, IntoIter<V>> {
+private:
+    typedef typename V::value_type T;
+    V vec;
+    size_t cur = 0;
+
+public:
+    explicit IntoIter(V &&v) : vec(std::move(v)) {}
+    IntoIter(const IntoIter &) = delete;
+    IntoIter &operator=(const IntoIter &) = delete;
+    IntoIter(IntoIter &&other) : vec(std::move(other.vec)), cur(other.cur) {
+        other.cur = 0;
+    }
+    IntoIter &operator=(IntoIter &&other) {
+        vec = std::move(other.vec);
+        cur = other.cur;
+        other.cur = 0;
+        return *this;
+    }
+
+    Option<T> next() {
+        if (cur == vec.len()) {
+            return None();
+        }
+        cur += 1;
+        return Option<T>::Some(std::move(vec.data()[cur - 1]));
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        T *p = vec.data();
+        size_t c = cur, e = vec.len();
+        bool done = true;
+        while (c != e) {
+            T x = std::move(p[c]);
+            ++c;
+            if (!f(std::move(x))) {
+                done = false;
+                break;
+            }
+        }
+        cur = c;
+        return done;
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = std::min(n, vec.len() - cur);
+        std::move(vec.data() + cur, vec.data() + cur + k, buf);
+        cur += k;
+        return k;
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(vec.len() - cur);
+    }
+    typedef void Rev;
+};
+
+} // namespace small_vec
+
+template <typename T, size_t N>
+small_vec::IntoIter<ArrayVec<T, N>> into_iter(ArrayVec<T, N> &&v) {
+    return small_vec::IntoIter<ArrayVec<T, N>>(std::move(v));
+}
+template <typename T, size_t N>
+small_vec::IntoIter<SmallVec<T, N>> into_iter(SmallVec<T, N> &&v) {
+    return small_vec::IntoIter<SmallVec<T, N>>(std::move(v));
+}
+
+template <typename T, size_t N>
+Iter<Slice, T, const T *, const T *> iter_ref(const ArrayVec<T, N> &v) {
+    return Iter<Slice, T, const T *, const T *>(v.begin(), v.end());
+}
+template <typename T, size_t N>
+Iter<Slice, T, T *, T *> iter_ref(ArrayVec<T, N> &v) {
+    return Iter<Slice, T, T *, T *>(v.begin(), v.end());
+}
+template <typename T, size_t N>
+Iter<Slice, T, const T *, const T *> iter_ref(const SmallVec<T, N> &v) {
+    return Iter<Slice, T, const T *, const T *>(v.begin(), v.end());
+}
+template <typename T, size_t N>
+Iter<Slice, T, T *, T *> iter_ref(SmallVec<T, N> &v) {
+    return Iter<Slice, T, T *, T *>(v.begin(), v.end());
+}
+
+template <typename T, size_t N>
+struct TriviallyRelocatable<ArrayVec<T, N>> : TriviallyRelocatable<T> {};
+template <typename T, size_t N>
+struct TriviallyRelocatable<SmallVec<T, N>> : TriviallyRelocatable<T> {};
+
+template <typename T, typename Self>
+struct fmt::Display<__InlineVecBase<T, Self>> {
+    static void fmt(const __InlineVecBase<T, Self> &v, std::ostream &o) {
+        o << "[";
+        for (const T &x : v) {
+            if (&x != v.begin()) {
+                o << ", ";
+            }
+            fmt::display(o, x);
+        }
+        o << "]";
+    }
+};
+template <typename T, size_t N>
+struct fmt::Display<ArrayVec<T, N>> : fmt::Display<__InlineVecBase<T, ArrayVec<T, N>>> {};
+template <typename T, size_t N>
+struct fmt::Display<SmallVec<T, N>> : fmt::Display<__InlineVecBase<T, SmallVec<T, N>>> {};
+
+} // namespace rstd
@@ -1,5 +1,9 @@
 #include <rtest.hpp>
 
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "thread.hpp"
 
 using namespace rstd;
@@ -32,4 +36,136 @@ rtest_module_(thread) {
         assert_(res.is_err());
         res.clear();
     }
+    rtest_(name) {
+        auto jh = thread::Builder().name("worker").spawn([]() {
+            assert_eq_(thread::current().name, std::string("worker"));
+            assert_(!thread::current().is_main);
+        });
+        jh.join().unwrap();
+        assert_(thread::Builder().spawn([]() {
+            return thread::current().name.empty();
+        }).join().unwrap());
+    }
+    rtest_(id) {
+        uint64_t parent = thread::current().id;
+        uint64_t a = thread::spawn([]() { return thread::current().id; }).join().unwrap();
+        uint64_t b = thread::spawn([]() { return thread::current().id; }).join().unwrap();
+        assert_(a != parent);
+        assert_(b != parent);
+        assert_(a != b);
+    }
+    rtest_(named_panic) {
+        std::stringstream output;
+        auto res = thread::Builder().name("crasher").stderr_(output).spawn([]() {
+            panic_("Panic!");
+        }).join();
+        assert_(res.is_err());
+        res.clear();
+        assert_(output.str().find("'crasher'") != std::string::npos);
+    }
+    rtest_(stack_size) {
+        auto jh = thread::Builder().stack_size(64*1024).spawn([]() {
+            volatile char buf[16*1024];
+            buf[0] = 1;
+            buf[sizeof(buf) - 1] = 2;
+            return buf[0] + buf[sizeof(buf) - 1];
+        });
+        assert_eq_(jh.join().unwrap(), 3);
+    }
+    rtest_(park_unpark) {
+        // Unpark before park makes park return immediately
+        thread::current().unpark();
+        thread::park();
+
+        Thread main = thread::current();
+        std::atomic<bool> flag(false);
+        auto jh = thread::spawn([&]() {
+            flag.store(true);
+            main.unpark();
+        });
+        while (!flag.load()) {
+            thread::park();
+        }
+        jh.join().unwrap();
+    }
+    rtest_(join_with_stats) {
+        auto joined = thread::spawn([]() {
+            // Burn some CPU time and then sleep
+            volatile uint64_t x = 0;
+            for (uint64_t i = 0; i < 10000000; ++i) {
+                x = x + i;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            auto stats = thread::current().stats();
+            assert_(stats.wall_time_ns >= uint64_t(20000000));
+            return x > 0;
+        }).join_with_stats();
+        assert_(joined.get<0>().unwrap());
+        const ThreadStats &stats = joined.get<1>();
+        assert_(stats.wall_time_ns >= uint64_t(20000000));
+        assert_(stats.cpu_time_ns() > 0);
+        assert_(stats.cpu_time_ns() < stats.wall_time_ns);
+#ifdef __linux__
+        // Sleep causes at least one voluntary context switch
+        assert_(stats.voluntary_switches > 0);
+#endif // __linux__
+    }
+    rtest_(stats_after_panic) {
+        auto joined = thread::spawn([]() {
+            panic_("Panic!");
+        }).join_with_stats();
+        assert_(joined.get<0>().is_err());
+        joined.get<0>().clear();
+        assert_(joined.get<1>().wall_time_ns > 0);
+    }
+    rtest_(join_timeout) {
+        std::atomic<bool> stop(false);
+        auto jh = thread::spawn([&stop]() {
+            while (!stop.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return 42;
+        });
+        auto res = jh.join_timeout(time::Duration::from_millis(10));
+        assert_(res.is_err());
+        res.clear();
+        assert_(!jh.is_finished());
+
+        stop.store(true);
+        assert_eq_(jh.join_timeout(time::Duration::from_secs(10)).unwrap().unwrap(), 42);
+
+        // Deadline saturates instead of overflowing
+        auto slow = thread::spawn([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return 1;
+        });
+        assert_eq_(slow.join_timeout(time::Duration::max()).unwrap().unwrap(), 1);
+    }
+#ifdef __linux__
+    rtest_(affinity) {
+        // CPU 0 may be unavailable to the test process, so take the last allowed one
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        assert_eq_(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+        int cpu = -1;
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &allowed)) {
+                cpu = i;
+            }
+        }
+        assert_(cpu >= 0);
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        auto jh = thread::Builder().affinity(cpus).spawn([]() {
+            cpu_set_t own;
+            CPU_ZERO(&own);
+            assert_eq_(sched_getaffinity(0, sizeof(own), &own), 0);
+            assert_eq_(CPU_COUNT(&own), 1);
+            return sched_getcpu();
+        });
+        assert_eq_(jh.join().unwrap(), cpu);
+    }
+#endif // __linux__
 }
@@ -1,10 +1,18 @@
 #pragma once
 
 #include <pthread.h>
+#include <limits.h>
+#ifdef __linux__
+#include <sched.h>
+#endif // __linux__
+#include <string>
 #include <functional>
 #include <type_traits>
+#include <atomic>
 #include <rcore/thread.hpp>
+#include <rcore/futex.hpp>
 #include "prelude.hpp"
+#include "time.hpp"
 
 
 namespace rstd {
@@ -18,16 +26,27 @@ class Builder;
 
 } // namespace thread
 
+// State shared between the thread and its `JoinHandle`
+struct __ThreadState {
+    rcore::ThreadStats stats;
+    // Set to 1 when the thread is about to exit
+    std::atomic<uint32_t> finished{0};
+};
+
 template <typename T=Tuple<>>
 class JoinHandle final {
 private:
     Option<pthread_t> thread_;
+    std::shared_ptr<__ThreadState> state_;
 
 public:
     JoinHandle() : thread_(Option<pthread_t>::None()) {}
 
 private:
-    explicit JoinHandle(pthread_t thread_) : thread_(Option<pthread_t>::Some(thread_)) {}
+    JoinHandle(pthread_t thread_, std::shared_ptr<__ThreadState> state) :
+        thread_(Option<pthread_t>::Some(thread_)),
+        state_(std::move(state))
+    {}
 
 public:
     JoinHandle(const JoinHandle &) = delete;
@@ -37,6 +56,7 @@ public:
     JoinHandle &operator=(JoinHandle &&other) {
         assert_(thread_.is_none());
         thread_ = std::move(other.thread_);
+        state_ = std::move(other.state_);
         return *this;
     }
 
@@ -51,6 +71,30 @@ public:
             return Result<T>::Err(Tuple<>());
         }
     }
+    // Also returns resources consumed by the thread during its whole lifetime,
+    // they are collected even if the thread has panicked.
+    Tuple<Result<T>, ThreadStats> join_with_stats() {
+        Result<T> res = join();
+        return Tuple<Result<T>, ThreadStats>(std::move(res), ThreadStats(state_->stats));
+    }
+    // Joins the thread if it finishes before `timeout` expires.
+    // Otherwise returns `Err` and the handle remains joinable.
+    Result<Result<T>, time::TimedOut> join_timeout(const time::Duration &timeout) {
+        assert_(thread_.is_some());
+        time::Instant deadline = time::Instant::now().saturating_add(timeout);
+        while (!is_finished()) {
+            time::Duration remaining = deadline.duration_since(time::Instant::now());
+            if (remaining.is_zero()) {
+                return Result<Result<T>, time::TimedOut>::Err(time::TimedOut());
+            }
+            rcore::futex::wait_for(&state_->finished, 0, remaining.__saturating_as_nanos());
+        }
+        return Result<Result<T>, time::TimedOut>::Ok(join());
+    }
+    // Returns `true` if the thread has finished running its function, so `join` won't block for long
+    bool is_finished() const {
+        return state_->finished.load(std::memory_order_acquire) != 0;
+    }
 
     ~JoinHandle() {
         if (thread_.is_some()) {
@@ -70,11 +114,47 @@ namespace thread {
 class Builder final {
 private:
     rcore::Thread info;
+    // Zero means the default stack size of the platform
+    size_t stack_size_ = 0;
+#ifdef __linux__
+    Option<cpu_set_t> affinity_;
+#endif // __linux__
 
 public:
     Builder() : info(rcore::thread::current()) {
         info.is_main = false;
+        info.name.clear();
+    }
+
+    void set_name(const std::string &name) {
+        this->info.name = name;
+    }
+    Builder name(const std::string &name) {
+        Builder self = std::move(*this);
+        self.set_name(name);
+        return self;
+    }
+
+    void set_stack_size(size_t size) {
+        assert_(size >= size_t(PTHREAD_STACK_MIN));
+        this->stack_size_ = size;
     }
+    Builder stack_size(size_t size) {
+        Builder self = std::move(*this);
+        self.set_stack_size(size);
+        return self;
+    }
+
+#ifdef __linux__
+    void set_affinity(const cpu_set_t &cpu_set) {
+        this->affinity_ = Option<cpu_set_t>::Some(cpu_set);
+    }
+    Builder affinity(const cpu_set_t &cpu_set) {
+        Builder self = std::move(*this);
+        self.set_affinity(cpu_set);
+        return self;
+    }
+#endif // __linux__
     
     void set_stdin(std::istream &stream) {
         this->info.stdio.in = &stream;
@@ -115,19 +195,30 @@ private:
     struct Arg {
         rcore::Thread info;
         F main;
+        std::shared_ptr<__ThreadState> state;
     };
 
-    template <typename T>
-    static void __delete(void *obj) {
-        delete (T*)obj;
+    // Records thread stats, notifies the handle and deletes the argument
+    template <typename F, typename T>
+    static void __finish(void *obj) {
+        Arg<F, T> *arg = (Arg<F, T> *)obj;
+        arg->state->stats = rcore::thread::current().stats();
+        arg->state->finished.store(1, std::memory_order_release);
+        rcore::futex::wake_all(&arg->state->finished);
+        delete arg;
     }
     template <typename F, typename T>
     static void *__call(void *a) {
         Arg<F, T> *arg = (Arg<F, T> *)a;
         T *ret = nullptr;
         rcore::thread::current() = arg->info;
+        if (!arg->info.name.empty()) {
+            // Linux limits thread names to 15 characters
+            std::string short_name = arg->info.name.substr(0, 15);
+            pthread_setname_np(pthread_self(), short_name.c_str());
+        }
 
-        pthread_cleanup_push((__delete<Arg<F, T>>), (void*)arg);
+        pthread_cleanup_push((__finish<F, T>), (void*)arg);
         ret = new T((arg->main)());
         pthread_cleanup_pop(1);
 
@@ -142,19 +233,38 @@ public:
     >
     JoinHandle<T> spawn(F main) const {
         pthread_t thread_;
+        auto state = std::make_shared<__ThreadState>();
         Arg<F, T> *arg = new Arg<F, T>{
             info,
-            std::move(main)
+            std::move(main),
+            state
         };
+        arg->info.id = rcore::thread::__next_id();
+        arg->info.parker = std::make_shared<rcore::Parker>();
+        arg->info.start_time_ns = rcore::thread::__now_ns();
+
+        pthread_attr_t attr;
+        assert_(pthread_attr_init(&attr) == 0);
+        if (stack_size_ > 0) {
+            assert_(pthread_attr_setstacksize(&attr, stack_size_) == 0);
+        }
+#ifdef __linux__
+        if (affinity_.is_some()) {
+            assert_(pthread_attr_setaffinity_np(
+                &attr, sizeof(cpu_set_t), &affinity_.get()
+            ) == 0);
+        }
+#endif // __linux__
 
         assert_(pthread_create(
             &thread_,
-            nullptr,
+            &attr,
             (__call<F, T>),
             (void*)arg
         ) == 0);
+        assert_(pthread_attr_destroy(&attr) == 0);
 
-        return JoinHandle<T>(thread_);
+        return JoinHandle<T>(thread_, std::move(state));
     }
 
     template <
@@ -0,0 +1,174 @@
+#include <rtest.hpp>
+
+#include <chrono>
+#include <thread>
+#include "time.hpp"
+
+using namespace rstd;
+using namespace rstd::time;
+
+
+rtest_module_(time) {
+    rtest_(duration_units) {
+        assert_eq_(Duration::from_secs(3).as_millis(), uint64_t(3000));
+        assert_eq_(Duration::from_millis(1500).as_secs(), uint64_t(1));
+        assert_eq_(Duration::from_millis(1500).subsec_nanos(), uint32_t(500000000));
+        assert_eq_(Duration::from_micros(2500).as_micros(), uint64_t(2500));
+        assert_eq_(Duration::from_nanos(1234567890).as_nanos(), uint64_t(1234567890));
+        assert_(Duration(0, 2000000000) == Duration::from_secs(2));
+        assert_(Duration::zero().is_zero());
+    }
+    rtest_(duration_arithmetic) {
+        Duration a = Duration::from_millis(1700);
+        Duration b = Duration::from_millis(800);
+        assert_eq_((a + b).as_millis(), uint64_t(2500));
+        assert_eq_((a - b).as_millis(), uint64_t(900));
+        assert_(b < a);
+        assert_(a >= b);
+        assert_(a != b);
+    }
+    rtest_should_panic_(duration_underflow) {
+        Duration a = Duration::from_secs(1) - Duration::from_secs(2);
+        (void)a;
+    }
+    rtest_(instant) {
+        Instant a = Instant::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Instant b = Instant::now();
+        assert_(b > a);
+        assert_((b - a).as_millis() >= 10);
+        assert_(a.duration_since(b).is_zero());
+        assert_(a + (b - a) == b);
+        assert_(a.elapsed() >= b - a);
+    }
+    rtest_(checked_saturating) {
+        assert_(Duration::max().checked_add(Duration::from_nanos(1)).is_none());
+        assert_(Duration::from_secs(1).checked_sub(Duration::from_secs(2)).is_none());
+        assert_(Duration::max().saturating_add(Duration::from_secs(1)) == Duration::max());
+        assert_(Duration::from_secs(1).saturating_sub(Duration::from_secs(2)).is_zero());
+        assert_(Duration::max().checked_mul(2).is_none());
+        assert_(Duration::from_millis(1500) * 3 == Duration::from_millis(4500));
+        assert_(Duration::from_secs(1) / 3 == Duration::from_nanos(333333333));
+        assert_(Duration::from_secs(1).checked_div(0).is_none());
+        assert_eq_(Duration::from_secs_f64(2.5).as_millis(), uint64_t(2500));
+        assert_eq_(Duration::from_millis(250).as_secs_f64(), 0.25);
+
+        Instant now = Instant::now();
+        assert_(now.checked_add(Duration::max()).is_none());
+        assert_(now.saturating_add(Duration::max()) > now + Duration::from_secs(1000000000));
+        assert_(now.saturating_add(Duration::from_secs(1)) == now + Duration::from_secs(1));
+        assert_eq_(Duration::max().__saturating_as_nanos(), UINT64_MAX);
+        assert_eq_(Duration::from_secs(3).__saturating_as_nanos(), uint64_t(3000000000));
+        assert_(now.checked_duration_since(now + Duration::from_secs(1)).is_none());
+
+        // Deadlines of timed waits are on the monotonic clock
+        timespec mono;
+        assert_(clock_gettime(CLOCK_MONOTONIC, &mono) == 0);
+        timespec ts = now.__as_monotonic();
+        assert_(ts.tv_sec <= mono.tv_sec && ts.tv_sec + 1 >= mono.tv_sec);
+    }
+    rtest_(display) {
+        assert_eq_(format_("{}", Duration::from_millis(1500)), "1.5s");
+        assert_eq_(format_("{}", Duration::from_secs(2)), "2s");
+        assert_eq_(format_("{}", Duration::from_millis(20)), "20ms");
+        assert_eq_(format_("{}", Duration::from_nanos(3250)), "3.25µs");
+        assert_eq_(format_("{}", Duration::from_nanos(1000000001)), "1.000000001s");
+        assert_eq_(format_("{}", Duration::from_nanos(7)), "7ns");
+        assert_eq_(format_("{}", Duration::zero()), "0ns");
+    }
+    rtest_(system_time) {
+        SystemTime now = SystemTime::now();
+        // Later than 2020-01-01
+        assert_(now.duration_since(SystemTime::unix_epoch()).unwrap() > Duration::from_secs(1577836800));
+        SystemTime later = now + Duration::from_secs(10);
+        assert_(later > now);
+        assert_(later.duration_since(now).unwrap() == Duration::from_secs(10));
+        assert_(now.duration_since(later).unwrap_err() == Duration::from_secs(10));
+        assert_(SystemTime::unix_epoch().checked_sub(Duration::from_nanos(1)).is_none());
+    }
+    rtest_(fast_clock_drift) {
+        FastClock::calibrate();
+        Instant i0 = Instant::now();
+        Instant f0 = FastClock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        Instant i1 = Instant::now();
+        Instant f1 = FastClock::now();
+
+        // Both clocks share the same scale
+        Duration offset = f0 > i0 ? f0 - i0 : i0 - f0;
+        Duration real = i1 - i0;
+        Duration fast = f1 - f0;
+        Duration drift = fast > real ? fast - real : real - fast;
+        println_("offset: {}, drift over {}: {}", offset, real, drift);
+        assert_(offset < Duration::from_millis(1));
+        // Less than 1%
+        assert_(drift * 100 < real);
+    }
+    rtest_(counter_before_calibration) {
+        rcore::clock::Calibration c;
+        c.hardware = true;
+        c.base_counter = 1000000;
+        c.base_ns = 5000000000;
+        // Half a nanosecond per tick
+        c.mult = uint64_t(1) << 31;
+        assert_eq_(rcore::clock::counter_to_ns(c, 1000000), uint64_t(5000000000));
+        assert_eq_(rcore::clock::counter_to_ns(c, 1002000), uint64_t(5000001000));
+        assert_eq_(rcore::clock::counter_to_ns(c, 998000), uint64_t(4999999000));
+        assert_eq_(rcore::clock::counter_to_ns(c, 0), uint64_t(4999500000));
+
+        // Ticks taken before the calibration base are earlier than it
+        const auto &real = rcore::clock::calibration();
+        if (real.hardware) {
+            Instant base = FastClock::ticks_to_instant(real.base_counter);
+            Instant before = FastClock::ticks_to_instant(real.base_counter - 1000000);
+            assert_(before < base);
+            assert_(base - before < Duration::from_secs(1));
+        }
+    }
+    rtest_(fast_clock_ticks) {
+        // Ticks keep the time they were taken at, with or without the hardware counter
+        uint64_t t0 = FastClock::ticks();
+        Instant i0 = Instant::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t t1 = FastClock::ticks();
+        Instant i1 = Instant::now();
+
+        Instant f0 = FastClock::ticks_to_instant(t0);
+        Instant f1 = FastClock::ticks_to_instant(t1);
+        assert_(f0 < f1);
+        assert_(f1 - f0 >= Duration::from_millis(19));
+        assert_(f0 < i0 + Duration::from_millis(1));
+        assert_(i0 < f0 + Duration::from_millis(1));
+        assert_(f1 < i1 + Duration::from_millis(1));
+        // Conversion is deferred, the instant doesn't move
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert_(FastClock::ticks_to_instant(t0) == f0);
+    }
+    rtest_(fast_clock_overhead) {
+        const uint32_t n = 100000;
+        FastClock::calibrate();
+        volatile uint64_t sink = 0;
+
+        Instant start = Instant::now();
+        for (uint32_t i = 0; i < n; ++i) {
+            sink = sink + FastClock::now_ns();
+        }
+        Duration fast = Instant::now() - start;
+
+        start = Instant::now();
+        for (uint32_t i = 0; i < n; ++i) {
+            sink = sink + Instant::now().elapsed().subsec_nanos();
+        }
+        Duration mono = (Instant::now() - start) / 2;
+
+        println_("hardware: {}, fast clock: {}/call, monotonic clock: {}/call", FastClock::is_hardware(), fast / n, mono / n);
+        assert_(fast / n < Duration::from_micros(1));
+        // Timestamps never go backwards
+        uint64_t prev = FastClock::now_ns();
+        for (uint32_t i = 0; i < n; ++i) {
+            uint64_t t = FastClock::now_ns();
+            assert_(t >= prev);
+            prev = t;
+        }
+    }
+}
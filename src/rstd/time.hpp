@@ -0,0 +1,458 @@
+#pragma once
+
+#include <time.h>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <rcore/clock.hpp>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+namespace time {
+
+// Span of time with nanosecond precision.
+class Duration final {
+private:
+    static const uint32_t NANOS_PER_SEC = 1000000000;
+
+    uint64_t secs = 0;
+    // Always less than `NANOS_PER_SEC`
+    uint32_t nanos = 0;
+
+public:
+    Duration() = default;
+    Duration(uint64_t secs, uint32_t nanos) :
+        secs(secs + nanos / NANOS_PER_SEC),
+        nanos(nanos % NANOS_PER_SEC)
+    {}
+
+    static Duration zero() {
+        return Duration();
+    }
+    static Duration max() {
+        return Duration(std::numeric_limits<uint64_t>::max(), NANOS_PER_SEC - 1);
+    }
+    static Duration from_secs(uint64_t s) {
+        return Duration(s, 0);
+    }
+    static Duration from_millis(uint64_t ms) {
+        return Duration(ms / 1000, uint32_t(ms % 1000) * 1000000);
+    }
+    static Duration from_micros(uint64_t us) {
+        return Duration(us / 1000000, uint32_t(us % 1000000) * 1000);
+    }
+    static Duration from_nanos(uint64_t ns) {
+        return Duration(ns / NANOS_PER_SEC, uint32_t(ns % NANOS_PER_SEC));
+    }
+    // Panics if `s` is negative or not finite
+    static Duration from_secs_f64(double s) {
+        assert_(s >= 0.0 && s < 18446744073709551616.0);
+        uint64_t whole = uint64_t(s);
+        return Duration(whole, uint32_t((s - double(whole)) * NANOS_PER_SEC));
+    }
+
+    uint64_t as_secs() const {
+        return secs;
+    }
+    uint32_t subsec_nanos() const {
+        return nanos;
+    }
+    uint64_t as_millis() const {
+        return secs * 1000 + nanos / 1000000;
+    }
+    uint64_t as_micros() const {
+        return secs * 1000000 + nanos / 1000;
+    }
+    // Overflows for durations longer than 584 years
+    uint64_t as_nanos() const {
+        return secs * NANOS_PER_SEC + nanos;
+    }
+    // Same as `as_nanos` but saturates, for timeouts that may be `Duration::max()`
+    uint64_t __saturating_as_nanos() const {
+        if (secs > (std::numeric_limits<uint64_t>::max() - nanos) / NANOS_PER_SEC) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return as_nanos();
+    }
+    double as_secs_f64() const {
+        return double(secs) + double(nanos) / NANOS_PER_SEC;
+    }
+
+    bool is_zero() const {
+        return secs == 0 && nanos == 0;
+    }
+
+    // Returns `None` on overflow
+    Option<Duration> checked_add(const Duration &other) const {
+        uint64_t s = secs + other.secs;
+        if (s < secs) {
+            return None();
+        }
+        uint32_t n = nanos + other.nanos;
+        if (n >= NANOS_PER_SEC) {
+            n -= NANOS_PER_SEC;
+            if (s + 1 == 0) {
+                return None();
+            }
+            s += 1;
+        }
+        return Some(Duration(s, n));
+    }
+    // Returns `None` if `other` is greater than `self`
+    Option<Duration> checked_sub(const Duration &other) const {
+        if (*this < other) {
+            return None();
+        }
+        if (nanos >= other.nanos) {
+            return Some(Duration(secs - other.secs, nanos - other.nanos));
+        } else {
+            return Some(Duration(secs - other.secs - 1, nanos + NANOS_PER_SEC - other.nanos));
+        }
+    }
+    Option<Duration> checked_mul(uint32_t k) const {
+        uint64_t total_nanos = uint64_t(nanos) * k;
+        uint64_t extra_secs = total_nanos / NANOS_PER_SEC;
+        uint64_t s = 0;
+        if (__builtin_mul_overflow(secs, uint64_t(k), &s) || __builtin_add_overflow(s, extra_secs, &s)) {
+            return None();
+        }
+        return Some(Duration(s, uint32_t(total_nanos % NANOS_PER_SEC)));
+    }
+    // Returns `None` if `k` is zero
+    Option<Duration> checked_div(uint32_t k) const {
+        if (k == 0) {
+            return None();
+        }
+        uint64_t s = secs / k;
+        uint64_t carry = secs % k;
+        uint64_t n = (carry * NANOS_PER_SEC + nanos) / k;
+        return Some(Duration(s, uint32_t(n)));
+    }
+
+    Duration saturating_add(const Duration &other) const {
+        return checked_add(other).unwrap_or(Duration::max());
+    }
+    Duration saturating_sub(const Duration &other) const {
+        return checked_sub(other).unwrap_or(Duration::zero());
+    }
+    Duration saturating_mul(uint32_t k) const {
+        return checked_mul(k).unwrap_or(Duration::max());
+    }
+
+    // Panics on overflow
+    Duration operator+(const Duration &other) const {
+        return checked_add(other).expect("Duration overflow");
+    }
+    // Panics if `other` is greater than `self`
+    Duration operator-(const Duration &other) const {
+        return checked_sub(other).expect("Duration underflow");
+    }
+    Duration operator*(uint32_t k) const {
+        return checked_mul(k).expect("Duration overflow");
+    }
+    Duration operator/(uint32_t k) const {
+        return checked_div(k).expect("Duration division by zero");
+    }
+    Duration &operator+=(const Duration &other) {
+        return *this = *this + other;
+    }
+    Duration &operator-=(const Duration &other) {
+        return *this = *this - other;
+    }
+    Duration &operator*=(uint32_t k) {
+        return *this = *this * k;
+    }
+    Duration &operator/=(uint32_t k) {
+        return *this = *this / k;
+    }
+
+    bool operator==(const Duration &other) const {
+        return secs == other.secs && nanos == other.nanos;
+    }
+    bool operator!=(const Duration &other) const {
+        return !(*this == other);
+    }
+    bool operator<(const Duration &other) const {
+        return secs < other.secs || (secs == other.secs && nanos < other.nanos);
+    }
+    bool operator>(const Duration &other) const {
+        return other < *this;
+    }
+    bool operator<=(const Duration &other) const {
+        return !(other < *this);
+    }
+    bool operator>=(const Duration &other) const {
+        return !(*this < other);
+    }
+
+    // Seconds are clamped to the range of `time_t`
+    timespec __as_timespec() const {
+        timespec ts;
+        ts.tv_sec = time_t(std::min(secs, uint64_t(std::numeric_limits<time_t>::max())));
+        ts.tv_nsec = long(nanos);
+        return ts;
+    }
+    static Duration __from_timespec(const timespec &ts) {
+        return Duration(uint64_t(ts.tv_sec), uint32_t(ts.tv_nsec));
+    }
+};
+
+// Point of monotonic clock. Suitable for measuring time intervals and deadlines.
+class Instant final {
+private:
+    // Since unspecified starting point
+    Duration since_start;
+
+    explicit Instant(Duration d) : since_start(d) {}
+
+    friend class FastClock;
+
+public:
+    static Instant now() {
+        timespec ts;
+        assert_(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+        return Instant(Duration::__from_timespec(ts));
+    }
+
+    // Returns `None` if `earlier` is later than `self`
+    Option<Duration> checked_duration_since(const Instant &earlier) const {
+        return since_start.checked_sub(earlier.since_start);
+    }
+    // Returns zero if `earlier` is later than `self`
+    Duration duration_since(const Instant &earlier) const {
+        if (since_start >= earlier.since_start) {
+            return since_start - earlier.since_start;
+        } else {
+            return Duration::zero();
+        }
+    }
+    Duration elapsed() const {
+        return Instant::now().duration_since(*this);
+    }
+
+    Option<Instant> checked_add(const Duration &d) const {
+        return since_start.checked_add(d).map([](Duration x) { return Instant(x); });
+    }
+    Option<Instant> checked_sub(const Duration &d) const {
+        return since_start.checked_sub(d).map([](Duration x) { return Instant(x); });
+    }
+    // Deadline `d` after the instant, the latest representable one if it overflows
+    Instant saturating_add(const Duration &d) const {
+        return Instant(since_start.saturating_add(d));
+    }
+
+    Instant operator+(const Duration &d) const {
+        return Instant(since_start + d);
+    }
+    Instant operator-(const Duration &d) const {
+        return Instant(since_start - d);
+    }
+    Duration operator-(const Instant &other) const {
+        return duration_since(other);
+    }
+    Instant &operator+=(const Duration &d) {
+        return *this = *this + d;
+    }
+    Instant &operator-=(const Duration &d) {
+        return *this = *this - d;
+    }
+
+    bool operator==(const Instant &other) const {
+        return since_start == other.since_start;
+    }
+    bool operator!=(const Instant &other) const {
+        return since_start != other.since_start;
+    }
+    bool operator<(const Instant &other) const {
+        return since_start < other.since_start;
+    }
+    bool operator>(const Instant &other) const {
+        return since_start > other.since_start;
+    }
+    bool operator<=(const Instant &other) const {
+        return since_start <= other.since_start;
+    }
+    bool operator>=(const Instant &other) const {
+        return since_start >= other.since_start;
+    }
+
+    // Absolute `CLOCK_MONOTONIC` time of the instant
+    timespec __as_monotonic() const {
+        return since_start.__as_timespec();
+    }
+    // Converts the instant into absolute `CLOCK_REALTIME` time for POSIX timed waits.
+    // The result is wrong if the wall clock is changed before the wait ends.
+    timespec __as_realtime() const {
+        timespec ts;
+        assert_(clock_gettime(CLOCK_REALTIME, &ts) == 0);
+        return Duration::__from_timespec(ts).saturating_add(duration_since(Instant::now())).__as_timespec();
+    }
+};
+
+// Point of system (wall clock) time. Unlike `Instant` it isn't monotonic.
+class SystemTime final {
+private:
+    // Since the Unix epoch
+    Duration since_epoch;
+
+    explicit SystemTime(Duration d) : since_epoch(d) {}
+
+public:
+    static SystemTime unix_epoch() {
+        return SystemTime(Duration::zero());
+    }
+    static SystemTime now() {
+        timespec ts;
+        assert_(clock_gettime(CLOCK_REALTIME, &ts) == 0);
+        return SystemTime(Duration::__from_timespec(ts));
+    }
+
+    // Returns `Err` with the difference if `earlier` is actually later than `self`
+    Result<Duration, Duration> duration_since(const SystemTime &earlier) const {
+        if (since_epoch >= earlier.since_epoch) {
+            return Result<Duration, Duration>::Ok(since_epoch - earlier.since_epoch);
+        } else {
+            return Result<Duration, Duration>::Err(earlier.since_epoch - since_epoch);
+        }
+    }
+    // May return `Err` if the system clock has been adjusted backwards
+    Result<Duration, Duration> elapsed() const {
+        return SystemTime::now().duration_since(*this);
+    }
+
+    Option<SystemTime> checked_add(const Duration &d) const {
+        return since_epoch.checked_add(d).map([](Duration x) { return SystemTime(x); });
+    }
+    Option<SystemTime> checked_sub(const Duration &d) const {
+        return since_epoch.checked_sub(d).map([](Duration x) { return SystemTime(x); });
+    }
+    SystemTime operator+(const Duration &d) const {
+        return SystemTime(since_epoch + d);
+    }
+    SystemTime operator-(const Duration &d) const {
+        return SystemTime(since_epoch - d);
+    }
+
+    bool operator==(const SystemTime &other) const {
+        return since_epoch == other.since_epoch;
+    }
+    bool operator!=(const SystemTime &other) const {
+        return since_epoch != other.since_epoch;
+    }
+    bool operator<(const SystemTime &other) const {
+        return since_epoch < other.since_epoch;
+    }
+    bool operator>(const SystemTime &other) const {
+        return since_epoch > other.since_epoch;
+    }
+    bool operator<=(const SystemTime &other) const {
+        return since_epoch <= other.since_epoch;
+    }
+    bool operator>=(const SystemTime &other) const {
+        return since_epoch >= other.since_epoch;
+    }
+};
+
+// Clock that reads the CPU cycle counter (TSC on x86) and converts it into `CLOCK_MONOTONIC` time,
+// so its timestamps are comparable with `Instant::now()`.
+// Costs a few nanoseconds per call instead of a `clock_gettime` call.
+// The counter is calibrated once on the first use by measuring it against `CLOCK_MONOTONIC`
+// over about 10 ms. The rate is never corrected afterwards, so the clock slowly drifts away
+// from `Instant::now()` at the rate of the calibration error.
+// If there is no constant-rate counter the clock falls back to `CLOCK_MONOTONIC`.
+class FastClock final {
+public:
+    // Performs calibration in advance to avoid a delay on the first timestamp
+    static void calibrate() {
+        rcore::clock::calibration();
+    }
+    // `true` if the hardware counter is used
+    static bool is_hardware() {
+        return rcore::clock::calibration().hardware;
+    }
+
+    // Raw counter value, can be converted later with `ticks_to_instant`.
+    // Without the hardware counter these are `CLOCK_MONOTONIC` nanoseconds.
+    static uint64_t ticks() {
+        if (rcore::clock::calibration().hardware) {
+            return rcore::clock::read_counter();
+        } else {
+            return rcore::clock::monotonic_ns();
+        }
+    }
+    static Instant ticks_to_instant(uint64_t ticks) {
+        const auto &c = rcore::clock::calibration();
+        if (c.hardware) {
+            return Instant(Duration::from_nanos(rcore::clock::counter_to_ns(c, ticks)));
+        } else {
+            return Instant(Duration::from_nanos(ticks));
+        }
+    }
+
+    // Monotonic time in nanoseconds
+    static uint64_t now_ns() {
+        return rcore::clock::now_ns();
+    }
+    static Instant now() {
+        return Instant(Duration::from_nanos(now_ns()));
+    }
+};
+
+// Error returned from waits that have expired
+struct TimedOut {};
+
+} // namespace time
+
+// Formats like `1.5s`, `20ms`, `3.25µs` or `7ns`
+template <>
+struct fmt::Display<time::Duration> {
+    static void fmt(const time::Duration &d, std::ostream &o) {
+        uint64_t integer;
+        uint64_t fraction;
+        int digits;
+        const char *unit;
+        if (d.as_secs() > 0) {
+            integer = d.as_secs();
+            fraction = d.subsec_nanos();
+            digits = 9;
+            unit = "s";
+        } else if (d.subsec_nanos() >= 1000000) {
+            integer = d.subsec_nanos() / 1000000;
+            fraction = d.subsec_nanos() % 1000000;
+            digits = 6;
+            unit = "ms";
+        } else if (d.subsec_nanos() >= 1000) {
+            integer = d.subsec_nanos() / 1000;
+            fraction = d.subsec_nanos() % 1000;
+            digits = 3;
+            unit = "µs";
+        } else {
+            integer = d.subsec_nanos();
+            fraction = 0;
+            digits = 0;
+            unit = "ns";
+        }
+        o << integer;
+        // Trim trailing zeros of the fraction
+        while (digits > 0 && fraction % 10 == 0) {
+            fraction /= 10;
+            digits -= 1;
+        }
+        if (digits > 0) {
+            std::string f = std::to_string(fraction);
+            o << "." << std::string(digits - f.size(), '0') << f;
+        }
+        o << unit;
+    }
+};
+
+template <>
+struct fmt::Display<time::TimedOut> {
+    static void fmt(const time::TimedOut &, std::ostream &o) {
+        o << "TimedOut";
+    }
+};
+
+} // namespace rstd
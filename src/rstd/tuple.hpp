@@ -219,4 +219,8 @@ public:
     }
 };
 
+template <typename ...Elems>
+struct TriviallyRelocatable<Tuple<Elems...>> :
+    std::bool_constant<all_v<is_trivially_relocatable_v<Elems>...>> {};
+
 } // namespace rstd
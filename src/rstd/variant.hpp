@@ -357,4 +357,8 @@ public:
     }
 };
 
+template <typename ...Elems>
+struct TriviallyRelocatable<Variant<Elems...>> :
+    std::bool_constant<all_v<is_trivially_relocatable_v<Elems>...>> {};
+
 } // namespace rstd
@@ -0,0 +1,218 @@
+#include <rtest.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "vec.hpp"
+
+using namespace rstd;
+
+
+// Counts live instances to check that every element is dropped exactly once
+struct Counted {
+    static int live;
+    int value = 0;
+    Counted() { live += 1; }
+    explicit Counted(int v) : value(v) { live += 1; }
+    Counted(const Counted &other) : value(other.value) { live += 1; }
+    Counted(Counted &&other) : value(other.value) { live += 1; }
+    Counted &operator=(const Counted &) = default;
+    Counted &operator=(Counted &&) = default;
+    ~Counted() { live -= 1; }
+    bool operator==(const Counted &other) const { return value == other.value; }
+};
+int Counted::live = 0;
+
+struct alignas(64) Aligned {
+    int value = 0;
+};
+
+rtest_module_(vec) {
+    rtest_(push_pop) {
+        Vec<int> v;
+        assert_(v.is_empty());
+        for (int i = 0; i < 100; ++i) {
+            v.push(i);
+        }
+        assert_eq_(v.len(), size_t(100));
+        assert_(v.capacity() >= 100);
+        assert_eq_(v[42], 42);
+        assert_eq_(*v.get(99).unwrap(), 99);
+        assert_(v.get(100).is_none());
+        assert_eq_(v.pop().unwrap(), 99);
+        assert_eq_(v.len(), size_t(99));
+        Vec<int>().pop().unwrap_none();
+    }
+    rtest_(try_reserve) {
+        Vec<int> v;
+        v.try_reserve(10).unwrap();
+        assert_(v.capacity() >= 10);
+        v.try_push(1).unwrap();
+
+        auto overflow = v.try_reserve(SIZE_MAX);
+        assert_(overflow.is_err());
+        assert_eq_(overflow.take_err().kind, AllocError::CAPACITY_OVERFLOW);
+        auto with = Vec<int>::try_with_capacity(SIZE_MAX / 2);
+        assert_(with.is_err());
+        with.clear();
+        // Failed reservation keeps the contents
+        assert_eq_(v.len(), size_t(1));
+        assert_eq_(v[0], 1);
+        assert_eq_(Vec<int>::try_with_capacity(16).unwrap().capacity(), size_t(16));
+    }
+    rtest_(growth) {
+        Vec<int> d;
+        d.push(0);
+        assert_eq_(d.capacity(), size_t(4));
+        for (int i = 1; i < 5; ++i) {
+            d.push(i);
+        }
+        assert_eq_(d.capacity(), size_t(8));
+
+        Vec<int, vec::FactorGrowth<3, 2>> f = Vec<int, vec::FactorGrowth<3, 2>>::with_capacity(10);
+        for (int i = 0; i < 11; ++i) {
+            f.push(i);
+        }
+        assert_eq_(f.capacity(), size_t(15));
+
+        Vec<int, vec::ExactGrowth> e;
+        for (int i = 0; i < 3; ++i) {
+            e.push(i);
+            assert_eq_(e.capacity(), size_t(i + 1));
+        }
+    }
+    rtest_(shrink_to_fit) {
+        auto v = Vec<std::string>::with_capacity(100);
+        v.push(std::string("a"));
+        v.push(std::string("b"));
+        v.shrink_to_fit();
+        assert_eq_(v.capacity(), size_t(2));
+        assert_eq_(v[1], std::string("b"));
+        v.clear();
+        v.shrink_to_fit();
+        assert_eq_(v.capacity(), size_t(0));
+    }
+    rtest_(insert_remove) {
+        Vec<std::string> v = {"a", "c", "d"};
+        v.insert(1, std::string("b"));
+        v.insert(4, std::string("e"));
+        assert_eq_(v.len(), size_t(5));
+        assert_eq_(v[1], std::string("b"));
+        assert_eq_(v.remove(0), std::string("a"));
+        assert_eq_(v.swap_remove(0), std::string("b"));
+        assert_eq_(v[0], std::string("e"));
+        assert_eq_(v.len(), size_t(3));
+        v.truncate(1);
+        assert_(v == (Vec<std::string>{"e"}));
+    }
+    rtest_(extend_from_iter) {
+        Vec<int> v = {1};
+        v.extend_from_iter(Range(2, 100));
+        assert_eq_(v.len(), size_t(99));
+        assert_eq_(v.capacity(), size_t(99));
+        v.extend_from_iter(Range(10).filter([](int x) { return x % 2 == 0; }));
+        assert_eq_(v.len(), size_t(104));
+        assert_eq_(v[103], 8);
+        std::vector<int> data = {7, 8};
+        v.extend_from_slice(Slice<int>(data));
+        assert_eq_(v[105], 8);
+    }
+    rtest_(drain) {
+        Vec<std::string> v = {"a", "b", "c", "d", "e"};
+        {
+            auto d = v.drain(1, 3);
+            assert_eq_(d.len(), size_t(2));
+            assert_eq_(d.next().unwrap(), std::string("b"));
+        }
+        assert_(v == (Vec<std::string>{"a", "d", "e"}));
+        auto all = v.drain().collect<std::vector>();
+        assert_eq_(all.size(), size_t(3));
+        assert_(v.is_empty());
+    }
+    rtest_(retain_dedup) {
+        Vec<int> v;
+        v.extend_from_iter(Range(20));
+        v.retain([](const int &x) { return x % 3 == 0; });
+        assert_(v == (Vec<int>{0, 3, 6, 9, 12, 15, 18}));
+
+        Vec<int> d = {1, 1, 2, 3, 3, 3, 1, 4, 4};
+        d.dedup();
+        assert_(d == (Vec<int>{1, 2, 3, 1, 4}));
+        d.dedup_by([](const int &a, const int &b) { return b < a; });
+        assert_(d == (Vec<int>{1, 2, 3, 4}));
+    }
+    rtest_(drop_count) {
+        Counted::live = 0;
+        {
+            Vec<Counted> v;
+            for (int i = 0; i < 10; ++i) {
+                v.push(Counted(i));
+            }
+            v.retain([](const Counted &c) { return c.value % 2 == 0; });
+            assert_eq_(Counted::live, 5);
+            v.insert(0, Counted(-1));
+            v.remove(3);
+            v.drain(0, 2);
+            assert_eq_(Counted::live, 3);
+            Vec<Counted> c = v;
+            assert_eq_(Counted::live, 6);
+            auto iter = into_iter(std::move(c));
+            iter.next().unwrap();
+            auto rest = iter.collect();
+            assert_eq_(rest.len(), size_t(2));
+        }
+        assert_eq_(Counted::live, 0);
+    }
+    rtest_(collect) {
+        Vec<int> squares = Range(10).map([](int x) { return x * x; }).collect();
+        assert_eq_(squares.len(), size_t(10));
+        assert_eq_(squares[9], 81);
+        auto evens = Range(1000).filter([](int x) { return x % 2 == 0; }).collect<Vec>();
+        assert_eq_(evens.len(), size_t(500));
+        auto range = Range(300).collect();
+        assert_eq_(range[299], 299);
+
+        // Reuses the buffer of the source vector
+        const int *buffer = squares.data();
+        auto halves = into_iter(std::move(squares)).map([](int x) { return x / 2; }).collect();
+        assert_eq_(halves.data(), buffer);
+        assert_eq_(halves[9], 40);
+
+        auto rev = into_iter(std::move(halves)).rev().collect();
+        assert_eq_(rev[0], 40);
+        assert_eq_(into_iter(std::move(rev)).skip(2).sum(), 24 + 18 + 12 + 8 + 4 + 2);
+    }
+    rtest_(over_aligned) {
+        Vec<Aligned> v;
+        for (int i = 0; i < 10; ++i) {
+            v.push(Aligned{i});
+        }
+        assert_eq_(reinterpret_cast<uintptr_t>(v.data()) % 64, uintptr_t(0));
+        assert_eq_(v[9].value, 9);
+    }
+    rtest_(display) {
+        assert_eq_(format_("{}", Vec<int>{1, 2, 3}), std::string("[1, 2, 3]"));
+    }
+    rtest_(trivially_relocatable) {
+        static_assert(is_trivially_relocatable_v<int>);
+        static_assert(is_trivially_relocatable_v<Box<std::string>>);
+        static_assert(is_trivially_relocatable_v<Option<Box<int>>>);
+        static_assert(is_trivially_relocatable_v<Tuple<Box<int>, Rc<int>, Arc<int>>>);
+        static_assert(is_trivially_relocatable_v<Result<Vec<int>, AllocError>>);
+        static_assert(!is_trivially_relocatable_v<std::string>);
+        static_assert(!is_trivially_relocatable_v<Option<std::string>>);
+        static_assert(!is_trivially_relocatable_v<Counted>);
+
+        Vec<Option<Box<int>>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push(i % 3 == 0 ? Option<Box<int>>::None() : Option<Box<int>>::Some(Box<int>(i)));
+        }
+        v.insert(0, Option<Box<int>>::Some(Box<int>(-1)));
+        v.remove(1);
+        v.retain([](const Option<Box<int>> &x) { return x.is_some(); });
+        v.shrink_to_fit();
+        assert_eq_(v.len(), size_t(667));
+        assert_eq_(*v[0].get(), -1);
+        assert_eq_(*v[666].get(), 998);
+    }
+}
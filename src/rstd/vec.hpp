@@ -0,0 +1,756 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include "prelude.hpp"
+
+
+namespace rstd {
+
+// Error of fallible allocation
+struct AllocError {
+    enum Kind {
+        // Requested capacity doesn't fit in `PTRDIFF_MAX` bytes
+        CAPACITY_OVERFLOW,
+        // Allocator returned null
+        OUT_OF_MEMORY
+    } kind;
+    // Requested size in bytes, zero on capacity overflow
+    size_t size = 0;
+
+    AllocError() = delete;
+    explicit AllocError(Kind k, size_t s=0) : kind(k), size(s) {}
+};
+
+namespace vec {
+
+// Growth policies compute new capacity from the current one and the required length.
+// The result must be at least `required`.
+
+// Doubles the capacity starting with a few elements depending on their size
+struct DefaultGrowth {
+    template <typename T>
+    static size_t grow(size_t cap, size_t required) {
+        size_t min_cap = sizeof(T) == 1 ? 8 : sizeof(T) <= 1024 ? 4 : 1;
+        return std::max({2 * cap, required, min_cap});
+    }
+};
+// Multiplies the capacity by `N / D`, e.g. `FactorGrowth<3, 2>`
+template <size_t N, size_t D>
+struct FactorGrowth {
+    static_assert(N > D && D > 0);
+    template <typename T>
+    static size_t grow(size_t cap, size_t required) {
+        return std::max(cap / D * N + cap % D * N / D, required);
+    }
+};
+// Allocates only the required length, for vectors that are filled once
+struct ExactGrowth {
+    template <typename T>
+    static size_t grow(size_t, size_t required) {
+        return required;
+    }
+};
+
+// Allocates uninitialized memory for `cap` elements with `malloc`, returns null on failure
+template <typename T>
+T *__allocate(size_t cap) {
+    size_t size = cap * sizeof(T);
+    if constexpr (alignof(T) > alignof(std::max_align_t)) {
+        // Size must be a multiple of alignment
+        size = (size + alignof(T) - 1) / alignof(T) * alignof(T);
+        return static_cast<T *>(std::aligned_alloc(alignof(T), size));
+    } else {
+        return static_cast<T *>(std::malloc(size));
+    }
+}
+template <typename T>
+void __deallocate(T *ptr) {
+    std::free(static_cast<void *>(ptr));
+}
+// Whether a buffer of `T` could be resized with `realloc`
+template <typename T>
+inline constexpr bool __reallocatable = is_trivially_relocatable_v<T> && alignof(T) <= alignof(std::max_align_t);
+
+// Moves `n` elements to uninitialized `dst` leaving `src` uninitialized, the ranges may overlap.
+// Trivially relocatable elements are moved with `memmove`.
+template <typename T>
+void __relocate(T *dst, T *src, size_t n) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n > 0) {
+            std::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+        }
+    } else if (dst < src) {
+        for (size_t i = 0; i < n; ++i) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    } else {
+        for (size_t i = n; i > 0; --i) {
+            new (dst + i - 1) T(std::move(src[i - 1]));
+            src[i - 1].~T();
+        }
+    }
+}
+template <typename T>
+void __destroy(T *ptr, size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = 0; i < n; ++i) {
+            ptr[i].~T();
+        }
+    }
+}
+
+template <typename T, typename G>
+class IntoIter;
+template <typename T, typename G>
+class Drain;
+
+} // namespace vec
+
+// Contiguous growable array.
+//
+// Allocation failures are reported by `try_*` methods as `AllocError`,
+// the rest of the methods panic on them. Growth of capacity is defined by `G`, see `vec::DefaultGrowth`.
+// Indexing is bounds-checked unless `RSTD_NO_BOUNDS_CHECK` is defined.
+template <typename T, typename G>
+class Vec final {
+private:
+    T *ptr_ = nullptr;
+    size_t len_ = 0, cap_ = 0;
+
+    friend class vec::IntoIter<T, G>;
+    friend class vec::Drain<T, G>;
+
+    static constexpr size_t max_capacity = size_t(PTRDIFF_MAX) / sizeof(T);
+
+    Result<Tuple<>, AllocError> set_capacity(size_t cap) {
+        if (cap == cap_) {
+            return Result<Tuple<>, AllocError>::Ok();
+        }
+        if (cap > max_capacity) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        T *ptr = nullptr;
+        if constexpr (vec::__reallocatable<T>) {
+            // Elements are moved by `realloc` which may also extend the buffer in place
+            if (ptr_ != nullptr && cap > 0) {
+                ptr = static_cast<T *>(std::realloc(static_cast<void *>(ptr_), cap * sizeof(T)));
+                if (ptr == nullptr) {
+                    return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::OUT_OF_MEMORY, cap * sizeof(T)));
+                }
+                ptr_ = ptr;
+                cap_ = cap;
+                return Result<Tuple<>, AllocError>::Ok();
+            }
+        }
+        if (cap > 0) {
+            ptr = vec::__allocate<T>(cap);
+            if (ptr == nullptr) {
+                return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::OUT_OF_MEMORY, cap * sizeof(T)));
+            }
+            vec::__relocate(ptr, ptr_, len_);
+        }
+        vec::__deallocate(ptr_);
+        ptr_ = ptr;
+        cap_ = cap;
+        return Result<Tuple<>, AllocError>::Ok();
+    }
+    // Ensures space for `additional` elements, `exact` skips the growth policy
+    Result<Tuple<>, AllocError> grow(size_t additional, bool exact) {
+        if (additional <= cap_ - len_) {
+            return Result<Tuple<>, AllocError>::Ok();
+        }
+        if (additional > max_capacity - len_) {
+            return Result<Tuple<>, AllocError>::Err(AllocError(AllocError::CAPACITY_OVERFLOW));
+        }
+        size_t required = len_ + additional;
+        size_t cap = exact ? required : std::min(G::template grow<T>(cap_, required), max_capacity);
+        return set_capacity(std::max(cap, required));
+    }
+    static void expect(Result<Tuple<>, AllocError> &&res) {
+        if (res.is_err()) {
+            const AllocError &e = res.get_err();
+            if (e.kind == AllocError::CAPACITY_OVERFLOW) {
+                panic_("Capacity overflow");
+            } else {
+                panic_("Allocation of {} bytes failed", e.size);
+            }
+        }
+        res.clear();
+    }
+
+    void check_index(size_t i, size_t len) const {
+#ifndef RSTD_NO_BOUNDS_CHECK
+        if (i >= len) {
+            panic_("Index {} is out of bounds of vector of length {}", i, len);
+        }
+#else // RSTD_NO_BOUNDS_CHECK
+        (void)i;
+        (void)len;
+#endif // RSTD_NO_BOUNDS_CHECK
+    }
+
+public:
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef T value_type;
+
+    Vec() = default;
+    Vec(std::initializer_list<T> list) {
+        reserve_exact(list.size());
+        for (const T &x : list) {
+            new (ptr_ + len_) T(x);
+            len_ += 1;
+        }
+    }
+    Vec(const Vec &other) {
+        reserve_exact(other.len_);
+        for (size_t i = 0; i < other.len_; ++i) {
+            new (ptr_ + i) T(other.ptr_[i]);
+        }
+        len_ = other.len_;
+    }
+    Vec &operator=(const Vec &other) {
+        if (this != &other) {
+            Vec copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    Vec(Vec &&other) :
+        ptr_(other.ptr_), len_(other.len_), cap_(other.cap_)
+    {
+        other.ptr_ = nullptr;
+        other.len_ = other.cap_ = 0;
+    }
+    Vec &operator=(Vec &&other) {
+        if (this != &other) {
+            clear();
+            vec::__deallocate(ptr_);
+            ptr_ = other.ptr_;
+            len_ = other.len_;
+            cap_ = other.cap_;
+            other.ptr_ = nullptr;
+            other.len_ = other.cap_ = 0;
+        }
+        return *this;
+    }
+    ~Vec() {
+        clear();
+        vec::__deallocate(ptr_);
+    }
+
+    static Vec with_capacity(size_t cap) {
+        Vec v;
+        v.reserve_exact(cap);
+        return v;
+    }
+    static Result<Vec, AllocError> try_with_capacity(size_t cap) {
+        Vec v;
+        auto res = v.try_reserve_exact(cap);
+        if (res.is_err()) {
+            return Result<Vec, AllocError>::Err(res.take_err());
+        }
+        res.clear();
+        return Result<Vec, AllocError>::Ok(std::move(v));
+    }
+    // Takes ownership of `len` elements at `ptr` allocated with `malloc` for `cap` elements
+    static Vec _from_raw_parts(T *ptr, size_t len, size_t cap) {
+        Vec v;
+        v.ptr_ = ptr;
+        v.len_ = len;
+        v.cap_ = cap;
+        return v;
+    }
+
+    size_t len() const { return len_; }
+    size_t size() const { return len_; }
+    size_t capacity() const { return cap_; }
+    bool is_empty() const { return len_ == 0; }
+
+    T *data() { return ptr_; }
+    const T *data() const { return ptr_; }
+    T *begin() { return ptr_; }
+    T *end() { return ptr_ + len_; }
+    const T *begin() const { return ptr_; }
+    const T *end() const { return ptr_ + len_; }
+
+    T &operator[](size_t i) {
+        check_index(i, len_);
+        return ptr_[i];
+    }
+    const T &operator[](size_t i) const {
+        check_index(i, len_);
+        return ptr_[i];
+    }
+    T &_get_unchecked(size_t i) {
+        return ptr_[i];
+    }
+    const T &_get_unchecked(size_t i) const {
+        return ptr_[i];
+    }
+    Option<T *> get(size_t i) {
+        return i < len_ ? Option<T *>::Some(ptr_ + i) : Option<T *>::None();
+    }
+    Option<const T *> get(size_t i) const {
+        return i < len_ ? Option<const T *>::Some(ptr_ + i) : Option<const T *>::None();
+    }
+
+    Slice<T> as_slice() const {
+        return Slice<T>(ptr_, len_);
+    }
+    SliceMut<T> as_mut_slice() {
+        return SliceMut<T>(ptr_, len_);
+    }
+    decltype(auto) iter() const {
+        return as_slice().iter();
+    }
+
+    // Reserves space for at least `additional` more elements
+    void reserve(size_t additional) {
+        expect(grow(additional, false));
+    }
+    Result<Tuple<>, AllocError> try_reserve(size_t additional) {
+        return grow(additional, false);
+    }
+    // Same as `reserve` but doesn't apply the growth policy
+    void reserve_exact(size_t additional) {
+        expect(grow(additional, true));
+    }
+    Result<Tuple<>, AllocError> try_reserve_exact(size_t additional) {
+        return grow(additional, true);
+    }
+    // Reallocates the buffer to fit exactly the elements, keeps the old one if that fails
+    void shrink_to_fit() {
+        if (cap_ > len_) {
+            set_capacity(len_).clear();
+        }
+    }
+
+    void push(T &&x) {
+        if (len_ == cap_) {
+            reserve(1);
+        }
+        new (ptr_ + len_) T(std::move(x));
+        len_ += 1;
+    }
+    void push(const T &x) {
+        push(T(x));
+    }
+    // Alias of `push` for generic code written for standard containers
+    void push_back(T &&x) {
+        push(std::move(x));
+    }
+    void push_back(const T &x) {
+        push(T(x));
+    }
+    // Drops `x` if there is no memory for it
+    Result<Tuple<>, AllocError> try_push(T &&x) {
+        if (len_ == cap_) {
+            auto res = grow(1, false);
+            if (res.is_err()) {
+                return res;
+            }
+            res.clear();
+        }
+        new (ptr_ + len_) T(std::move(x));
+        len_ += 1;
+        return Result<Tuple<>, AllocError>::Ok();
+    }
+    Result<Tuple<>, AllocError> try_push(const T &x) {
+        return try_push(T(x));
+    }
+    Option<T> pop() {
+        if (len_ == 0) {
+            return None();
+        }
+        len_ -= 1;
+        T x = std::move(ptr_[len_]);
+        ptr_[len_].~T();
+        return Option<T>::Some(std::move(x));
+    }
+    // Inserts `x` at position `i` shifting the following elements
+    void insert(size_t i, T &&x) {
+        check_index(i, len_ + 1);
+        if (len_ == cap_) {
+            reserve(1);
+        }
+        vec::__relocate(ptr_ + i + 1, ptr_ + i, len_ - i);
+        new (ptr_ + i) T(std::move(x));
+        len_ += 1;
+    }
+    // Removes the element at position `i` shifting the following ones
+    T remove(size_t i) {
+        check_index(i, len_);
+        T x = std::move(ptr_[i]);
+        ptr_[i].~T();
+        vec::__relocate(ptr_ + i, ptr_ + i + 1, len_ - i - 1);
+        len_ -= 1;
+        return x;
+    }
+    // Removes the element at position `i` replacing it with the last one
+    T swap_remove(size_t i) {
+        check_index(i, len_);
+        T x = std::move(ptr_[i]);
+        ptr_[i].~T();
+        len_ -= 1;
+        if (i != len_) {
+            vec::__relocate(ptr_ + i, ptr_ + len_, 1);
+        }
+        return x;
+    }
+    void truncate(size_t n) {
+        if (n < len_) {
+            vec::__destroy(ptr_ + n, len_ - n);
+            len_ = n;
+        }
+    }
+    void clear() {
+        truncate(0);
+    }
+    // Value-initializes new elements
+    void resize(size_t n) {
+        if (n > len_) {
+            reserve(n - len_);
+            for (; len_ < n; ++len_) {
+                new (ptr_ + len_) T();
+            }
+        } else {
+            truncate(n);
+        }
+    }
+    void resize(size_t n, const T &value) {
+        if (n > len_) {
+            reserve(n - len_);
+            for (; len_ < n; ++len_) {
+                new (ptr_ + len_) T(value);
+            }
+        } else {
+            truncate(n);
+        }
+    }
+
+    // Appends all items of `iter` reserving space for the lower bound of its length first
+    template <typename I>
+    void extend_from_iter(I &&iter) {
+        reserve(iter.size_hint().lower);
+        iter.for_each([this](T &&x) {
+            push(std::move(x));
+        });
+    }
+    void extend_from_slice(Slice<T> s) {
+        reserve(s.len());
+        for (const T &x : s) {
+            new (ptr_ + len_) T(x);
+            len_ += 1;
+        }
+    }
+
+    // Removes elements in `from..to` yielding them, see `vec::Drain`
+    vec::Drain<T, G> drain(size_t from, size_t to) {
+        if (from > to || to > len_) {
+            panic_("Range {}..{} is out of bounds of vector of length {}", from, to, len_);
+        }
+        return vec::Drain<T, G>(this, from, to);
+    }
+    vec::Drain<T, G> drain() {
+        return drain(0, len_);
+    }
+    // Keeps only elements for which `f(&x)` returns `true` preserving their order
+    template <typename F>
+    void retain(F &&f) {
+        size_t w = 0;
+        for (size_t r = 0; r < len_; ++r) {
+            if (f(const_cast<const T &>(ptr_[r]))) {
+                if (w != r) {
+                    vec::__relocate(ptr_ + w, ptr_ + r, 1);
+                }
+                w += 1;
+            } else {
+                ptr_[r].~T();
+            }
+        }
+        len_ = w;
+    }
+    // Removes consecutive elements for which `f(&prev, &next)` returns `true`
+    template <typename F>
+    void dedup_by(F &&f) {
+        if (len_ <= 1) {
+            return;
+        }
+        size_t w = 1;
+        for (size_t r = 1; r < len_; ++r) {
+            if (f(const_cast<const T &>(ptr_[w - 1]), const_cast<const T &>(ptr_[r]))) {
+                ptr_[r].~T();
+            } else {
+                if (w != r) {
+                    vec::__relocate(ptr_ + w, ptr_ + r, 1);
+                }
+                w += 1;
+            }
+        }
+        len_ = w;
+    }
+    // Removes consecutive repeated elements
+    void dedup() {
+        dedup_by([](const T &a, const T &b) { return a == b; });
+    }
+
+    bool operator==(const Vec &other) const {
+        return len_ == other.len_ && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const Vec &other) const {
+        return !(*this == other);
+    }
+};
+
+namespace vec {
+
+// Owning iterator over elements of a vector.
+// Consumed elements are left moved-from until the iterator is dropped,
+// which allows collecting into the same buffer, see `FromIterator`.
+template <typename T, typename G>
+class IntoIter final : public Iterator<T, IntoIter<T, G>> {
+private:
+    T *ptr = nullptr;
+    size_t size = 0, cap = 0;
+    size_t cur = 0, end = 0;
+    bool rev_ = false;
+
+    void release() {
+        __destroy(ptr, size);
+        __deallocate(ptr);
+        ptr = nullptr;
+        size = cap = cur = end = 0;
+    }
+
+public:
+    explicit IntoIter(Vec<T, G> &&v) :
+        ptr(v.ptr_), size(v.len_), cap(v.cap_), cur(0), end(v.len_)
+    {
+        v.ptr_ = nullptr;
+        v.len_ = v.cap_ = 0;
+    }
+    IntoIter(const IntoIter &) = delete;
+    IntoIter &operator=(const IntoIter &) = delete;
+    IntoIter(IntoIter &&other) :
+        ptr(other.ptr), size(other.size), cap(other.cap),
+        cur(other.cur), end(other.end), rev_(other.rev_)
+    {
+        other.ptr = nullptr;
+        other.size = other.cap = other.cur = other.end = 0;
+    }
+    IntoIter &operator=(IntoIter &&other) {
+        if (this != &other) {
+            release();
+            ptr = other.ptr;
+            size = other.size;
+            cap = other.cap;
+            cur = other.cur;
+            end = other.end;
+            rev_ = other.rev_;
+            other.ptr = nullptr;
+            other.size = other.cap = other.cur = other.end = 0;
+        }
+        return *this;
+    }
+    ~IntoIter() {
+        release();
+    }
+
+    Option<T> next() {
+        if (cur == end) {
+            return None();
+        }
+        if (!rev_) {
+            cur += 1;
+            return Option<T>::Some(std::move(ptr[cur - 1]));
+        } else {
+            end -= 1;
+            return Option<T>::Some(std::move(ptr[end]));
+        }
+    }
+    template <typename F>
+    bool try_for_each(F &&f) {
+        size_t c = cur, e = end;
+        bool done = true;
+        if (!rev_) {
+            while (c != e) {
+                T t = std::move(ptr[c]);
+                ++c;
+                if (!f(std::move(t))) {
+                    done = false;
+                    break;
+                }
+            }
+        } else {
+            while (c != e) {
+                --e;
+                T t = std::move(ptr[e]);
+                if (!f(std::move(t))) {
+                    done = false;
+                    break;
+                }
+            }
+        }
+        cur = c;
+        end = e;
+        return done;
+    }
+    size_t next_chunk(T *buf, size_t n) {
+        size_t k = std::min(n, end - cur);
+        if (!rev_) {
+            std::move(ptr + cur, ptr + cur + k, buf);
+            cur += k;
+        } else {
+            std::reverse_copy(
+                std::make_move_iterator(ptr + end - k),
+                std::make_move_iterator(ptr + end),
+                buf
+            );
+            end -= k;
+        }
+        return k;
+    }
+    // Skipped elements are dropped immediately
+    size_t advance_by(size_t n) {
+        size_t k = std::min(n, end - cur);
+        size_t from = !rev_ ? cur : end - k;
+        for (size_t i = from; i < from + k; ++i) {
+            drop(ptr[i]);
+        }
+        if (!rev_) {
+            cur += k;
+        } else {
+            end -= k;
+        }
+        return k;
+    }
+    size_t count() {
+        return advance_by(end - cur);
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(end - cur);
+    }
+    typedef IntoIter Rev;
+    Rev rev() {
+        rev_ = !rev_;
+        return std::move(*this);
+    }
+
+    // In-place collection, see `FromIterator`
+    typedef IntoIter InPlaceSource;
+    IntoIter &__in_place_source() {
+        return *this;
+    }
+    bool __in_place_ok() const {
+        return !rev_;
+    }
+    T *__buffer() {
+        return ptr;
+    }
+    // Releases the buffer keeping the first `len` elements
+    Vec<T, G> __into_buffer(size_t len) {
+        __destroy(ptr + len, size - len);
+        Vec<T, G> v = Vec<T, G>::_from_raw_parts(ptr, len, cap);
+        ptr = nullptr;
+        size = cap = cur = end = 0;
+        return v;
+    }
+};
+
+// Iterator removing a range of elements from a vector.
+// When dropped it drops the remaining elements of the range and shifts the tail of the vector,
+// the vector must not be accessed until then.
+template <typename T, typename G>
+class Drain final : public Iterator<T, Drain<T, G>> {
+private:
+    Vec<T, G> *vec;
+    size_t cur, end;
+    size_t tail_len;
+
+public:
+    Drain(Vec<T, G> *v, size_t from, size_t to) :
+        vec(v), cur(from), end(to), tail_len(v->len_ - to)
+    {
+        // Elements of the range are owned by the iterator now
+        vec->len_ = from;
+    }
+    Drain(const Drain &) = delete;
+    Drain &operator=(const Drain &) = delete;
+    Drain(Drain &&other) :
+        vec(other.vec), cur(other.cur), end(other.end), tail_len(other.tail_len)
+    {
+        other.vec = nullptr;
+    }
+    Drain &operator=(Drain &&) = delete;
+    ~Drain() {
+        if (vec != nullptr) {
+            __destroy(vec->ptr_ + cur, end - cur);
+            __relocate(vec->ptr_ + vec->len_, vec->ptr_ + end, tail_len);
+            vec->len_ += tail_len;
+        }
+    }
+
+    Option<T> next() {
+        if (cur == end) {
+            return None();
+        }
+        T x = std::move(vec->ptr_[cur]);
+        vec->ptr_[cur].~T();
+        cur += 1;
+        return Option<T>::Some(std::move(x));
+    }
+    iter::SizeHint size_hint() const {
+        return iter::SizeHint::exact(end - cur);
+    }
+    typedef void Rev;
+};
+
+} // namespace vec
+
+// Doesn't copy the elements
+template <typename T, typename G>
+vec::IntoIter<T, G> into_iter(Vec<T, G> &&v) {
+    return vec::IntoIter<T, G>(std::move(v));
+}
+// More specialized than `into_iter(C<T> &&)` for the default growth policy
+template <typename T>
+vec::IntoIter<T, vec::DefaultGrowth> into_iter(Vec<T> &&v) {
+    return vec::IntoIter<T, vec::DefaultGrowth>(std::move(v));
+}
+
+template <typename T, typename G>
+struct TriviallyRelocatable<Vec<T, G>> : std::true_type {};
+
+template <typename T, typename G>
+struct fmt::Display<Vec<T, G>> {
+    static void fmt(const Vec<T, G> &v, std::ostream &o) {
+        o << "[";
+        for (size_t i = 0; i < v.len(); ++i) {
+            if (i > 0) {
+                o << ", ";
+            }
+            fmt::display(o, v[i]);
+        }
+        o << "]";
+    }
+};
+template <>
+struct fmt::Display<AllocError> {
+    static void fmt(const AllocError &e, std::ostream &o) {
+        if (e.kind == AllocError::CAPACITY_OVERFLOW) {
+            o << "AllocError(capacity overflow)";
+        } else {
+            o << "AllocError(" << e.size << " bytes)";
+        }
+    }
+};
+
+} // namespace rstd
@@ -3,6 +3,7 @@
 #include <csignal>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <thread>
 #include <functional>
 #include <sstream>
@@ -53,6 +54,14 @@ struct TestResult {
     std::string output;
 };
 
+struct TestTime {
+    std::string name;
+    rstd::ThreadStats stats;
+};
+
+// Amount of slowest tests to print
+static const size_t SLOWEST_COUNT = 5;
+
 int main(int argc, const char *const *argv) {
     std::vector<rtest::TestCase> tests;
     for (const TestCase &c : *__rtest_registrar) {
@@ -91,6 +100,7 @@ int main(int argc, const char *const *argv) {
 
     rstd::Mutex<std::ostream*> log(&std::cout);
     rstd::Mutex<std::vector<TestResult>> failures_;
+    rstd::Mutex<std::vector<TestTime>> times_;
 
     for (auto sig : *__main::signals) {
         signal(sig.first, __main::signal_handler);
@@ -107,12 +117,14 @@ int main(int argc, const char *const *argv) {
                 rstd::drop(i);
 
                 std::stringstream output;
-                auto res = rstd::thread::Builder()
+                auto joined = rstd::thread::Builder()
                 .stdout_(output).stderr_(output)
                 .spawn([&]() {
                     test.func();
-                }).join();
-                
+                }).join_with_stats();
+                auto res = std::move(joined.get<0>());
+                times_.lock()->push_back(rtest::TestTime {test.name, joined.get<1>()});
+
                 std::string rn;
                 if (res.is_ok() == !test.should_panic) {
                     rn = result_name[0];
@@ -153,6 +165,22 @@ int main(int argc, const char *const *argv) {
         println_();
     }
 
+    std::vector<rtest::TestTime> times = times_.into_inner();
+    std::sort(times.begin(), times.end(), [](const TestTime &a, const TestTime &b) {
+        return a.stats.wall_time_ns > b.stats.wall_time_ns;
+    });
+    if (times.size() > SLOWEST_COUNT) {
+        times.resize(SLOWEST_COUNT);
+    }
+    println_("slowest tests:");
+    for (const auto &t : times) {
+        println_(
+            "    {} ... {} ms (cpu {} ms)", t.name,
+            t.stats.wall_time_ns / 1000000, t.stats.cpu_time_ns() / 1000000
+        );
+    }
+    println_();
+
     int fails = failures.size();
     println_("test result: {}. {} passed; {} failed;", result_name[fails != 0], test_count - fails, fails);
     println_();